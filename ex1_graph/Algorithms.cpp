@@ -7,16 +7,139 @@ const int INT_MAX = 2147483647;
 
 namespace graph {
 
-// BFS algorithm implementation
+// Empty the caller's result graph, reusing its storage when the size already matches
+void Algorithms::prepareResult(Graph& result, int numVertices) {
+    if (result.getNumVertices() == numVertices) {
+        result.clear();
+    } else {
+        result = Graph(numVertices);
+    }
+}
+
+// Search-tree versions returning a new result
+SearchTree Algorithms::bfsTree(const Graph& g, int source) {
+    SearchTree result;
+    bfsTree(g, source, result);
+    return result;
+}
+
+SearchTree Algorithms::bfsTree(const CSRGraph& g, int source) {
+    SearchTree result;
+    bfsTree(g, source, result);
+    return result;
+}
+
+SearchTree Algorithms::dijkstraTree(const Graph& g, int source) {
+    SearchTree result;
+    dijkstraWith<BinaryHeapQueue>(g, source, result);
+    return result;
+}
+
+SearchTree Algorithms::dijkstraTree(const CSRGraph& g, int source) {
+    SearchTree result;
+    dijkstraWith<BinaryHeapQueue>(g, source, result);
+    return result;
+}
+
+SearchTree Algorithms::primTree(const Graph& g) {
+    SearchTree result;
+    primWith<BinaryHeapQueue>(g, result);
+    return result;
+}
+
+SearchTree Algorithms::primTree(const CSRGraph& g) {
+    SearchTree result;
+    primWith<BinaryHeapQueue>(g, result);
+    return result;
+}
+
+void Algorithms::dijkstraTree(const Graph& g, int source, SearchTree& result) {
+    dijkstraWith<BinaryHeapQueue>(g, source, result);
+}
+
+void Algorithms::dijkstraTree(const CSRGraph& g, int source, SearchTree& result) {
+    dijkstraWith<BinaryHeapQueue>(g, source, result);
+}
+
+void Algorithms::primTree(const Graph& g, SearchTree& result) {
+    primWith<BinaryHeapQueue>(g, result);
+}
+
+void Algorithms::primTree(const CSRGraph& g, SearchTree& result) {
+    primWith<BinaryHeapQueue>(g, result);
+}
+
+// Versions returning a new graph - each one builds its result in place
 Graph Algorithms::bfs(const Graph& g, int source) {
+    Graph result(g.getNumVertices());
+    bfs(g, source, result);
+    return result;
+}
+
+Graph Algorithms::dfs(const Graph& g, int source) {
+    Graph result(g.getNumVertices());
+    dfs(g, source, result);
+    return result;
+}
+
+Graph Algorithms::dijkstra(const Graph& g, int source) {
+    Graph result(g.getNumVertices());
+    dijkstra(g, source, result);
+    return result;
+}
+
+Graph Algorithms::prim(const Graph& g) {
+    Graph result(g.getNumVertices());
+    prim(g, result);
+    return result;
+}
+
+Graph Algorithms::kruskal(const Graph& g) {
+    Graph result(g.getNumVertices());
+    kruskal(g, result);
+    return result;
+}
+
+Graph Algorithms::bfs(const CSRGraph& g, int source) {
+    Graph result(g.getNumVertices());
+    bfs(g, source, result);
+    return result;
+}
+
+Graph Algorithms::dfs(const CSRGraph& g, int source) {
+    Graph result(g.getNumVertices());
+    dfs(g, source, result);
+    return result;
+}
+
+Graph Algorithms::dijkstra(const CSRGraph& g, int source) {
+    Graph result(g.getNumVertices());
+    dijkstra(g, source, result);
+    return result;
+}
+
+Graph Algorithms::prim(const CSRGraph& g) {
+    Graph result(g.getNumVertices());
+    prim(g, result);
+    return result;
+}
+
+Graph Algorithms::kruskal(const CSRGraph& g) {
+    Graph result(g.getNumVertices());
+    kruskal(g, result);
+    return result;
+}
+
+// BFS algorithm implementation
+void Algorithms::bfs(const Graph& g, int source, Graph& result) {
     int numVertices = g.getNumVertices();
     
     if (source < 0 || source >= numVertices) {
         throw "Source vertex out of range";
     }
     
-    // Create a new graph for the BFS tree
-    Graph result(numVertices);
+    // Use the caller's graph for the BFS tree
+    prepareResult(result, numVertices);
     
     // Array to mark visited vertices
     bool* visited = new bool[numVertices];
@@ -54,89 +177,207 @@ Graph Algorithms::bfs(const Graph& g, int source) {
     }
     
     delete[] visited;
-    return result;
 }
 
-// DFS algorithm implementation
-Graph Algorithms::dfs(const Graph& g, int source) {
+// BFS into a search tree - the distance of a vertex is its number of edges from the source
+void Algorithms::bfsTree(const Graph& g, int source, SearchTree& result) {
     int numVertices = g.getNumVertices();
     
     if (source < 0 || source >= numVertices) {
         throw "Source vertex out of range";
     }
     
-    // Create a new graph for the DFS tree/forest
-    Graph result(numVertices);
+    // Unreached vertices still have distance INT_MAX
+    result.reset(numVertices, source);
+    int* distance = result.distance;
+    int* parent = result.parent;
+    int* parentWeight = result.parentWeight;
     
-    // Array to mark visited vertices
-    bool* visited = new bool[numVertices];
-    for (int i = 0; i < numVertices; i++) {
-        visited[i] = false;
-    }
+    // Every vertex is enqueued at most once, so a flat array serves as the queue
+    int* queue = new int[numVertices];
+    int head = 0;
+    int tail = 0;
+    queue[tail++] = source;
     
-    // Call the recursive DFS function
-    dfsVisit(g, source, visited, result);
+    while (head < tail) {
+        int current = queue[head++];
+        
+        for (Graph::Edge* edge = g.getAdjList(current); edge; edge = edge->next) {
+            int adjacent = edge->destination;
+            
+            if (distance[adjacent] == INT_MAX) {
+                distance[adjacent] = distance[current] + 1;
+                parent[adjacent] = current;
+                parentWeight[adjacent] = edge->weight;
+                queue[tail++] = adjacent;
+            }
+        }
+    }
     
-    delete[] visited;
-    return result;
+    delete[] queue;
 }
 
-// Helper method for DFS
-void Algorithms::dfsVisit(const Graph& g, int vertex, bool* visited, Graph& result) {
-    visited[vertex] = true;
+// Visitor that copies the DFS tree edges into a graph
+class DfsTreeBuilder : public DfsVisitor {
+public:
+    DfsTreeBuilder(Graph& tree) : result(tree) {}
     
-    // Explore all adjacent vertices
-    Graph::Edge* edge = g.getAdjList(vertex);
-    while (edge != nullptr) {
-        int adjacent = edge->destination;
-        
-        // If not visited, visit and add edge to DFS tree
-        if (!visited[adjacent]) {
-            result.addEdge(vertex, adjacent, edge->weight);
-            dfsVisit(g, adjacent, visited, result);
-        }
-        
-        edge = edge->next;
+    void treeEdge(int source, int dest, int weight) {
+        result.addEdge(source, dest, weight);
     }
-}
+    
+private:
+    Graph& result;
+};
 
-// Dijkstra's algorithm implementation
-Graph Algorithms::dijkstra(const Graph& g, int source) {
+// DFS algorithm implementation
+void Algorithms::dfs(const Graph& g, int source, Graph& result) {
     int numVertices = g.getNumVertices();
     
     if (source < 0 || source >= numVertices) {
         throw "Source vertex out of range";
     }
     
-    // Create a new graph for the shortest paths tree
-    Graph result(numVertices);
+    // Use the caller's graph for the DFS tree/forest
+    prepareResult(result, numVertices);
     
-    // Distance array to store shortest path
-    int* distance = new int[numVertices];
-    
-    // Parent array to store the shortest path tree
-    int* parent = new int[numVertices];
+    // Run the iterative engine, collecting the tree edges
+    DfsTreeBuilder builder(result);
+    dfsRun(g, source, false, builder);
+}
+
+void Algorithms::depthFirstSearch(const Graph& g, int source, DfsVisitor& visitor) {
+    if (source < 0 || source >= g.getNumVertices()) {
+        throw "Source vertex out of range";
+    }
+    dfsRun(g, source, false, visitor);
+}
+
+void Algorithms::depthFirstSearchAll(const Graph& g, DfsVisitor& visitor) {
+    dfsRun(g, 0, true, visitor);
+}
+
+// DFS engine on the adjacency lists.
+// Each stack frame holds a vertex, the next edge of its list to examine, whether
+// the edge back to its DFS parent has been skipped yet, and whether the next copy
+// of a self-loop is the second one of its pair.
+void Algorithms::dfsRun(const Graph& g, int source, bool allComponents, DfsVisitor& visitor) {
+    int numVertices = g.getNumVertices();
     
-    // Initialize distance and parent arrays
+    // 0 = not discovered, 1 = on the stack, 2 = finished
+    char* color = new char[numVertices];
     for (int i = 0; i < numVertices; i++) {
-        distance[i] = INT_MAX;
-        parent[i] = -1;
+        color[i] = 0;
+    }
+    
+    int* stackVertex = new int[numVertices];
+    Graph::Edge** stackEdge = new Graph::Edge*[numVertices];
+    bool* parentSkipped = new bool[numVertices];
+    bool* skipLoop = new bool[numVertices];
+    
+    for (int root = source; root < numVertices; root++) {
+        if (color[root] != 0) {
+            continue;
+        }
+        
+        color[root] = 1;
+        visitor.discoverVertex(root);
+        stackVertex[0] = root;
+        stackEdge[0] = g.getAdjList(root);
+        parentSkipped[0] = true; // The root has no parent
+        skipLoop[0] = false;
+        int top = 1;
+        
+        while (top > 0) {
+            int vertex = stackVertex[top - 1];
+            Graph::Edge* edge = stackEdge[top - 1];
+            
+            if (edge == nullptr) {
+                // All neighbors explored
+                color[vertex] = 2;
+                visitor.finishVertex(vertex);
+                top--;
+                continue;
+            }
+            
+            stackEdge[top - 1] = edge->next;
+            int adjacent = edge->destination;
+            
+            if (color[adjacent] == 0) {
+                visitor.treeEdge(vertex, adjacent, edge->weight);
+                
+                color[adjacent] = 1;
+                visitor.discoverVertex(adjacent);
+                stackVertex[top] = adjacent;
+                stackEdge[top] = g.getAdjList(adjacent);
+                parentSkipped[top] = false;
+                skipLoop[top] = false;
+                top++;
+            } else if (color[adjacent] == 1) {
+                // An edge to a vertex on the stack is a back edge, except the
+                // reverse of the tree edge that led here. A self-loop is stored
+                // twice in its own list, so only every other copy is reported.
+                if (adjacent == vertex) {
+                    if (!skipLoop[top - 1]) {
+                        visitor.backEdge(vertex, adjacent, edge->weight);
+                    }
+                    skipLoop[top - 1] = !skipLoop[top - 1];
+                } else if (!parentSkipped[top - 1] && adjacent == stackVertex[top - 2]) {
+                    parentSkipped[top - 1] = true;
+                } else {
+                    visitor.backEdge(vertex, adjacent, edge->weight);
+                }
+            }
+        }
+        
+        if (!allComponents) {
+            break;
+        }
     }
     
-    // Distance to source is 0
-    distance[source] = 0;
+    delete[] parentSkipped;
+    delete[] skipLoop;
+    delete[] stackEdge;
+    delete[] stackVertex;
+    delete[] color;
+}
+
+// Dijkstra's algorithm implementation.
+// Vertices enter the queue only when they are reached; a vertex pushed again with a
+// shorter distance leaves a stale entry behind, which is skipped once it is settled.
+template <typename Queue>
+void Algorithms::dijkstraWith(const Graph& g, int source, SearchTree& result) {
+    int numVertices = g.getNumVertices();
+    
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
     
-    // Create a priority queue
-    PriorityQueue pq(numVertices);
+    // The result holds the distances and the shortest path tree, with the weight
+    // of each tree edge
+    result.reset(numVertices, source);
+    int* distance = result.distance;
+    int* parent = result.parent;
+    int* parentWeight = result.parentWeight;
     
-    // Insert all vertices with their distances
+    // Settled vertices have their final distance
+    bool* settled = new bool[numVertices];
     for (int i = 0; i < numVertices; i++) {
-        pq.insert(i, distance[i]);
+        settled[i] = false;
     }
     
-    // Process all vertices
+    Queue pq(numVertices);
+    pq.push(source, 0);
+    
     while (!pq.isEmpty()) {
-        int u = pq.extractMin();
+        int u;
+        int d;
+        pq.popMin(u, d);
+        
+        if (settled[u]) {
+            continue; // Stale entry
+        }
+        settled[u] = true;
         
         // Process all adjacent vertices of u
         Graph::Edge* edge = g.getAdjList(u);
@@ -145,175 +386,735 @@ Graph Algorithms::dijkstra(const Graph& g, int source) {
             int weight = edge->weight;
             
             // If there is a shorter path to v through u
-            if (pq.inQueue(v) && distance[u] != INT_MAX && 
-                distance[u] + weight < distance[v]) {
-                
-                // Update distance and parent
-                distance[v] = distance[u] + weight;
+            if (!settled[v] && d + weight < distance[v]) {
+                distance[v] = d + weight;
                 parent[v] = u;
-                
-                // Update priority queue
-                pq.decreaseKey(v, distance[v]);
+                parentWeight[v] = weight;
+                pq.push(v, distance[v]);
             }
             
             edge = edge->next;
         }
     }
     
-    // Build the shortest path tree
+    delete[] settled;
+}
+
+// The tree graph is built from the recorded tree edges
+template <typename Queue>
+void Algorithms::dijkstraWith(const Graph& g, int source, Graph& result) {
+    SearchTree tree;
+    dijkstraWith<Queue>(g, source, tree);
+    tree.toGraph(result);
+}
+
+// Prim's algorithm implementation.
+// The queue is lazy like in Dijkstra. Every vertex not reached from earlier roots
+// starts a new tree, so a disconnected graph gives a minimum spanning forest.
+template <typename Queue>
+void Algorithms::primWith(const Graph& g, SearchTree& result) {
+    int numVertices = g.getNumVertices();
+    
+    // The key of a vertex is the weight of its tree edge, kept in the result
+    result.reset(numVertices, -1);
+    int* key = result.parentWeight;
+    int* parent = result.parent;
+    int* distance = result.distance;
+    
+    // Vertices already in the MST
+    bool* inTree = new bool[numVertices];
+    
+    // Initialize keys as INFINITE
     for (int i = 0; i < numVertices; i++) {
-        if (i != source && parent[i] != -1) {
-            // Find the weight of the edge from parent[i] to i
-            int weight = 0;
-            Graph::Edge* edge = g.getAdjList(parent[i]);
+        key[i] = INT_MAX;
+        inTree[i] = false;
+    }
+    
+    Queue pq(numVertices);
+    
+    for (int root = 0; root < numVertices; root++) {
+        if (inTree[root]) {
+            continue;
+        }
+        
+        // Start a new tree, with the root's key set to 0
+        key[root] = 0;
+        pq.push(root, 0);
+        
+        while (!pq.isEmpty()) {
+            int u;
+            int k;
+            pq.popMin(u, k);
+            
+            if (inTree[u]) {
+                continue; // Stale entry
+            }
+            inTree[u] = true;
+            
+            // The parent joined the tree first, so its path weight is known
+            distance[u] = parent[u] == -1 ? 0 : distance[parent[u]] + key[u];
+            
+            // Process all adjacent vertices
+            Graph::Edge* edge = g.getAdjList(u);
             while (edge != nullptr) {
-                if (edge->destination == i) {
-                    weight = edge->weight;
-                    break;
+                int v = edge->destination;
+                int weight = edge->weight;
+                
+                // If v is not yet included in MST and weight of u-v is less than key of v
+                if (!inTree[v] && weight < key[v]) {
+                    key[v] = weight;
+                    parent[v] = u;
+                    pq.push(v, weight);
                 }
+                
                 edge = edge->next;
             }
+        }
+    }
+    
+    delete[] inTree;
+}
+
+template <typename Queue>
+void Algorithms::primWith(const Graph& g, Graph& result) {
+    SearchTree tree;
+    primWith<Queue>(g, tree);
+    tree.toGraph(result);
+}
+
+void Algorithms::dijkstra(const Graph& g, int source, Graph& result) {
+    dijkstraWith<BinaryHeapQueue>(g, source, result);
+}
+
+void Algorithms::prim(const Graph& g, Graph& result) {
+    primWith<BinaryHeapQueue>(g, result);
+}
+
+// Kruskal's algorithm implementation
+void Algorithms::kruskal(const Graph& g, Graph& result, int numThreads) {
+    int numVertices = g.getNumVertices();
+    
+    if (numThreads <= 0) {
+        throw "Number of threads must be positive";
+    }
+    
+    // Count the edges first so the edge list has exactly the size it needs
+    int edgeCount = 0;
+    for (int i = 0; i < numVertices; i++) {
+        for (Graph::Edge* edge = g.getAdjList(i); edge != nullptr; edge = edge->next) {
+            if (i < edge->destination) {
+                edgeCount++;
+            }
+        }
+    }
+    
+    WeightedEdge* edges = new WeightedEdge[edgeCount + 1];
+    edgeCount = 0;
+    
+    // Collect all edges from the graph
+    for (int i = 0; i < numVertices; i++) {
+        Graph::Edge* edge = g.getAdjList(i);
+        while (edge != nullptr) {
+            if (i < edge->destination) { // To avoid duplicates in undirected graph
+                edges[edgeCount++] = WeightedEdge(i, edge->destination, edge->weight);
+            }
+            edge = edge->next;
+        }
+    }
+    
+    kruskalFromEdges(numVertices, edges, edgeCount, result, numThreads);
+    
+    delete[] edges;
+}
+
+// Helper method for Kruskal - sorts the edges and adds every edge that joins two components
+void Algorithms::kruskalFromEdges(int numVertices, WeightedEdge* edges, int edgeCount, Graph& result,
+                                  int numThreads) {
+    // Sort edges by weight; the sort is stable, so equal weights keep their order
+    sortEdgesByWeight(edges, edgeCount, numThreads);
+    
+    prepareResult(result, numVertices);
+    
+    // Create a Union-Find data structure
+    UnionFind uf(numVertices);
+    
+    // Process edges in ascending order of weight, stopping once the tree is complete
+    int treeEdges = 0;
+    for (int i = 0; i < edgeCount && treeEdges < numVertices - 1; i++) {
+        int src = edges[i].source;
+        int dest = edges[i].dest;
+        
+        // If including this edge doesn't cause a cycle
+        if (!uf.connected(src, dest)) {
+            // Add the edge to the MST
+            result.addEdge(src, dest, edges[i].weight);
+            treeEdges++;
+            
+            // Union the sets
+            uf.unite(src, dest);
+        }
+    }
+}
+
+// BFS on the CSR representation - uses a flat array as the queue
+void Algorithms::bfs(const CSRGraph& g, int source, Graph& result) {
+    int numVertices = g.getNumVertices();
+    
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
+    
+    // Use the caller's graph for the BFS tree
+    prepareResult(result, numVertices);
+    
+    bool* visited = new bool[numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        visited[i] = false;
+    }
+    
+    // Every vertex is enqueued at most once, so the queue never wraps
+    int* queue = new int[numVertices];
+    int head = 0;
+    int tail = 0;
+    
+    visited[source] = true;
+    queue[tail++] = source;
+    
+    while (head < tail) {
+        int current = queue[head++];
+        
+        for (int i = offsets[current]; i < offsets[current + 1]; i++) {
+            int adjacent = destinations[i];
             
-            result.addEdge(parent[i], i, weight);
+            if (!visited[adjacent]) {
+                visited[adjacent] = true;
+                queue[tail++] = adjacent;
+                result.addEdge(current, adjacent, weights[i]);
+            }
         }
     }
     
-    delete[] distance;
-    delete[] parent;
+    delete[] queue;
+    delete[] visited;
+}
+
+// BFS into a search tree on the CSR representation
+void Algorithms::bfsTree(const CSRGraph& g, int source, SearchTree& result) {
+    int numVertices = g.getNumVertices();
+    
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
     
-    return result;
+    result.reset(numVertices, source);
+    int* distance = result.distance;
+    int* parent = result.parent;
+    int* parentWeight = result.parentWeight;
+    
+    int* queue = new int[numVertices];
+    int head = 0;
+    int tail = 0;
+    queue[tail++] = source;
+    
+    while (head < tail) {
+        int current = queue[head++];
+        
+        for (int i = offsets[current]; i < offsets[current + 1]; i++) {
+            int adjacent = destinations[i];
+            
+            if (distance[adjacent] == INT_MAX) {
+                distance[adjacent] = distance[current] + 1;
+                parent[adjacent] = current;
+                parentWeight[adjacent] = weights[i];
+                queue[tail++] = adjacent;
+            }
+        }
+    }
+    
+    delete[] queue;
 }
 
-// Prim's algorithm implementation
-Graph Algorithms::prim(const Graph& g) {
+// DFS on the CSR representation
+void Algorithms::dfs(const CSRGraph& g, int source, Graph& result) {
     int numVertices = g.getNumVertices();
     
-    // Create a new graph for the MST
-    Graph result(numVertices);
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    
+    // Use the caller's graph for the DFS tree
+    prepareResult(result, numVertices);
     
-    // Array to store key values
-    int* key = new int[numVertices];
+    DfsTreeBuilder builder(result);
+    dfsRun(g, source, false, builder);
+}
+
+void Algorithms::depthFirstSearch(const CSRGraph& g, int source, DfsVisitor& visitor) {
+    if (source < 0 || source >= g.getNumVertices()) {
+        throw "Source vertex out of range";
+    }
+    dfsRun(g, source, false, visitor);
+}
+
+void Algorithms::depthFirstSearchAll(const CSRGraph& g, DfsVisitor& visitor) {
+    dfsRun(g, 0, true, visitor);
+}
+
+// DFS engine on the CSR representation - a stack frame keeps the position of
+// the next edge in the vertex's range instead of a list pointer
+void Algorithms::dfsRun(const CSRGraph& g, int source, bool allComponents, DfsVisitor& visitor) {
+    int numVertices = g.getNumVertices();
     
-    // Array to store MST
-    int* parent = new int[numVertices];
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
     
-    // Initialize keys as INFINITE and parent as -1
+    char* color = new char[numVertices];
     for (int i = 0; i < numVertices; i++) {
-        key[i] = INT_MAX;
-        parent[i] = -1;
+        color[i] = 0;
+    }
+    
+    int* stackVertex = new int[numVertices];
+    int* stackEdge = new int[numVertices];
+    bool* parentSkipped = new bool[numVertices];
+    bool* skipLoop = new bool[numVertices];
+    
+    for (int root = source; root < numVertices; root++) {
+        if (color[root] != 0) {
+            continue;
+        }
+        
+        color[root] = 1;
+        visitor.discoverVertex(root);
+        stackVertex[0] = root;
+        stackEdge[0] = offsets[root];
+        parentSkipped[0] = true;
+        skipLoop[0] = false;
+        int top = 1;
+        
+        while (top > 0) {
+            int vertex = stackVertex[top - 1];
+            int i = stackEdge[top - 1];
+            
+            if (i == offsets[vertex + 1]) {
+                color[vertex] = 2;
+                visitor.finishVertex(vertex);
+                top--;
+                continue;
+            }
+            
+            stackEdge[top - 1] = i + 1;
+            int adjacent = destinations[i];
+            
+            if (color[adjacent] == 0) {
+                visitor.treeEdge(vertex, adjacent, weights[i]);
+                
+                color[adjacent] = 1;
+                visitor.discoverVertex(adjacent);
+                stackVertex[top] = adjacent;
+                stackEdge[top] = offsets[adjacent];
+                parentSkipped[top] = false;
+                skipLoop[top] = false;
+                top++;
+            } else if (color[adjacent] == 1) {
+                if (adjacent == vertex) {
+                    // A self-loop is stored twice in its own list; report every other copy
+                    if (!skipLoop[top - 1]) {
+                        visitor.backEdge(vertex, adjacent, weights[i]);
+                    }
+                    skipLoop[top - 1] = !skipLoop[top - 1];
+                } else if (!parentSkipped[top - 1] && adjacent == stackVertex[top - 2]) {
+                    parentSkipped[top - 1] = true;
+                } else {
+                    visitor.backEdge(vertex, adjacent, weights[i]);
+                }
+            }
+        }
+        
+        if (!allComponents) {
+            break;
+        }
+    }
+    
+    delete[] parentSkipped;
+    delete[] skipLoop;
+    delete[] stackEdge;
+    delete[] stackVertex;
+    delete[] color;
+}
+
+// Dijkstra's algorithm on the CSR representation
+template <typename Queue>
+void Algorithms::dijkstraWith(const CSRGraph& g, int source, SearchTree& result) {
+    int numVertices = g.getNumVertices();
+    
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
     }
     
-    // Include first vertex in MST, set its key to 0
-    key[0] = 0;
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
     
-    // Create a priority queue
-    PriorityQueue pq(numVertices);
+    result.reset(numVertices, source);
+    int* distance = result.distance;
+    int* parent = result.parent;
+    int* parentWeight = result.parentWeight; // Weight of the tree edge into each vertex
     
-    // Insert all vertices
+    bool* settled = new bool[numVertices];
     for (int i = 0; i < numVertices; i++) {
-        pq.insert(i, key[i]);
+        settled[i] = false;
     }
     
-    // Process all vertices
+    Queue pq(numVertices);
+    pq.push(source, 0);
+    
     while (!pq.isEmpty()) {
-        int u = pq.extractMin();
+        int u;
+        int d;
+        pq.popMin(u, d);
         
-        // Process all adjacent vertices
-        Graph::Edge* edge = g.getAdjList(u);
-        while (edge != nullptr) {
-            int v = edge->destination;
-            int weight = edge->weight;
+        if (settled[u]) {
+            continue;
+        }
+        settled[u] = true;
+        
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int v = destinations[i];
+            int weight = weights[i];
             
-            // If v is not yet included in MST and weight of u-v is less than key of v
-            if (pq.inQueue(v) && weight < key[v]) {
-                // Update key and parent
-                key[v] = weight;
+            if (!settled[v] && d + weight < distance[v]) {
+                distance[v] = d + weight;
                 parent[v] = u;
-                
-                // Update priority queue
-                pq.decreaseKey(v, key[v]);
+                parentWeight[v] = weight;
+                pq.push(v, distance[v]);
+            }
+        }
+    }
+    
+    delete[] settled;
+}
+
+template <typename Queue>
+void Algorithms::dijkstraWith(const CSRGraph& g, int source, Graph& result) {
+    SearchTree tree;
+    dijkstraWith<Queue>(g, source, tree);
+    tree.toGraph(result);
+}
+
+// Prim's algorithm on the CSR representation
+template <typename Queue>
+void Algorithms::primWith(const CSRGraph& g, SearchTree& result) {
+    int numVertices = g.getNumVertices();
+    
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
+    
+    result.reset(numVertices, -1);
+    int* key = result.parentWeight;
+    int* parent = result.parent;
+    int* distance = result.distance;
+    bool* inTree = new bool[numVertices];
+    
+    for (int i = 0; i < numVertices; i++) {
+        key[i] = INT_MAX;
+        inTree[i] = false;
+    }
+    
+    Queue pq(numVertices);
+    
+    for (int root = 0; root < numVertices; root++) {
+        if (inTree[root]) {
+            continue;
+        }
+        
+        key[root] = 0;
+        pq.push(root, 0);
+        
+        while (!pq.isEmpty()) {
+            int u;
+            int k;
+            pq.popMin(u, k);
+            
+            if (inTree[u]) {
+                continue;
             }
+            inTree[u] = true;
+            distance[u] = parent[u] == -1 ? 0 : distance[parent[u]] + key[u];
             
-            edge = edge->next;
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                int v = destinations[i];
+                int weight = weights[i];
+                
+                if (!inTree[v] && weight < key[v]) {
+                    key[v] = weight;
+                    parent[v] = u;
+                    pq.push(v, weight);
+                }
+            }
         }
     }
     
-    // Build the MST
-    for (int i = 1; i < numVertices; i++) {
-        if (parent[i] != -1) {
-            result.addEdge(parent[i], i, key[i]);
+    delete[] inTree;
+}
+
+template <typename Queue>
+void Algorithms::primWith(const CSRGraph& g, Graph& result) {
+    SearchTree tree;
+    primWith<Queue>(g, tree);
+    tree.toGraph(result);
+}
+
+void Algorithms::dijkstra(const CSRGraph& g, int source, Graph& result) {
+    dijkstraWith<BinaryHeapQueue>(g, source, result);
+}
+
+void Algorithms::prim(const CSRGraph& g, Graph& result) {
+    primWith<BinaryHeapQueue>(g, result);
+}
+
+// Kruskal's algorithm on the CSR representation - the edge array is sized to the real edge count
+void Algorithms::kruskal(const CSRGraph& g, Graph& result, int numThreads) {
+    int numVertices = g.getNumVertices();
+    
+    if (numThreads <= 0) {
+        throw "Number of threads must be positive";
+    }
+    
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
+    
+    WeightedEdge* edges = new WeightedEdge[g.getNumEdges() + 1];
+    int edgeCount = 0;
+    
+    for (int u = 0; u < numVertices; u++) {
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            if (u < destinations[i]) { // To avoid duplicates in undirected graph
+                edges[edgeCount++] = WeightedEdge(u, destinations[i], weights[i]);
+            }
         }
     }
     
-    delete[] key;
-    delete[] parent;
+    kruskalFromEdges(numVertices, edges, edgeCount, result, numThreads);
     
+    delete[] edges;
+}
+
+// Direction-optimizing BFS - converts the adjacency lists once, then runs on CSR
+Graph Algorithms::bfsDirectionOptimizing(const Graph& g, int source,
+                                         const DirectionOptimizingOptions& options, BfsStats* stats) {
+    if (source < 0 || source >= g.getNumVertices()) {
+        throw "Source vertex out of range";
+    }
+    CSRGraph csr(g);
+    return bfsDirectionOptimizing(csr, source, options, stats);
+}
+
+Graph Algorithms::bfsDirectionOptimizing(const CSRGraph& g, int source,
+                                         const DirectionOptimizingOptions& options, BfsStats* stats) {
+    Graph result(g.getNumVertices());
+    bfsDirectionOptimizing(g, source, result, options, stats);
     return result;
 }
 
-// Kruskal's algorithm implementation
-Graph Algorithms::kruskal(const Graph& g) {
+// Direction-optimizing BFS.
+// Top-down steps scan the edges of every frontier vertex. Bottom-up steps scan the
+// unvisited vertices instead and stop at the first neighbor found in the frontier
+// bitmap, which skips most of the edges into the already visited part of the graph.
+void Algorithms::bfsDirectionOptimizing(const CSRGraph& g, int source, Graph& result,
+                                        const DirectionOptimizingOptions& options, BfsStats* stats) {
     int numVertices = g.getNumVertices();
     
-    // Create a new graph for the MST
-    Graph result(numVertices);
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    if (options.alpha < 0 || options.beta <= 0) {
+        throw "Direction-optimizing thresholds must be positive";
+    }
     
-    // Create a structure to represent an edge
-    struct Edge {
-        int src, dest, weight;
-        
-        Edge() : src(0), dest(0), weight(0) {}
-        Edge(int s, int d, int w) : src(s), dest(d), weight(w) {}
-    };
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
     
-    // Create an array to store all edges
-    int maxEdges = numVertices * (numVertices - 1) / 2; // Maximum possible edges
-    Edge* edges = new Edge[maxEdges];
-    int edgeCount = 0;
+    // Use the caller's graph for the BFS tree
+    prepareResult(result, numVertices);
     
-    // Collect all edges from the graph
+    bool* visited = new bool[numVertices];
     for (int i = 0; i < numVertices; i++) {
-        Graph::Edge* edge = g.getAdjList(i);
-        while (edge != nullptr) {
-            if (i < edge->destination) { // To avoid duplicates in undirected graph
-                edges[edgeCount++] = Edge(i, edge->destination, edge->weight);
-            }
-            edge = edge->next;
-        }
+        visited[i] = false;
     }
     
-    // Sort edges by weight (bubble sort for simplicity)
-    for (int i = 0; i < edgeCount - 1; i++) {
-        for (int j = 0; j < edgeCount - i - 1; j++) {
-            if (edges[j].weight > edges[j + 1].weight) {
-                Edge temp = edges[j];
-                edges[j] = edges[j + 1];
-                edges[j + 1] = temp;
-            }
-        }
+    // Current and next level as vertex lists; the bitmap mirrors the current
+    // level while bottom-up steps run
+    int* frontier = new int[numVertices];
+    int* next = new int[numVertices];
+    int frontierSize = 0;
+    int nextSize = 0;
+    
+    int words = (numVertices + 63) / 64;
+    unsigned long long* frontierBits = new unsigned long long[words];
+    for (int i = 0; i < words; i++) {
+        frontierBits[i] = 0;
     }
     
-    // Create a Union-Find data structure
-    UnionFind uf(numVertices);
+    long long edgesInspected = 0;
+    int topDownSteps = 0;
+    int bottomUpSteps = 0;
     
-    // Process edges in ascending order of weight
-    for (int i = 0; i < edgeCount; i++) {
-        int src = edges[i].src;
-        int dest = edges[i].dest;
+    visited[source] = true;
+    frontier[frontierSize++] = source;
+    
+    // Edges leaving the frontier, and edges of vertices not yet visited
+    long long frontierEdges = offsets[source + 1] - offsets[source];
+    long long unexploredEdges = g.getNumHalfEdges() - frontierEdges;
+    bool bottomUp = false;
+    int previousSize = 0;
+    
+    while (frontierSize > 0) {
+        // Pick the direction of this step: go bottom-up while the frontier grows
+        // and has many edges, come back once it shrinks and gets small
+        bool growing = frontierSize > previousSize;
+        if (!bottomUp && options.alpha > 0 && growing &&
+            frontierEdges > unexploredEdges / options.alpha) {
+            bottomUp = true;
+        } else if (bottomUp && !growing && frontierSize < numVertices / options.beta) {
+            bottomUp = false;
+        }
+        previousSize = frontierSize;
         
-        // If including this edge doesn't cause a cycle
-        if (!uf.connected(src, dest)) {
-            // Add the edge to the MST
-            result.addEdge(src, dest, edges[i].weight);
+        nextSize = 0;
+        
+        if (bottomUp) {
+            bottomUpSteps++;
             
-            // Union the sets
-            uf.unite(src, dest);
+            for (int i = 0; i < frontierSize; i++) {
+                frontierBits[frontier[i] >> 6] |= 1ULL << (frontier[i] & 63);
+            }
+            
+            // Every unvisited vertex looks for a parent in the frontier
+            for (int v = 0; v < numVertices; v++) {
+                if (visited[v]) {
+                    continue;
+                }
+                for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+                    int u = destinations[i];
+                    edgesInspected++;
+                    
+                    if (frontierBits[u >> 6] & (1ULL << (u & 63))) {
+                        visited[v] = true;
+                        next[nextSize++] = v;
+                        result.addEdge(u, v, weights[i]);
+                        break;
+                    }
+                }
+            }
+            
+            for (int i = 0; i < frontierSize; i++) {
+                frontierBits[frontier[i] >> 6] = 0;
+            }
+        } else {
+            topDownSteps++;
+            
+            // Every frontier vertex claims its unvisited neighbors
+            for (int k = 0; k < frontierSize; k++) {
+                int u = frontier[k];
+                for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                    int v = destinations[i];
+                    edgesInspected++;
+                    
+                    if (!visited[v]) {
+                        visited[v] = true;
+                        next[nextSize++] = v;
+                        result.addEdge(u, v, weights[i]);
+                    }
+                }
+            }
+        }
+        
+        // The next level becomes the frontier
+        frontierEdges = 0;
+        for (int i = 0; i < nextSize; i++) {
+            frontierEdges += offsets[next[i] + 1] - offsets[next[i]];
         }
+        unexploredEdges -= frontierEdges;
+        
+        int* temp = frontier;
+        frontier = next;
+        next = temp;
+        frontierSize = nextSize;
     }
     
-    delete[] edges;
+    if (stats) {
+        stats->edgesInspected = edgesInspected;
+        stats->topDownSteps = topDownSteps;
+        stats->bottomUpSteps = bottomUpSteps;
+    }
     
+    delete[] frontierBits;
+    delete[] next;
+    delete[] frontier;
+    delete[] visited;
+}
+
+// Versions of the queue-policy templates returning a new graph
+template <typename Queue>
+Graph Algorithms::dijkstraWith(const Graph& g, int source) {
+    Graph result(g.getNumVertices());
+    dijkstraWith<Queue>(g, source, result);
     return result;
 }
 
+template <typename Queue>
+Graph Algorithms::dijkstraWith(const CSRGraph& g, int source) {
+    Graph result(g.getNumVertices());
+    dijkstraWith<Queue>(g, source, result);
+    return result;
+}
+
+template <typename Queue>
+Graph Algorithms::primWith(const Graph& g) {
+    Graph result(g.getNumVertices());
+    primWith<Queue>(g, result);
+    return result;
+}
+
+template <typename Queue>
+Graph Algorithms::primWith(const CSRGraph& g) {
+    Graph result(g.getNumVertices());
+    primWith<Queue>(g, result);
+    return result;
+}
+
+// Instantiate Dijkstra and Prim for every queue policy in PriorityQueues.hpp
+#define INSTANTIATE_QUEUE_POLICY(Queue) \
+    template Graph Algorithms::dijkstraWith<Queue>(const Graph&, int); \
+    template Graph Algorithms::dijkstraWith<Queue>(const CSRGraph&, int); \
+    template void Algorithms::dijkstraWith<Queue>(const Graph&, int, Graph&); \
+    template void Algorithms::dijkstraWith<Queue>(const CSRGraph&, int, Graph&); \
+    template Graph Algorithms::primWith<Queue>(const Graph&); \
+    template Graph Algorithms::primWith<Queue>(const CSRGraph&); \
+    template void Algorithms::primWith<Queue>(const Graph&, Graph&); \
+    template void Algorithms::primWith<Queue>(const CSRGraph&, Graph&); \
+    template void Algorithms::dijkstraWith<Queue>(const Graph&, int, SearchTree&); \
+    template void Algorithms::dijkstraWith<Queue>(const CSRGraph&, int, SearchTree&); \
+    template void Algorithms::primWith<Queue>(const Graph&, SearchTree&); \
+    template void Algorithms::primWith<Queue>(const CSRGraph&, SearchTree&);
+
+INSTANTIATE_QUEUE_POLICY(BinaryHeapQueue)
+INSTANTIATE_QUEUE_POLICY(DaryHeapQueue<4>)
+INSTANTIATE_QUEUE_POLICY(DaryHeapQueue<8>)
+INSTANTIATE_QUEUE_POLICY(BucketQueue)
+
+#undef INSTANTIATE_QUEUE_POLICY
+
 } // namespace graph
\ No newline at end of file
@@ -3,9 +3,63 @@
 #define ALGORITHMS_HPP
 
 #include "Graph.hpp"
+#include "CSRGraph.hpp"
+#include "CompressedGraph.hpp"
+#include "DenseGraph.hpp"
+#include "PriorityQueues.hpp"
+#include "Path.hpp"
+#include "SearchTree.hpp"
+#include "DistanceTable.hpp"
+#include "QueryContext.hpp"
 
 namespace graph {
 
+// Switching thresholds for direction-optimizing BFS.
+// A top-down step turns into bottom-up steps once the edges leaving the frontier
+// exceed (edges of unvisited vertices) / alpha, and goes back to top-down once
+// the frontier shrinks below numVertices / beta vertices. An alpha of 0 keeps
+// every step top-down.
+struct DirectionOptimizingOptions {
+    int alpha;
+    int beta;
+    
+    DirectionOptimizingOptions() : alpha(14), beta(24) {}
+    DirectionOptimizingOptions(int a, int b) : alpha(a), beta(b) {}
+};
+
+// Counters filled in by direction-optimizing BFS
+struct BfsStats {
+    long long edgesInspected;
+    int topDownSteps;
+    int bottomUpSteps;
+    
+    BfsStats() : edgesInspected(0), topDownSteps(0), bottomUpSteps(0) {}
+};
+
+// Callbacks for the iterative DFS engine. Override the events you need;
+// the default implementations do nothing.
+// In an undirected graph every non-tree edge is reported once, as a back edge
+// from the descendant to its ancestor; the edge back to the DFS parent is skipped.
+// A self-loop is one back edge from its vertex to itself.
+class DfsVisitor {
+public:
+    virtual ~DfsVisitor() {}
+    
+    virtual void discoverVertex(int /*vertex*/) {}
+    virtual void finishVertex(int /*vertex*/) {}
+    virtual void treeEdge(int /*source*/, int /*dest*/, int /*weight*/) {}
+    virtual void backEdge(int /*source*/, int /*dest*/, int /*weight*/) {}
+};
+
+// Lower bound on the distance from a vertex to the target of an A* query.
+// The estimate must never exceed the real distance (admissible).
+class Heuristic {
+public:
+    virtual ~Heuristic() {}
+    
+    virtual int estimate(int vertex) const = 0;
+};
+
 class Algorithms {
 public:
     // BFS algorithm - returns a rooted tree graph from BFS traversal
@@ -18,14 +72,218 @@ public:
     static Graph dijkstra(const Graph& g, int source);
     
     // Prim's algorithm - returns a minimum spanning tree
+    // (a minimum spanning forest if the graph is disconnected)
     static Graph prim(const Graph& g);
     
     // Kruskal's algorithm - returns a minimum spanning tree
     static Graph kruskal(const Graph& g);
     
+    // The same algorithms running on the compressed-sparse-row representation.
+    // Each one returns the same kind of tree as its Graph counterpart.
+    static Graph bfs(const CSRGraph& g, int source);
+    static Graph dfs(const CSRGraph& g, int source);
+    static Graph dijkstra(const CSRGraph& g, int source);
+    static Graph prim(const CSRGraph& g);
+    static Graph kruskal(const CSRGraph& g);
+    
+    // Versions that build their result into a caller-provided graph.
+    // The result graph is cleared first; when it already has the right number
+    // of vertices its edge storage is reused, so repeated queries do not reallocate.
+    // The result must not be the input graph itself.
+    static void bfs(const Graph& g, int source, Graph& result);
+    static void dfs(const Graph& g, int source, Graph& result);
+    static void dijkstra(const Graph& g, int source, Graph& result);
+    static void prim(const Graph& g, Graph& result);
+    static void kruskal(const Graph& g, Graph& result, int numThreads = 1);
+    static void bfs(const CSRGraph& g, int source, Graph& result);
+    static void dfs(const CSRGraph& g, int source, Graph& result);
+    static void dijkstra(const CSRGraph& g, int source, Graph& result);
+    static void prim(const CSRGraph& g, Graph& result);
+    static void kruskal(const CSRGraph& g, Graph& result, int numThreads = 1);
+    
+    // Versions returning the distances and parents as a SearchTree instead of a
+    // tree graph - nothing is allocated per vertex, and the tree graph is only built
+    // if SearchTree::toGraph is called. The versions taking a SearchTree reuse its
+    // arrays when the number of vertices matches.
+    static SearchTree bfsTree(const Graph& g, int source);
+    static SearchTree bfsTree(const CSRGraph& g, int source);
+    static SearchTree dijkstraTree(const Graph& g, int source);
+    static SearchTree dijkstraTree(const CSRGraph& g, int source);
+    static SearchTree primTree(const Graph& g);
+    static SearchTree primTree(const CSRGraph& g);
+    static void bfsTree(const Graph& g, int source, SearchTree& result);
+    static void bfsTree(const CSRGraph& g, int source, SearchTree& result);
+    static void dijkstraTree(const Graph& g, int source, SearchTree& result);
+    static void dijkstraTree(const CSRGraph& g, int source, SearchTree& result);
+    static void primTree(const Graph& g, SearchTree& result);
+    static void primTree(const CSRGraph& g, SearchTree& result);
+    
+    // Direction-optimizing BFS - switches between top-down steps and bottom-up
+    // steps over a frontier bitmap. Every vertex ends at the same depth as in bfs;
+    // while only top-down steps run the tree is identical to bfs.
+    // When stats is given it receives the number of edge checks and steps of each kind.
+    static Graph bfsDirectionOptimizing(const CSRGraph& g, int source,
+                                        const DirectionOptimizingOptions& options = DirectionOptimizingOptions(),
+                                        BfsStats* stats = nullptr);
+    static Graph bfsDirectionOptimizing(const Graph& g, int source,
+                                        const DirectionOptimizingOptions& options = DirectionOptimizingOptions(),
+                                        BfsStats* stats = nullptr);
+    static void bfsDirectionOptimizing(const CSRGraph& g, int source, Graph& result,
+                                       const DirectionOptimizingOptions& options = DirectionOptimizingOptions(),
+                                       BfsStats* stats = nullptr);
+    
+    // Dijkstra and Prim with a choice of priority queue (see PriorityQueues.hpp):
+    // BinaryHeapQueue, DaryHeapQueue<4>, DaryHeapQueue<8> or BucketQueue.
+    // dijkstra and prim use BinaryHeapQueue. BucketQueue needs non-negative weights.
+    template <typename Queue>
+    static Graph dijkstraWith(const Graph& g, int source);
+    template <typename Queue>
+    static Graph dijkstraWith(const CSRGraph& g, int source);
+    template <typename Queue>
+    static void dijkstraWith(const Graph& g, int source, Graph& result);
+    template <typename Queue>
+    static void dijkstraWith(const CSRGraph& g, int source, Graph& result);
+    template <typename Queue>
+    static Graph primWith(const Graph& g);
+    template <typename Queue>
+    static Graph primWith(const CSRGraph& g);
+    template <typename Queue>
+    static void primWith(const Graph& g, Graph& result);
+    template <typename Queue>
+    static void primWith(const CSRGraph& g, Graph& result);
+    template <typename Queue>
+    static void dijkstraWith(const Graph& g, int source, SearchTree& result);
+    template <typename Queue>
+    static void dijkstraWith(const CSRGraph& g, int source, SearchTree& result);
+    template <typename Queue>
+    static void primWith(const Graph& g, SearchTree& result);
+    template <typename Queue>
+    static void primWith(const CSRGraph& g, SearchTree& result);
+    
+    // Point-to-point queries - stop as soon as the shortest source-target path is
+    // known and return it directly. When settledCount is given it receives the number
+    // of vertices taken out of the queue.
+    // Bidirectional Dijkstra grows one search from each endpoint and stops once the
+    // two queue minimums together reach the best meeting distance.
+    static Path bidirectionalDijkstra(const Graph& g, int source, int target, int* settledCount = nullptr);
+    
+    // A* search guided by an admissible heuristic for the target
+    static Path aStar(const Graph& g, int source, int target, const Heuristic& heuristic,
+                      int* settledCount = nullptr);
+    
+    // The same queries in reusable QueryContexts, so that a query costs time in
+    // proportion to the vertices it reaches rather than O(V). Afterwards the contexts
+    // hold the labels of the search from the source (and from the target).
+    static Path bidirectionalDijkstra(const Graph& g, int source, int target, QueryContext& forward,
+                                      QueryContext& backward, int* settledCount = nullptr);
+    static Path aStar(const Graph& g, int source, int target, const Heuristic& heuristic, QueryContext& context,
+                      int* settledCount = nullptr);
+    
+    // Iterative DFS engine - uses an explicit stack, so the depth of the graph is
+    // not limited by the call stack. Visits vertices in the same order as dfs.
+    static void depthFirstSearch(const Graph& g, int source, DfsVisitor& visitor);
+    static void depthFirstSearch(const CSRGraph& g, int source, DfsVisitor& visitor);
+    
+    // Runs the engine from every vertex not reached yet, covering all components
+    static void depthFirstSearchAll(const Graph& g, DfsVisitor& visitor);
+    static void depthFirstSearchAll(const CSRGraph& g, DfsVisitor& visitor);
+    
+    // BFS and the DFS engine on the compressed representation (see CompressedGraph.hpp),
+    // decoding the neighbor lists as they go. Neighbors are visited in increasing
+    // order, so the results equal those on the decompressed CSRGraph.
+    static SearchTree bfsTree(const CompressedGraph& g, int source);
+    static void bfsTree(const CompressedGraph& g, int source, SearchTree& result);
+    static void depthFirstSearch(const CompressedGraph& g, int source, DfsVisitor& visitor);
+    static void depthFirstSearchAll(const CompressedGraph& g, DfsVisitor& visitor);
+    
+    // Bitwise BFS on the bit-matrix representation (see DenseGraph.hpp). Every vertex
+    // ends at the same depth as in bfs; its parent is its lowest neighbor on the
+    // previous level. Tree edges have weight 1.
+    static SearchTree bfsTree(const DenseGraph& g, int source);
+    static void bfsTree(const DenseGraph& g, int source, SearchTree& result);
+    
+    // Multithreaded level-synchronous BFS on numThreads std::thread workers.
+    // Returns a valid BFS tree: every vertex has the same depth as in bfs, but
+    // parents at equal depth may differ because threads race to claim vertices.
+    static Graph bfsParallel(const CSRGraph& g, int source, int numThreads);
+    static Graph bfsParallel(const Graph& g, int source, int numThreads);
+    static void bfsParallel(const CSRGraph& g, int source, int numThreads, Graph& result);
+    
+    // Parallel delta-stepping single-source shortest paths on numThreads threads.
+    // Vertices are kept in buckets of width delta; light edges (weight <= delta) of
+    // the current bucket are relaxed in parallel until it stays empty, then heavy edges.
+    // Fills distance[v] (INT_MAX when unreachable) and parent[v] (-1 for the source and
+    // unreachable vertices); both arrays need numVertices entries. Distances equal
+    // Dijkstra's; every parent lies on a shortest path. Weights must be non-negative.
+    static void deltaStepping(const CSRGraph& g, int source, int delta, int numThreads,
+                              int* distance, int* parent);
+    
+    // Shortest distances from many sources (see DistanceTable.hpp). The sources are
+    // handed out one at a time to numThreads workers; each worker keeps its queue and
+    // distance array for every source it takes, so nothing is allocated per source.
+    // The table version writes every row into the table, the sink version passes each
+    // row to the sink as soon as it is done. Weights must be non-negative. The Graph
+    // versions convert the graph to CSR once.
+    static void multiSourceDistances(const CSRGraph& g, const int* sources, int sourceCount, int numThreads,
+                                     DistanceTable& table);
+    static void multiSourceDistances(const CSRGraph& g, const int* sources, int sourceCount, int numThreads,
+                                     DistanceRowSink& sink);
+    static void multiSourceDistances(const Graph& g, const int* sources, int sourceCount, int numThreads,
+                                     DistanceTable& table);
+    static void multiSourceDistances(const Graph& g, const int* sources, int sourceCount, int numThreads,
+                                     DistanceRowSink& sink);
+    
+    // Every vertex as a source - a table of numVertices x numVertices entries
+    static DistanceTable allPairsDistances(const CSRGraph& g, int numThreads);
+    static DistanceTable allPairsDistances(const Graph& g, int numThreads);
+    
+    // Bounded searches into a reusable QueryContext - boundedBfs reaches the vertices
+    // at most maxHops edges from the source, boundedDijkstra those at distance at most
+    // radius. The cost is proportional to the part of the graph explored, not to the
+    // number of vertices. Returns the number of vertices reached. boundedDijkstra
+    // needs non-negative weights on the edges it scans.
+    static int boundedBfs(const Graph& g, int source, int maxHops, QueryContext& context);
+    static int boundedBfs(const CSRGraph& g, int source, int maxHops, QueryContext& context);
+    static int boundedDijkstra(const Graph& g, int source, int radius, QueryContext& context);
+    static int boundedDijkstra(const CSRGraph& g, int source, int radius, QueryContext& context);
+    
+    // Parallel Boruvka - every round each component picks its lightest outgoing edge
+    // (ties broken by edge position) and the picked edges merge the components.
+    // Returns a minimum spanning forest; the result does not depend on numThreads.
+    static Graph boruvka(const Graph& g, int numThreads);
+    static Graph boruvka(const CSRGraph& g, int numThreads);
+    static void boruvka(const CSRGraph& g, int numThreads, Graph& result);
+    
+    // Filter-Kruskal - partitions the edges around a pivot weight, builds the forest
+    // from the light part first and drops the heavy edges that already lie inside one
+    // component before sorting them. Partitions and filters run on numThreads threads.
+    // Returns a minimum spanning forest.
+    static Graph filterKruskal(const Graph& g, int numThreads = 1);
+    static Graph filterKruskal(const CSRGraph& g, int numThreads = 1);
+    static void filterKruskal(const CSRGraph& g, int numThreads, Graph& result);
+    
+    // Stable LSD radix sort of an edge list by weight (negative weights included).
+    // Passes whose digit is the same for every edge are skipped, so small weights
+    // cost a single pass. With numThreads > 1 every pass is split into blocks.
+    static void sortEdgesByWeight(WeightedEdge* edges, int edgeCount, int numThreads = 1);
+    
 private:
-    // Helper method for DFS
-    static void dfsVisit(const Graph& g, int vertex, bool* visited, Graph& result);
+    // Empty a result graph and make sure it has the given number of vertices
+    static void prepareResult(Graph& result, int numVertices);
+    
+    // Helper methods for the DFS engine - search from source and, when allComponents
+    // is set, afterwards from every vertex that is still unvisited
+    static void dfsRun(const Graph& g, int source, bool allComponents, DfsVisitor& visitor);
+    static void dfsRun(const CSRGraph& g, int source, bool allComponents, DfsVisitor& visitor);
+    static void dfsRun(const CompressedGraph& g, int source, bool allComponents, DfsVisitor& visitor);
+    
+    // Shared driver for multiSourceDistances - fills exactly one of table and sink
+    static void multiSourceRun(const CSRGraph& g, const int* sources, int sourceCount, int numThreads,
+                               DistanceTable* table, DistanceRowSink* sink);
+    
+    // Helper method for Kruskal - sorts the given edges and builds the spanning forest
+    static void kruskalFromEdges(int numVertices, WeightedEdge* edges, int edgeCount, Graph& result,
+                                 int numThreads);
 };
 
 } // namespace graph
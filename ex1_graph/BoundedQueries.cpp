@@ -0,0 +1,183 @@
+// boundedqueries.cpp
+#include "Algorithms.hpp"
+
+namespace graph {
+
+// The searches below only touch the context entries of the vertices they reach, so
+// no array is allocated or cleared per query. Weights are checked as the edges are
+// scanned - checking the whole graph first would cost O(E) per query.
+
+int Algorithms::boundedBfs(const Graph& g, int source, int maxHops, QueryContext& context) {
+    int numVertices = g.getNumVertices();
+
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    if (maxHops < 0) {
+        throw "Hop limit must not be negative";
+    }
+
+    context.begin(numVertices, source);
+    context.reach(source, 0, -1, 0);
+    context.record(source);
+
+    // The reached list is the queue: vertices are appended in BFS order
+    const int* queue = context.reached;
+    const int* distance = context.distance;
+    for (int head = 0; head < context.reachedCount; head++) {
+        int current = queue[head];
+        int depth = distance[current];
+        if (depth == maxHops) {
+            continue; // Reached but not expanded
+        }
+
+        for (Graph::Edge* edge = g.getAdjList(current); edge; edge = edge->next) {
+            int adjacent = edge->destination;
+            if (!context.seen(adjacent)) {
+                context.reach(adjacent, depth + 1, current, edge->weight);
+                context.record(adjacent);
+            }
+        }
+    }
+
+    return context.reachedCount;
+}
+
+int Algorithms::boundedBfs(const CSRGraph& g, int source, int maxHops, QueryContext& context) {
+    int numVertices = g.getNumVertices();
+
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    if (maxHops < 0) {
+        throw "Hop limit must not be negative";
+    }
+
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
+
+    context.begin(numVertices, source);
+    context.reach(source, 0, -1, 0);
+    context.record(source);
+
+    const int* queue = context.reached;
+    const int* distance = context.distance;
+    for (int head = 0; head < context.reachedCount; head++) {
+        int current = queue[head];
+        int depth = distance[current];
+        if (depth == maxHops) {
+            continue;
+        }
+
+        for (int i = offsets[current]; i < offsets[current + 1]; i++) {
+            int adjacent = destinations[i];
+            if (!context.seen(adjacent)) {
+                context.reach(adjacent, depth + 1, current, weights[i]);
+                context.record(adjacent);
+            }
+        }
+    }
+
+    return context.reachedCount;
+}
+
+// Dijkstra with the stale-entry check of multiSourceDistances. An edge is only
+// relaxed when it stays within the radius (written as w <= radius - d so that it
+// cannot overflow), so every vertex in the queue is settled eventually and the
+// reached list ends up in order of distance.
+int Algorithms::boundedDijkstra(const Graph& g, int source, int radius, QueryContext& context) {
+    int numVertices = g.getNumVertices();
+
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    if (radius < 0) {
+        throw "Radius must not be negative";
+    }
+
+    context.begin(numVertices, source);
+    context.reach(source, 0, -1, 0);
+    BinaryHeapQueue& pq = context.queue;
+    pq.push(source, 0);
+
+    const int* distance = context.distance;
+    while (!pq.isEmpty()) {
+        int u;
+        int d;
+        pq.popMin(u, d);
+
+        if (d > distance[u]) {
+            continue; // Stale entry
+        }
+        context.record(u);
+
+        for (Graph::Edge* edge = g.getAdjList(u); edge; edge = edge->next) {
+            int v = edge->destination;
+            int w = edge->weight;
+            if (w < 0) {
+                throw "Bounded Dijkstra needs non-negative weights";
+            }
+            if (w > radius - d) {
+                continue;
+            }
+            if (!context.seen(v) || d + w < distance[v]) {
+                context.reach(v, d + w, u, w);
+                pq.push(v, d + w);
+            }
+        }
+    }
+
+    return context.reachedCount;
+}
+
+int Algorithms::boundedDijkstra(const CSRGraph& g, int source, int radius, QueryContext& context) {
+    int numVertices = g.getNumVertices();
+
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    if (radius < 0) {
+        throw "Radius must not be negative";
+    }
+
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
+
+    context.begin(numVertices, source);
+    context.reach(source, 0, -1, 0);
+    BinaryHeapQueue& pq = context.queue;
+    pq.push(source, 0);
+
+    const int* distance = context.distance;
+    while (!pq.isEmpty()) {
+        int u;
+        int d;
+        pq.popMin(u, d);
+
+        if (d > distance[u]) {
+            continue;
+        }
+        context.record(u);
+
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int v = destinations[i];
+            int w = weights[i];
+            if (w < 0) {
+                throw "Bounded Dijkstra needs non-negative weights";
+            }
+            if (w > radius - d) {
+                continue;
+            }
+            if (!context.seen(v) || d + w < distance[v]) {
+                context.reach(v, d + w, u, w);
+                pq.push(v, d + w);
+            }
+        }
+    }
+
+    return context.reachedCount;
+}
+
+} // namespace graph
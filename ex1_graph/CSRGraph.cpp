@@ -0,0 +1,264 @@
+// csrgraph.cpp
+#include "CSRGraph.hpp"
+
+namespace graph {
+
+// Allocate the three CSR arrays
+void CSRGraph::allocate(int vertices, int halfEdges) {
+    numVertices = vertices;
+    numHalfEdges = halfEdges;
+    owner = true;
+    offsets = new int[vertices + 1];
+    destinations = new int[halfEdges > 0 ? halfEdges : 1];
+    weights = new int[halfEdges > 0 ? halfEdges : 1];
+}
+
+void CSRGraph::release() {
+    if (owner) {
+        delete[] offsets;
+        delete[] destinations;
+        delete[] weights;
+    }
+}
+
+void CSRGraph::copyFrom(const CSRGraph& other) {
+    allocate(other.numVertices, other.numHalfEdges);
+    if (!other.offsets) { // A moved-from graph has no arrays
+        offsets[0] = 0;
+        return;
+    }
+    for (int i = 0; i <= numVertices; i++) {
+        offsets[i] = other.offsets[i];
+    }
+    for (int i = 0; i < numHalfEdges; i++) {
+        destinations[i] = other.destinations[i];
+        weights[i] = other.weights[i];
+    }
+}
+
+// Take over the arrays of another graph, leaving it empty
+void CSRGraph::takeFrom(CSRGraph& other) {
+    numVertices = other.numVertices;
+    numHalfEdges = other.numHalfEdges;
+    offsets = other.offsets;
+    destinations = other.destinations;
+    weights = other.weights;
+    owner = other.owner;
+
+    other.numVertices = 0;
+    other.numHalfEdges = 0;
+    other.offsets = nullptr;
+    other.destinations = nullptr;
+    other.weights = nullptr;
+    other.owner = true;
+}
+
+// Empty graph, filled in by view()
+CSRGraph::CSRGraph()
+    : numVertices(0), numHalfEdges(0), offsets(nullptr), destinations(nullptr), weights(nullptr), owner(true) {}
+
+CSRGraph CSRGraph::view(int vertices, int halfEdges, const int* offsets,
+                        const int* destinations, const int* weights) {
+    if (vertices <= 0) {
+        throw "Number of vertices must be positive";
+    }
+    if (halfEdges < 0) {
+        throw "Edge count must not be negative";
+    }
+
+    // The view never writes through these pointers
+    CSRGraph g;
+    g.numVertices = vertices;
+    g.numHalfEdges = halfEdges;
+    g.offsets = const_cast<int*>(offsets);
+    g.destinations = const_cast<int*>(destinations);
+    g.weights = const_cast<int*>(weights);
+    g.owner = false;
+    return g;
+}
+
+// Build from an adjacency-list graph
+CSRGraph::CSRGraph(const Graph& g) {
+    int vertices = g.getNumVertices();
+
+    // First pass: count the half-edges
+    int halfEdges = 0;
+    for (int i = 0; i < vertices; i++) {
+        for (Graph::Edge* edge = g.getAdjList(i); edge != nullptr; edge = edge->next) {
+            halfEdges++;
+        }
+    }
+
+    allocate(vertices, halfEdges);
+
+    // Second pass: copy each list into its contiguous range
+    int pos = 0;
+    for (int i = 0; i < vertices; i++) {
+        offsets[i] = pos;
+        for (Graph::Edge* edge = g.getAdjList(i); edge != nullptr; edge = edge->next) {
+            destinations[pos] = edge->destination;
+            weights[pos] = edge->weight;
+            pos++;
+        }
+    }
+    offsets[vertices] = pos;
+}
+
+// Build from an edge list
+CSRGraph::CSRGraph(int vertices, const WeightedEdge* edges, int edgeCount) {
+    if (vertices <= 0) {
+        throw "Number of vertices must be positive";
+    }
+    if (edgeCount < 0) {
+        throw "Edge count must not be negative";
+    }
+    if (edgeCount > 1073741823) {
+        throw "Too many edges"; // Keeps 2 * edgeCount, the number of half-edges, within an int
+    }
+
+    for (int i = 0; i < edgeCount; i++) {
+        if (edges[i].source < 0 || edges[i].source >= vertices ||
+            edges[i].dest < 0 || edges[i].dest >= vertices) {
+            throw "Vertex index out of range";
+        }
+    }
+
+    allocate(vertices, 2 * edgeCount);
+
+    // Count the degree of every vertex
+    for (int i = 0; i <= vertices; i++) {
+        offsets[i] = 0;
+    }
+    for (int i = 0; i < edgeCount; i++) {
+        offsets[edges[i].source + 1]++;
+        offsets[edges[i].dest + 1]++;
+    }
+
+    // Prefix sums turn degrees into start offsets
+    for (int i = 0; i < vertices; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    // Scatter both directions of every edge, using a cursor per vertex
+    int* cursor = new int[vertices];
+    for (int i = 0; i < vertices; i++) {
+        cursor[i] = offsets[i];
+    }
+    for (int i = 0; i < edgeCount; i++) {
+        int u = edges[i].source;
+        int v = edges[i].dest;
+
+        destinations[cursor[u]] = v;
+        weights[cursor[u]] = edges[i].weight;
+        cursor[u]++;
+
+        destinations[cursor[v]] = u;
+        weights[cursor[v]] = edges[i].weight;
+        cursor[v]++;
+    }
+    delete[] cursor;
+}
+
+CSRGraph::~CSRGraph() {
+    release();
+}
+
+// Copy constructor
+CSRGraph::CSRGraph(const CSRGraph& other) {
+    copyFrom(other);
+}
+
+// Assignment operator
+CSRGraph& CSRGraph::operator=(const CSRGraph& other) {
+    if (this != &other) {
+        release();
+        copyFrom(other);
+    }
+    return *this;
+}
+
+// Move constructor
+CSRGraph::CSRGraph(CSRGraph&& other) noexcept {
+    takeFrom(other);
+}
+
+// Move assignment operator
+CSRGraph& CSRGraph::operator=(CSRGraph&& other) noexcept {
+    if (this != &other) {
+        release();
+        takeFrom(other);
+    }
+    return *this;
+}
+
+int CSRGraph::getNumVertices() const {
+    return numVertices;
+}
+
+int CSRGraph::getNumEdges() const {
+    return numHalfEdges / 2;
+}
+
+int CSRGraph::getNumHalfEdges() const {
+    return numHalfEdges;
+}
+
+int CSRGraph::getDegree(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+    return offsets[vertex + 1] - offsets[vertex];
+}
+
+const int* CSRGraph::getNeighbors(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+    return destinations + offsets[vertex];
+}
+
+const int* CSRGraph::getNeighborWeights(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+    return weights + offsets[vertex];
+}
+
+const int* CSRGraph::getOffsets() const {
+    return offsets;
+}
+
+const int* CSRGraph::getDestinations() const {
+    return destinations;
+}
+
+const int* CSRGraph::getWeights() const {
+    return weights;
+}
+
+bool CSRGraph::ownsArrays() const {
+    return owner;
+}
+
+Graph CSRGraph::toGraph() const {
+    Graph result(numVertices);
+
+    for (int u = 0; u < numVertices; u++) {
+        bool skipLoop = false; // A self-loop is stored twice in its own list
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int v = destinations[i];
+            if (u < v) {
+                result.addEdge(u, v, weights[i]);
+            } else if (u == v) {
+                if (!skipLoop) {
+                    result.addEdge(u, v, weights[i]);
+                }
+                skipLoop = !skipLoop;
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace graph
@@ -0,0 +1,73 @@
+// csrgraph.hpp
+#ifndef CSRGRAPH_HPP
+#define CSRGRAPH_HPP
+
+#include "Graph.hpp"
+
+namespace graph {
+
+// Immutable compressed-sparse-row (CSR) representation of an undirected graph.
+// The neighbors of vertex v are destinations[offsets[v]] .. destinations[offsets[v + 1] - 1],
+// with the matching weights stored at the same positions in the weights array.
+// Every undirected edge is stored twice (once per endpoint), like in Graph.
+class CSRGraph {
+public:
+    // Build from an existing adjacency-list graph (neighbor order is preserved)
+    explicit CSRGraph(const Graph& g);
+
+    // Build from an edge list of undirected edges
+    CSRGraph(int vertices, const WeightedEdge* edges, int edgeCount);
+
+    // Non-owning view of existing CSR arrays (for example a mapped file). The arrays
+    // must outlive the view and are never written or freed by it. Copying a view
+    // gives an ordinary graph with its own arrays.
+    static CSRGraph view(int vertices, int halfEdges, const int* offsets,
+                         const int* destinations, const int* weights);
+
+    ~CSRGraph();
+
+    // Copy constructor and assignment operator
+    CSRGraph(const CSRGraph& other);
+    CSRGraph& operator=(const CSRGraph& other);
+
+    // Move constructor and move assignment - the moved-from graph is left empty
+    CSRGraph(CSRGraph&& other) noexcept;
+    CSRGraph& operator=(CSRGraph&& other) noexcept;
+
+    // Accessor methods
+    int getNumVertices() const;
+    int getNumEdges() const;      // Number of undirected edges
+    int getNumHalfEdges() const;  // Number of stored (directed) entries, 2 * getNumEdges()
+    int getDegree(int vertex) const;
+    const int* getNeighbors(int vertex) const;
+    const int* getNeighborWeights(int vertex) const;
+
+    // Raw arrays for tight loops (no range checks)
+    const int* getOffsets() const;
+    const int* getDestinations() const;
+    const int* getWeights() const;
+
+    // Convert back to an adjacency-list graph
+    Graph toGraph() const;
+
+    // True if the arrays belong to this graph, false for a view
+    bool ownsArrays() const;
+
+private:
+    int numVertices;
+    int numHalfEdges;
+    int* offsets;       // numVertices + 1 entries
+    int* destinations;  // numHalfEdges entries
+    int* weights;       // numHalfEdges entries
+    bool owner;         // False for a view: the arrays are released by someone else
+
+    CSRGraph();
+    void allocate(int vertices, int halfEdges);
+    void release();
+    void copyFrom(const CSRGraph& other);
+    void takeFrom(CSRGraph& other);
+};
+
+} // namespace graph
+
+#endif // CSRGRAPH_HPP
@@ -0,0 +1,314 @@
+// compressedgraph.cpp
+#include "CompressedGraph.hpp"
+
+namespace graph {
+
+// Bytes of the varint encoding of a value
+static int varintLength(unsigned int value) {
+    int length = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        length++;
+    }
+    return length;
+}
+
+static unsigned char* writeVarint(unsigned char* position, unsigned int value) {
+    while (value >= 0x80) {
+        *position++ = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    *position++ = (unsigned char)value;
+    return position;
+}
+
+// Signed difference mapped to unsigned so that small magnitudes stay small:
+// 0, -1, 1, -2, 2 ... become 0, 1, 2, 3, 4 ...
+static unsigned int zigzag(int vertex, int neighbor) {
+    long long difference = (long long)neighbor - vertex;
+    return difference >= 0 ? (unsigned int)(2 * difference) : (unsigned int)(-2 * difference - 1);
+}
+
+CompressedGraph::CompressedGraph(const Graph& g)
+    : numVertices(0), numHalfEdges(0), starts(nullptr), bytes(nullptr), weightBytes(0), weightBase(0) {
+    build(CSRGraph(g));
+}
+
+CompressedGraph::CompressedGraph(const CSRGraph& g)
+    : numVertices(0), numHalfEdges(0), starts(nullptr), bytes(nullptr), weightBytes(0), weightBase(0) {
+    build(g);
+}
+
+void CompressedGraph::build(const CSRGraph& g) {
+    int vertices = g.getNumVertices();
+    int halfEdges = g.getNumHalfEdges();
+    const int* csrOffsets = g.getOffsets();
+    const int* csrDestinations = g.getDestinations();
+    const int* csrWeights = g.getWeights();
+
+    // Sort every list by transposing the half-edges twice. The first pass lists the
+    // arcs into each vertex by increasing source; the second puts every arc back in
+    // its source's list, which then fills in order of the destination. Neither pass
+    // needs the lists to be symmetric, so a view with one-way arcs keeps its lists.
+    int* inOffsets = new int[vertices + 1];
+    int* inSources = new int[halfEdges > 0 ? halfEdges : 1];
+    int* inWeights = new int[halfEdges > 0 ? halfEdges : 1];
+    for (int v = 0; v <= vertices; v++) {
+        inOffsets[v] = 0;
+    }
+    for (int i = 0; i < halfEdges; i++) {
+        if (csrDestinations[i] < 0 || csrDestinations[i] >= vertices) {
+            delete[] inOffsets;
+            delete[] inSources;
+            delete[] inWeights;
+            throw "Vertex index out of range";
+        }
+        inOffsets[csrDestinations[i] + 1]++;
+    }
+    for (int v = 0; v < vertices; v++) {
+        inOffsets[v + 1] += inOffsets[v];
+    }
+
+    int* cursor = new int[vertices];
+    for (int v = 0; v < vertices; v++) {
+        cursor[v] = inOffsets[v];
+    }
+    for (int u = 0; u < vertices; u++) {
+        for (int i = csrOffsets[u]; i < csrOffsets[u + 1]; i++) {
+            int position = cursor[csrDestinations[i]]++;
+            inSources[position] = u;
+            inWeights[position] = csrWeights[i];
+        }
+    }
+
+    int* sorted = new int[halfEdges > 0 ? halfEdges : 1];
+    int* sortedWeights = new int[halfEdges > 0 ? halfEdges : 1];
+    for (int v = 0; v < vertices; v++) {
+        cursor[v] = csrOffsets[v];
+    }
+    for (int v = 0; v < vertices; v++) {
+        for (int i = inOffsets[v]; i < inOffsets[v + 1]; i++) {
+            int position = cursor[inSources[i]]++;
+            sorted[position] = v;
+            sortedWeights[position] = inWeights[i];
+        }
+    }
+    delete[] cursor;
+    delete[] inOffsets;
+    delete[] inSources;
+    delete[] inWeights;
+
+    // Narrowest weight width for the range of the weights
+    int smallest = halfEdges > 0 ? sortedWeights[0] : 0;
+    int largest = smallest;
+    for (int i = 1; i < halfEdges; i++) {
+        smallest = sortedWeights[i] < smallest ? sortedWeights[i] : smallest;
+        largest = sortedWeights[i] > largest ? sortedWeights[i] : largest;
+    }
+    long long range = (long long)largest - smallest;
+
+    numVertices = vertices;
+    numHalfEdges = halfEdges;
+    weightBytes = range == 0 ? 0 : range <= 0xff ? 1 : range <= 0xffff ? 2 : 4;
+    weightBase = weightBytes == 4 ? 0 : smallest;
+
+    // Sizes of the encoded lists
+    starts = new long long[vertices + 1];
+    long long totalBytes = 0;
+    for (int v = 0; v < vertices; v++) {
+        int begin = csrOffsets[v];
+        int end = csrOffsets[v + 1];
+        starts[v] = totalBytes;
+        totalBytes += varintLength((unsigned int)(end - begin)) + (long long)(end - begin) * weightBytes;
+        if (begin < end) {
+            totalBytes += varintLength(zigzag(v, sorted[begin]));
+        }
+        for (int i = begin + 1; i < end; i++) {
+            totalBytes += varintLength((unsigned int)(sorted[i] - sorted[i - 1]));
+        }
+    }
+    starts[vertices] = totalBytes;
+
+    bytes = new unsigned char[totalBytes > 0 ? totalBytes : 1];
+    unsigned char* position = bytes;
+    for (int v = 0; v < vertices; v++) {
+        int begin = csrOffsets[v];
+        int end = csrOffsets[v + 1];
+        position = writeVarint(position, (unsigned int)(end - begin));
+        for (int i = begin; i < end; i++) {
+            unsigned int value = (unsigned int)sortedWeights[i] - (unsigned int)weightBase;
+            for (int b = 0; b < weightBytes; b++) {
+                *position++ = (unsigned char)(value >> (8 * b));
+            }
+        }
+        if (begin < end) {
+            position = writeVarint(position, zigzag(v, sorted[begin]));
+        }
+        for (int i = begin + 1; i < end; i++) {
+            position = writeVarint(position, (unsigned int)(sorted[i] - sorted[i - 1]));
+        }
+    }
+
+    delete[] sorted;
+    delete[] sortedWeights;
+}
+
+void CompressedGraph::release() {
+    delete[] starts;
+    delete[] bytes;
+    starts = nullptr;
+    bytes = nullptr;
+}
+
+void CompressedGraph::copyFrom(const CompressedGraph& other) {
+    numVertices = other.numVertices;
+    numHalfEdges = other.numHalfEdges;
+    weightBytes = other.weightBytes;
+    weightBase = other.weightBase;
+    starts = nullptr;
+    bytes = nullptr;
+    if (!other.starts) { // A moved-from graph has no arrays
+        return;
+    }
+
+    long long totalBytes = other.starts[numVertices];
+    starts = new long long[numVertices + 1];
+    bytes = new unsigned char[totalBytes > 0 ? totalBytes : 1];
+    for (int v = 0; v <= numVertices; v++) {
+        starts[v] = other.starts[v];
+    }
+    for (long long i = 0; i < totalBytes; i++) {
+        bytes[i] = other.bytes[i];
+    }
+}
+
+// Take over the arrays of another graph, leaving it empty
+void CompressedGraph::takeFrom(CompressedGraph& other) {
+    numVertices = other.numVertices;
+    numHalfEdges = other.numHalfEdges;
+    starts = other.starts;
+    bytes = other.bytes;
+    weightBytes = other.weightBytes;
+    weightBase = other.weightBase;
+
+    other.numVertices = 0;
+    other.numHalfEdges = 0;
+    other.starts = nullptr;
+    other.bytes = nullptr;
+    other.weightBytes = 0;
+    other.weightBase = 0;
+}
+
+CompressedGraph::~CompressedGraph() {
+    release();
+}
+
+// Copy constructor
+CompressedGraph::CompressedGraph(const CompressedGraph& other) {
+    copyFrom(other);
+}
+
+// Assignment operator
+CompressedGraph& CompressedGraph::operator=(const CompressedGraph& other) {
+    if (this != &other) {
+        CompressedGraph copy(other);
+        *this = static_cast<CompressedGraph&&>(copy);
+    }
+    return *this;
+}
+
+// Move constructor
+CompressedGraph::CompressedGraph(CompressedGraph&& other) noexcept {
+    takeFrom(other);
+}
+
+// Move assignment operator
+CompressedGraph& CompressedGraph::operator=(CompressedGraph&& other) noexcept {
+    if (this != &other) {
+        release();
+        takeFrom(other);
+    }
+    return *this;
+}
+
+int CompressedGraph::getNumVertices() const {
+    return numVertices;
+}
+
+int CompressedGraph::getNumEdges() const {
+    return numHalfEdges / 2;
+}
+
+int CompressedGraph::getNumHalfEdges() const {
+    return numHalfEdges;
+}
+
+int CompressedGraph::getDegree(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+    const unsigned char* position = bytes + starts[vertex];
+    return (int)readVarint(position);
+}
+
+int CompressedGraph::getWeightBytes() const {
+    return weightBytes;
+}
+
+long long CompressedGraph::getMemoryBytes() const {
+    if (!starts) {
+        return sizeof(CompressedGraph);
+    }
+    return sizeof(CompressedGraph) + (long long)(numVertices + 1) * sizeof(long long) + starts[numVertices];
+}
+
+CSRGraph CompressedGraph::toCSR() const {
+    if (numVertices == 0) {
+        throw "Number of vertices must be positive";
+    }
+
+    int* csrOffsets = new int[numVertices + 1];
+    int* destinations = new int[numHalfEdges > 0 ? numHalfEdges : 1];
+    int* csrWeights = new int[numHalfEdges > 0 ? numHalfEdges : 1];
+    int i = 0;
+    for (int v = 0; v < numVertices; v++) {
+        csrOffsets[v] = i;
+        for (NeighborIterator it = neighbors(v); !it.done(); it.next()) {
+            destinations[i] = it.vertex();
+            csrWeights[i] = it.weight();
+            i++;
+        }
+    }
+    csrOffsets[numVertices] = numHalfEdges;
+
+    // Copying a view gives a graph with its own arrays
+    CSRGraph view = CSRGraph::view(numVertices, numHalfEdges, csrOffsets, destinations, csrWeights);
+    CSRGraph result(view);
+    delete[] csrOffsets;
+    delete[] destinations;
+    delete[] csrWeights;
+    return result;
+}
+
+Graph CompressedGraph::toGraph() const {
+    Graph result(numVertices);
+
+    for (int u = 0; u < numVertices; u++) {
+        bool skipLoop = false; // A self-loop is stored twice in its own list
+        for (NeighborIterator it = neighbors(u); !it.done(); it.next()) {
+            int v = it.vertex();
+            if (u < v) {
+                result.addEdge(u, v, it.weight());
+            } else if (u == v) {
+                if (!skipLoop) {
+                    result.addEdge(u, v, it.weight());
+                }
+                skipLoop = !skipLoop;
+            }
+        }
+    }
+
+    return result;
+}
+
+} // namespace graph
@@ -0,0 +1,175 @@
+// compressedgraph.hpp
+#ifndef COMPRESSEDGRAPH_HPP
+#define COMPRESSEDGRAPH_HPP
+
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+
+namespace graph {
+
+// Read-only undirected graph with compressed neighbor lists, for graphs too large
+// to keep as Graph or CSRGraph.
+//
+// The list of a vertex is one byte string, found through a single offset per
+// vertex. It holds, in order:
+// - the degree, as a varint (7 bits per byte, the high bit set on all bytes but the last)
+// - the weights of the edges, with the narrowest fixed width that holds every weight
+//   of the graph: nothing when all weights are equal, one or two bytes for an offset
+//   from the smallest weight, otherwise the four-byte value
+// - the neighbors in increasing order, as varints: the first one as the zigzag-encoded
+//   difference to the vertex itself, every further one as the gap to the previous one
+// Keeping the weights apart from the neighbors lets a traversal skip them, and their
+// fixed width lets it read the weight of any edge directly.
+//
+// Lists are decoded on the fly by NeighborIterator. As in Graph, every undirected
+// edge is stored twice and a self-loop appears twice in its vertex's list.
+class CompressedGraph {
+public:
+    // Build from an adjacency-list or CSR graph. Parallel edges and self-loops are
+    // kept; neighbors come out in increasing order. Every list is compressed as it
+    // is, so a CSR view whose arcs are not all stored both ways keeps them one-way.
+    explicit CompressedGraph(const Graph& g);
+    explicit CompressedGraph(const CSRGraph& g);
+    ~CompressedGraph();
+
+    // Copy and move
+    CompressedGraph(const CompressedGraph& other);
+    CompressedGraph& operator=(const CompressedGraph& other);
+    CompressedGraph(CompressedGraph&& other) noexcept;
+    CompressedGraph& operator=(CompressedGraph&& other) noexcept;
+
+    // Walks one neighbor list, decoding one neighbor per step:
+    //     for (CompressedGraph::NeighborIterator it = g.neighbors(v); !it.done(); it.next())
+    class NeighborIterator {
+    public:
+        NeighborIterator() : graph(nullptr), position(nullptr), weightData(nullptr), remaining(0), current(0) {}
+
+        bool done() const {
+            return remaining == 0;
+        }
+
+        int vertex() const {
+            return current;
+        }
+
+        int weight() const {
+            return graph->readWeight(weightData);
+        }
+
+        void next() {
+            weightData += graph->weightBytes;
+            if (--remaining > 0) {
+                current += (int)readVarint(position);
+            }
+        }
+
+    private:
+        friend class CompressedGraph;
+
+        const CompressedGraph* graph;
+        const unsigned char* position;   // Start of the next encoded gap
+        const unsigned char* weightData; // Weight of the current neighbor
+        int remaining;                   // Neighbors left, the current one included
+        int current;
+    };
+
+    int getNumVertices() const;
+    int getNumEdges() const;      // Number of undirected edges
+    int getNumHalfEdges() const;
+    int getDegree(int vertex) const;
+
+    // Defined here so that a traversal keeps the iterator in registers
+    NeighborIterator neighbors(int vertex) const {
+        if (vertex < 0 || vertex >= numVertices) {
+            throw "Vertex index out of range";
+        }
+
+        NeighborIterator it;
+        it.graph = this;
+        const unsigned char* position = bytes + starts[vertex];
+        it.remaining = (int)readVarint(position);
+        it.weightData = position;
+        it.position = position + (long long)it.remaining * weightBytes;
+        if (it.remaining > 0) {
+            unsigned int first = readVarint(it.position);
+            it.current = (int)(vertex + (first & 1 ? -(long long)(first >> 1) - 1 : (long long)(first >> 1)));
+        }
+        return it;
+    }
+
+    // Hints for traversals that know which lists they open next: start loading the
+    // offset of a vertex's list, and a few steps later the list itself. Decoding
+    // keeps the processor from running far enough ahead to overlap these misses on
+    // its own. No range checks.
+    void prefetchStart(int vertex) const {
+        __builtin_prefetch(starts + vertex);
+    }
+
+    void prefetchList(int vertex) const {
+        __builtin_prefetch(bytes + starts[vertex]);
+    }
+
+    int getWeightBytes() const;   // Bytes per stored weight: 0, 1, 2 or 4
+    long long getMemoryBytes() const;
+
+    // Decompress into the other representations, neighbors in increasing order
+    CSRGraph toCSR() const;
+    Graph toGraph() const;
+
+private:
+    int numVertices;
+    int numHalfEdges;
+    long long* starts;          // Byte offset of every list, numVertices + 1 entries
+    unsigned char* bytes;       // The encoded lists
+    int weightBytes;
+    int weightBase;             // Added to 1- and 2-byte weights; the weight itself for 0 bytes
+
+    void build(const CSRGraph& g);
+    void release();
+    void copyFrom(const CompressedGraph& other);
+    void takeFrom(CompressedGraph& other);
+
+    int readWeight(const unsigned char* data) const {
+        switch (weightBytes) {
+        case 0:
+            return weightBase;
+        case 1:
+            return weightBase + data[0];
+        case 2:
+            return weightBase + (data[0] | data[1] << 8);
+        default:
+            return (int)(data[0] | data[1] << 8 | data[2] << 16 | (unsigned int)data[3] << 24);
+        }
+    }
+
+    // Unrolled - most values take one to three bytes
+    static unsigned int readVarint(const unsigned char*& position) {
+        const unsigned char* data = position;
+        unsigned int value = data[0];
+        if (value < 0x80) {
+            position = data + 1;
+            return value;
+        }
+        value = (value & 0x7f) | (unsigned int)data[1] << 7;
+        if (data[1] < 0x80) {
+            position = data + 2;
+            return value;
+        }
+        value = (value & 0x3fff) | (unsigned int)data[2] << 14;
+        if (data[2] < 0x80) {
+            position = data + 3;
+            return value;
+        }
+        value = (value & 0x1fffff) | (unsigned int)data[3] << 21;
+        if (data[3] < 0x80) {
+            position = data + 4;
+            return value;
+        }
+        position = data + 5;
+        return (value & 0xfffffff) | (unsigned int)data[4] << 28;
+    }
+};
+
+} // namespace graph
+
+#endif // COMPRESSEDGRAPH_HPP
@@ -0,0 +1,151 @@
+// compressedtraversals.cpp
+#include "Algorithms.hpp"
+#include <climits>
+
+namespace graph {
+
+// BFS and DFS over a CompressedGraph. They read each neighbor list once, in
+// increasing neighbor order, through NeighborIterator. BFS only decodes the weight
+// of an edge when the edge enters the tree.
+
+SearchTree Algorithms::bfsTree(const CompressedGraph& g, int source) {
+    SearchTree result;
+    bfsTree(g, source, result);
+    return result;
+}
+
+void Algorithms::bfsTree(const CompressedGraph& g, int source, SearchTree& result) {
+    int numVertices = g.getNumVertices();
+
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+
+    result.reset(numVertices, source);
+    int* distance = result.distance;
+    int* parent = result.parent;
+    int* parentWeight = result.parentWeight;
+
+    int* queue = new int[numVertices];
+    int head = 0;
+    int tail = 0;
+    queue[tail++] = source;
+
+    while (head < tail) {
+        int current = queue[head++];
+
+        // Open the lists of the vertices a few places further down the queue
+        if (head + 8 < tail) {
+            g.prefetchStart(queue[head + 8]);
+        }
+        if (head + 4 < tail) {
+            g.prefetchList(queue[head + 4]);
+        }
+
+        for (CompressedGraph::NeighborIterator it = g.neighbors(current); !it.done(); it.next()) {
+            int adjacent = it.vertex();
+
+            if (distance[adjacent] == INT_MAX) {
+                distance[adjacent] = distance[current] + 1;
+                parent[adjacent] = current;
+                parentWeight[adjacent] = it.weight();
+                queue[tail++] = adjacent;
+            }
+        }
+    }
+
+    delete[] queue;
+}
+
+void Algorithms::depthFirstSearch(const CompressedGraph& g, int source, DfsVisitor& visitor) {
+    if (source < 0 || source >= g.getNumVertices()) {
+        throw "Source vertex out of range";
+    }
+    dfsRun(g, source, false, visitor);
+}
+
+void Algorithms::depthFirstSearchAll(const CompressedGraph& g, DfsVisitor& visitor) {
+    dfsRun(g, 0, true, visitor);
+}
+
+// DFS engine on the compressed lists - a stack frame keeps the iterator of its
+// vertex, so every list is decoded exactly once
+void Algorithms::dfsRun(const CompressedGraph& g, int source, bool allComponents, DfsVisitor& visitor) {
+    int numVertices = g.getNumVertices();
+
+    char* color = new char[numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        color[i] = 0;
+    }
+
+    int* stackVertex = new int[numVertices];
+    CompressedGraph::NeighborIterator* stackEdge = new CompressedGraph::NeighborIterator[numVertices];
+    bool* parentSkipped = new bool[numVertices];
+    bool* skipLoop = new bool[numVertices];
+
+    for (int root = source; root < numVertices; root++) {
+        if (color[root] != 0) {
+            continue;
+        }
+
+        color[root] = 1;
+        visitor.discoverVertex(root);
+        stackVertex[0] = root;
+        stackEdge[0] = g.neighbors(root);
+        parentSkipped[0] = true;
+        skipLoop[0] = false;
+        int top = 1;
+
+        while (top > 0) {
+            int vertex = stackVertex[top - 1];
+            CompressedGraph::NeighborIterator& it = stackEdge[top - 1];
+
+            if (it.done()) {
+                color[vertex] = 2;
+                visitor.finishVertex(vertex);
+                top--;
+                continue;
+            }
+
+            int adjacent = it.vertex();
+            int weight = it.weight();
+            it.next();
+
+            if (color[adjacent] == 0) {
+                visitor.treeEdge(vertex, adjacent, weight);
+
+                color[adjacent] = 1;
+                visitor.discoverVertex(adjacent);
+                stackVertex[top] = adjacent;
+                stackEdge[top] = g.neighbors(adjacent);
+                parentSkipped[top] = false;
+                skipLoop[top] = false;
+                top++;
+            } else if (color[adjacent] == 1) {
+                if (adjacent == vertex) {
+                    // A self-loop is stored twice in its own list; report every other copy
+                    if (!skipLoop[top - 1]) {
+                        visitor.backEdge(vertex, adjacent, weight);
+                    }
+                    skipLoop[top - 1] = !skipLoop[top - 1];
+                } else if (!parentSkipped[top - 1] && adjacent == stackVertex[top - 2]) {
+                    parentSkipped[top - 1] = true;
+                } else {
+                    visitor.backEdge(vertex, adjacent, weight);
+                }
+            }
+        }
+
+        if (!allComponents) {
+            break;
+        }
+    }
+
+    delete[] parentSkipped;
+    delete[] skipLoop;
+    delete[] stackEdge;
+    delete[] stackVertex;
+    delete[] color;
+}
+
+} // namespace graph
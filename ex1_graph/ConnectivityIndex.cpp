@@ -0,0 +1,218 @@
+// connectivityindex.cpp
+#include "ConnectivityIndex.hpp"
+#include "Graph.hpp"
+
+namespace graph {
+
+ConnectivityIndex::ConnectivityIndex(const Graph& g)
+    : numVertices(g.getNumVertices()), numComponents(0), freeCount(0), epoch(0) {
+    label = new int[numVertices];
+    size = new int[numVertices];
+    head = new int[numVertices];
+    next = new int[numVertices];
+    prev = new int[numVertices];
+    freeIds = new int[numVertices];
+    marks = new unsigned int[numVertices];
+    queues = new int[2 * (long long)numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        marks[i] = 0;
+    }
+    reset();
+
+    // Every edge is in two lists; uniting from the smaller end covers it once
+    for (int u = 0; u < numVertices; u++) {
+        for (Graph::Edge* edge = g.getAdjList(u); edge; edge = edge->next) {
+            if (edge->destination > u) {
+                unite(u, edge->destination);
+            }
+        }
+    }
+}
+
+ConnectivityIndex::~ConnectivityIndex() {
+    delete[] label;
+    delete[] size;
+    delete[] head;
+    delete[] next;
+    delete[] prev;
+    delete[] freeIds;
+    delete[] marks;
+    delete[] queues;
+}
+
+void ConnectivityIndex::reset() {
+    for (int i = 0; i < numVertices; i++) {
+        label[i] = i;
+        size[i] = 1;
+        head[i] = i;
+        next[i] = i;
+        prev[i] = i;
+    }
+    numComponents = numVertices;
+    freeCount = 0;
+}
+
+// Relabel the smaller component and splice the two member lists
+void ConnectivityIndex::unite(int u, int v) {
+    int big = label[u];
+    int small = label[v];
+    if (big == small) {
+        return;
+    }
+    if (size[big] < size[small]) {
+        int temp = big;
+        big = small;
+        small = temp;
+    }
+
+    int first = head[small];
+    int x = first;
+    do {
+        label[x] = big;
+        x = next[x];
+    } while (x != first);
+
+    int a = head[big];
+    int afterA = next[a];
+    int afterFirst = next[first];
+    next[a] = afterFirst;
+    prev[afterFirst] = a;
+    next[first] = afterA;
+    prev[afterA] = first;
+
+    size[big] += size[small];
+    freeIds[freeCount++] = small;
+    numComponents--;
+}
+
+// Expand one vertex of a search. Returns true when it finds a vertex of the other
+// search, that is when both ends are still connected.
+static bool expand(const Graph& g, int vertex, unsigned int* marks, unsigned int own, unsigned int other,
+                   int* queue, int& tail) {
+    for (Graph::Edge* edge = g.getAdjList(vertex); edge; edge = edge->next) {
+        int adjacent = edge->destination;
+        if (marks[adjacent] == other) {
+            return true;
+        }
+        if (marks[adjacent] != own) {
+            marks[adjacent] = own;
+            queue[tail++] = adjacent;
+        }
+    }
+    return false;
+}
+
+void ConnectivityIndex::edgeRemoved(const Graph& g, int u, int v) {
+    if (u == v || g.hasEdge(u, v)) {
+        return;
+    }
+
+    // Two marks per removal; clear them only when the counter would wrap
+    if (epoch > 4294967292u) {
+        for (int i = 0; i < numVertices; i++) {
+            marks[i] = 0;
+        }
+        epoch = 0;
+    }
+    epoch += 2;
+    unsigned int sideU = epoch;
+    unsigned int sideV = epoch + 1;
+
+    int* queueU = queues;
+    int* queueV = queues + numVertices;
+    int headU = 0;
+    int tailU = 0;
+    int headV = 0;
+    int tailV = 0;
+    marks[u] = sideU;
+    queueU[tailU++] = u;
+    marks[v] = sideV;
+    queueV[tailV++] = v;
+
+    // Whichever search runs out first has found a whole component
+    while (true) {
+        if (headU == tailU) {
+            split(queueU, tailU);
+            return;
+        }
+        if (expand(g, queueU[headU++], marks, sideU, sideV, queueU, tailU)) {
+            return;
+        }
+        if (headV == tailV) {
+            split(queueV, tailV);
+            return;
+        }
+        if (expand(g, queueV[headV++], marks, sideV, sideU, queueV, tailV)) {
+            return;
+        }
+    }
+}
+
+void ConnectivityIndex::split(const int* vertices, int count) {
+    int old = label[vertices[0]];
+    int id = freeIds[--freeCount];
+
+    // Unlink the vertices from the old list and link them into a new one
+    for (int i = 0; i < count; i++) {
+        int x = vertices[i];
+        next[prev[x]] = next[x];
+        prev[next[x]] = prev[x];
+        if (head[old] == x) {
+            head[old] = next[x];
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        int x = vertices[i];
+        label[x] = id;
+        next[x] = vertices[i + 1 < count ? i + 1 : 0];
+        prev[x] = vertices[i > 0 ? i - 1 : count - 1];
+    }
+
+    head[id] = vertices[0];
+    size[id] = count;
+    size[old] -= count;
+    numComponents++;
+}
+
+void ConnectivityIndex::checkVertex(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+}
+
+int ConnectivityIndex::getNumVertices() const {
+    return numVertices;
+}
+
+int ConnectivityIndex::getNumComponents() const {
+    return numComponents;
+}
+
+bool ConnectivityIndex::connected(int u, int v) const {
+    checkVertex(u);
+    checkVertex(v);
+    return label[u] == label[v];
+}
+
+int ConnectivityIndex::componentOf(int vertex) const {
+    checkVertex(vertex);
+    return label[vertex];
+}
+
+int ConnectivityIndex::componentSize(int vertex) const {
+    checkVertex(vertex);
+    return size[label[vertex]];
+}
+
+int ConnectivityIndex::getComponent(int vertex, int* members) const {
+    checkVertex(vertex);
+    int count = 0;
+    int x = vertex;
+    do {
+        members[count++] = x;
+        x = next[x];
+    } while (x != vertex);
+    return count;
+}
+
+} // namespace graph
@@ -0,0 +1,76 @@
+// connectivityindex.hpp
+#ifndef CONNECTIVITYINDEX_HPP
+#define CONNECTIVITYINDEX_HPP
+
+namespace graph {
+
+class Graph;
+
+// Connected components of a Graph, kept up to date by the graph itself (see
+// Graph::trackConnectivity). Every vertex carries the id of its component, and the
+// members of each component form a circular list.
+//
+// Adding an edge between two components relabels the smaller one, so a vertex is
+// relabeled O(log V) times over any sequence of insertions. Removing the last edge
+// between two vertices searches from both ends at once, one vertex at a time; if
+// the searches do not meet, the side that ran out first has become a component of
+// its own and only that side is relabeled. Both the edge scans and the relabeling
+// are bounded by the smaller side, never by V or by the rest of the component.
+//
+// Queries are a lookup or two and never write, so any number of threads may query
+// while no thread changes the graph.
+class ConnectivityIndex {
+public:
+    ~ConnectivityIndex();
+
+    int getNumVertices() const;
+    int getNumComponents() const;
+
+    bool connected(int u, int v) const;
+
+    // An id in [0, getNumVertices()) shared by the vertices of one component. Ids of
+    // components that merge or split are reused.
+    int componentOf(int vertex) const;
+    int componentSize(int vertex) const;
+
+    // Write the vertices of the vertex's component into members, which needs
+    // componentSize(vertex) entries. Returns the number written.
+    int getComponent(int vertex, int* members) const;
+
+private:
+    friend class Graph;
+
+    int numVertices;
+    int numComponents;
+    int* label;           // Component id of every vertex
+    int* size;            // Size of every component id in use
+    int* head;            // A member of every component id in use
+    int* next;            // Circular, doubly linked member lists
+    int* prev;
+    int* freeIds;         // Component ids not in use
+    int freeCount;
+    unsigned int* marks;  // Search marks of the current removal, epoch and epoch + 1
+    unsigned int epoch;
+    int* queues;          // Both search queues, numVertices entries each
+
+    // Index over the current edges of g
+    explicit ConnectivityIndex(const Graph& g);
+
+    // Every vertex on its own
+    void reset();
+
+    void unite(int u, int v);
+    void edgeRemoved(const Graph& g, int u, int v);
+
+    // Move the given vertices out of their component into a new one
+    void split(const int* vertices, int count);
+    void checkVertex(int vertex) const;
+
+    // Indexes are never copied
+    ConnectivityIndex(const ConnectivityIndex&);
+    ConnectivityIndex& operator=(const ConnectivityIndex&);
+};
+
+} // namespace graph
+
+#endif // CONNECTIVITYINDEX_HPP
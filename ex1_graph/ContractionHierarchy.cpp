@@ -0,0 +1,856 @@
+// contractionhierarchy.cpp
+#include "ContractionHierarchy.hpp"
+#include <climits>
+#include <fstream>
+
+namespace graph {
+
+// Vertices a witness search may settle before giving up. A search that gives up
+// only costs an unnecessary shortcut, never a wrong distance. Estimating the
+// priority of a vertex uses a smaller limit than the real contraction.
+const int WITNESS_SETTLE_LIMIT = 500;
+const int PRIORITY_SETTLE_LIMIT = 20;
+
+// File header: magic bytes followed by a format version
+const char CH_MAGIC[4] = { 'G', 'C', 'H', 'F' };
+const int CH_VERSION = 1;
+
+namespace {
+
+// Arc of the graph that is still being contracted
+struct Arc {
+    int target;
+    int weight;
+    int middle;
+};
+
+// Growable list of arcs
+class ArcList {
+public:
+    Arc* arcs;
+    int size;
+    int capacity;
+
+    ArcList() : arcs(nullptr), size(0), capacity(0) {}
+
+    ~ArcList() {
+        delete[] arcs;
+    }
+
+    void add(int target, int weight, int middle) {
+        if (size == capacity) {
+            capacity = capacity > 0 ? capacity * 2 : 4;
+            Arc* bigger = new Arc[capacity];
+            for (int i = 0; i < size; i++) {
+                bigger[i] = arcs[i];
+            }
+            delete[] arcs;
+            arcs = bigger;
+        }
+        arcs[size].target = target;
+        arcs[size].weight = weight;
+        arcs[size].middle = middle;
+        size++;
+    }
+
+    // Index of the arc to target, or -1
+    int find(int target) const {
+        for (int i = 0; i < size; i++) {
+            if (arcs[i].target == target) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void removeAt(int index) {
+        arcs[index] = arcs[--size];
+    }
+
+    void release() {
+        delete[] arcs;
+        arcs = nullptr;
+        size = 0;
+        capacity = 0;
+    }
+
+private:
+    ArcList(const ArcList&);
+    ArcList& operator=(const ArcList&);
+};
+
+// Preprocessing state: the graph of the vertices not contracted yet
+class Contractor {
+public:
+    explicit Contractor(const Graph& g);
+    ~Contractor();
+
+    // Contract every vertex, filling in its rank and its upward arcs
+    void run(int* rank, ArcList* upward);
+
+private:
+    int numVertices;
+    ArcList* remaining;      // Arcs between vertices that are not contracted yet
+    bool* contracted;
+    int* deletedNeighbors;   // Number of neighbors already contracted
+
+    // Witness search workspace
+    int* witnessDistance;
+    int* witnessTouched;
+    int witnessCount;
+    int* targetStamp;        // targetStamp[w] == currentStamp marks the vertices still looked for
+    int currentStamp;
+    BinaryHeapQueue witnessQueue;
+
+    void witnessSearch(int source, int skip, int limit, int maxSettled, int numTargets);
+    int processShortcuts(int v, bool add, int maxSettled);
+    void addShortcut(int u, int w, int weight, int middle);
+    int priority(int v);
+    void contract(int v, ArcList& upward);
+
+    Contractor(const Contractor&);
+    Contractor& operator=(const Contractor&);
+};
+
+Contractor::Contractor(const Graph& g) : numVertices(g.getNumVertices()), witnessCount(0), currentStamp(0), witnessQueue(64) {
+    // Validate before allocating anything
+    for (int u = 0; u < numVertices; u++) {
+        for (Graph::Edge* edge = g.getAdjList(u); edge != nullptr; edge = edge->next) {
+            if (edge->weight < 0) {
+                throw "Contraction hierarchies need non-negative weights";
+            }
+        }
+    }
+
+    remaining = new ArcList[numVertices];
+    contracted = new bool[numVertices];
+    deletedNeighbors = new int[numVertices];
+    witnessDistance = new int[numVertices];
+    witnessTouched = new int[numVertices];
+    targetStamp = new int[numVertices];
+
+    // lastSource[v] == u means position[v] holds the arc u -> v
+    int* lastSource = new int[numVertices];
+    int* position = new int[numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        contracted[i] = false;
+        deletedNeighbors[i] = 0;
+        witnessDistance[i] = INT_MAX;
+        targetStamp[i] = 0;
+        lastSource[i] = -1;
+    }
+
+    // Copy the graph without self-loops, keeping only the lightest parallel edge
+    for (int u = 0; u < numVertices; u++) {
+        for (Graph::Edge* edge = g.getAdjList(u); edge != nullptr; edge = edge->next) {
+            int v = edge->destination;
+            if (v == u) {
+                continue;
+            }
+            if (lastSource[v] != u) {
+                lastSource[v] = u;
+                position[v] = remaining[u].size;
+                remaining[u].add(v, edge->weight, -1);
+            } else if (edge->weight < remaining[u].arcs[position[v]].weight) {
+                remaining[u].arcs[position[v]].weight = edge->weight;
+            }
+        }
+    }
+
+    delete[] lastSource;
+    delete[] position;
+}
+
+Contractor::~Contractor() {
+    delete[] remaining;
+    delete[] contracted;
+    delete[] deletedNeighbors;
+    delete[] witnessDistance;
+    delete[] witnessTouched;
+    delete[] targetStamp;
+}
+
+// Dijkstra from source that avoids skip. Stops beyond limit, after maxSettled
+// vertices, or once all numTargets stamped targets are settled.
+void Contractor::witnessSearch(int source, int skip, int limit, int maxSettled, int numTargets) {
+    for (int i = 0; i < witnessCount; i++) {
+        witnessDistance[witnessTouched[i]] = INT_MAX;
+    }
+    witnessCount = 0;
+    witnessQueue.clear();
+
+    witnessDistance[source] = 0;
+    witnessTouched[witnessCount++] = source;
+    witnessQueue.push(source, 0);
+
+    int settled = 0;
+    while (!witnessQueue.isEmpty()) {
+        int u;
+        int d;
+        witnessQueue.popMin(u, d);
+
+        if (d > witnessDistance[u]) {
+            continue;
+        }
+        if (d > limit || ++settled > maxSettled) {
+            break;
+        }
+        if (targetStamp[u] == currentStamp) {
+            targetStamp[u] = 0;
+            if (--numTargets == 0) {
+                break;
+            }
+        }
+
+        for (int i = 0; i < remaining[u].size; i++) {
+            int w = remaining[u].arcs[i].target;
+            if (w == skip) {
+                continue;
+            }
+            int candidate = d + remaining[u].arcs[i].weight;
+            if (candidate < witnessDistance[w]) {
+                if (witnessDistance[w] == INT_MAX) {
+                    witnessTouched[witnessCount++] = w;
+                }
+                witnessDistance[w] = candidate;
+                witnessQueue.push(w, candidate);
+            }
+        }
+    }
+}
+
+// Count (and optionally add) the shortcuts that contracting v needs
+int Contractor::processShortcuts(int v, bool add, int maxSettled) {
+    ArcList& arcs = remaining[v];
+    int shortcuts = 0;
+
+    for (int i = 0; i + 1 < arcs.size; i++) {
+        int u = arcs.arcs[i].target;
+
+        int limit = 0;
+        currentStamp++;
+        for (int j = i + 1; j < arcs.size; j++) {
+            int via = arcs.arcs[i].weight + arcs.arcs[j].weight;
+            if (via > limit) {
+                limit = via;
+            }
+            targetStamp[arcs.arcs[j].target] = currentStamp;
+        }
+
+        witnessSearch(u, v, limit, maxSettled, arcs.size - i - 1);
+
+        for (int j = i + 1; j < arcs.size; j++) {
+            int w = arcs.arcs[j].target;
+            int via = arcs.arcs[i].weight + arcs.arcs[j].weight;
+            if (witnessDistance[w] > via) {
+                shortcuts++;
+                if (add) {
+                    addShortcut(u, w, via, v);
+                }
+            }
+        }
+    }
+
+    return shortcuts;
+}
+
+// Insert the shortcut u - w, or lower an existing arc between them
+void Contractor::addShortcut(int u, int w, int weight, int middle) {
+    int i = remaining[u].find(w);
+    if (i == -1) {
+        remaining[u].add(w, weight, middle);
+        remaining[w].add(u, weight, middle);
+        return;
+    }
+    if (weight < remaining[u].arcs[i].weight) {
+        int j = remaining[w].find(u);
+        remaining[u].arcs[i].weight = weight;
+        remaining[u].arcs[i].middle = middle;
+        remaining[w].arcs[j].weight = weight;
+        remaining[w].arcs[j].middle = middle;
+    }
+}
+
+// Edge difference plus the number of contracted neighbors (spreads contraction evenly)
+int Contractor::priority(int v) {
+    return processShortcuts(v, false, PRIORITY_SETTLE_LIMIT) - remaining[v].size + deletedNeighbors[v];
+}
+
+void Contractor::contract(int v, ArcList& upward) {
+    processShortcuts(v, true, WITNESS_SETTLE_LIMIT);
+
+    // Every arc left at v leads to a vertex contracted later
+    for (int i = 0; i < remaining[v].size; i++) {
+        const Arc& arc = remaining[v].arcs[i];
+        upward.add(arc.target, arc.weight, arc.middle);
+
+        ArcList& back = remaining[arc.target];
+        back.removeAt(back.find(v));
+        deletedNeighbors[arc.target]++;
+    }
+
+    contracted[v] = true;
+    remaining[v].release();
+}
+
+void Contractor::run(int* rank, ArcList* upward) {
+    // Lazy updates: an entry is only trusted if its key still matches, and the
+    // priority is recomputed once more when the vertex reaches the top
+    int* currentPriority = new int[numVertices];
+    BinaryHeapQueue order(numVertices);
+
+    for (int v = 0; v < numVertices; v++) {
+        currentPriority[v] = priority(v);
+        order.push(v, currentPriority[v]);
+    }
+
+    int next = 0;
+    while (!order.isEmpty()) {
+        int v;
+        int key;
+        order.popMin(v, key);
+
+        if (contracted[v] || key != currentPriority[v]) {
+            continue;
+        }
+
+        int p = priority(v);
+        if (p > key) {
+            currentPriority[v] = p;
+            order.push(v, p);
+            continue;
+        }
+
+        contract(v, upward[v]);
+        rank[v] = next++;
+
+        // The neighbors lost an arc and may have gained shortcuts
+        for (int i = 0; i < upward[v].size; i++) {
+            int u = upward[v].arcs[i].target;
+            p = priority(u);
+            if (p != currentPriority[u]) {
+                currentPriority[u] = p;
+                order.push(u, p);
+            }
+        }
+    }
+
+    delete[] currentPriority;
+}
+
+} // namespace
+
+ContractionHierarchy::ContractionHierarchy()
+    : numVertices(0), numArcs(0), numShortcuts(0), rank(nullptr),
+      offsets(nullptr), targets(nullptr), weights(nullptr), middles(nullptr), unpackStack(nullptr) {
+    for (int side = 0; side < 2; side++) {
+        queryDistance[side] = nullptr;
+        queryParent[side] = nullptr;
+        touched[side] = nullptr;
+        touchedCount[side] = 0;
+        queue[side] = nullptr;
+    }
+}
+
+ContractionHierarchy::ContractionHierarchy(const Graph& g) : ContractionHierarchy() {
+    Contractor contractor(g);
+
+    numVertices = g.getNumVertices();
+    rank = new int[numVertices];
+    ArcList* upward = new ArcList[numVertices];
+    contractor.run(rank, upward);
+
+    // Flatten the upward arcs into CSR arrays
+    offsets = new int[numVertices + 1];
+    offsets[0] = 0;
+    for (int v = 0; v < numVertices; v++) {
+        offsets[v + 1] = offsets[v] + upward[v].size;
+    }
+    numArcs = offsets[numVertices];
+
+    targets = new int[numArcs > 0 ? numArcs : 1];
+    weights = new int[numArcs > 0 ? numArcs : 1];
+    middles = new int[numArcs > 0 ? numArcs : 1];
+    for (int v = 0; v < numVertices; v++) {
+        for (int i = 0; i < upward[v].size; i++) {
+            targets[offsets[v] + i] = upward[v].arcs[i].target;
+            weights[offsets[v] + i] = upward[v].arcs[i].weight;
+            middles[offsets[v] + i] = upward[v].arcs[i].middle;
+            if (upward[v].arcs[i].middle != -1) {
+                numShortcuts++;
+            }
+        }
+    }
+    delete[] upward;
+
+    allocateWorkspace();
+}
+
+ContractionHierarchy::~ContractionHierarchy() {
+    release();
+}
+
+// Move constructor
+ContractionHierarchy::ContractionHierarchy(ContractionHierarchy&& other) noexcept {
+    takeFrom(other);
+}
+
+// Move assignment operator
+ContractionHierarchy& ContractionHierarchy::operator=(ContractionHierarchy&& other) noexcept {
+    if (this != &other) {
+        release();
+        takeFrom(other);
+    }
+    return *this;
+}
+
+void ContractionHierarchy::allocateWorkspace() {
+    for (int side = 0; side < 2; side++) {
+        queryDistance[side] = new int[numVertices];
+        queryParent[side] = new int[numVertices];
+        touched[side] = new int[numVertices];
+        touchedCount[side] = 0;
+        queue[side] = new BinaryHeapQueue(64);
+        for (int i = 0; i < numVertices; i++) {
+            queryDistance[side][i] = INT_MAX;
+        }
+    }
+    // Pending (from, to) pairs while unpacking; nesting depth is bounded by the ranks
+    unpackStack = new int[2 * numVertices + 2];
+}
+
+void ContractionHierarchy::release() {
+    delete[] rank;
+    delete[] offsets;
+    delete[] targets;
+    delete[] weights;
+    delete[] middles;
+    for (int side = 0; side < 2; side++) {
+        delete[] queryDistance[side];
+        delete[] queryParent[side];
+        delete[] touched[side];
+        delete queue[side];
+    }
+    delete[] unpackStack;
+}
+
+// Take over the arrays of another hierarchy, leaving it empty
+void ContractionHierarchy::takeFrom(ContractionHierarchy& other) {
+    numVertices = other.numVertices;
+    numArcs = other.numArcs;
+    numShortcuts = other.numShortcuts;
+    rank = other.rank;
+    offsets = other.offsets;
+    targets = other.targets;
+    weights = other.weights;
+    middles = other.middles;
+    unpackStack = other.unpackStack;
+
+    other.numVertices = 0;
+    other.numArcs = 0;
+    other.numShortcuts = 0;
+    other.rank = nullptr;
+    other.offsets = nullptr;
+    other.targets = nullptr;
+    other.weights = nullptr;
+    other.middles = nullptr;
+    other.unpackStack = nullptr;
+
+    for (int side = 0; side < 2; side++) {
+        queryDistance[side] = other.queryDistance[side];
+        queryParent[side] = other.queryParent[side];
+        touched[side] = other.touched[side];
+        touchedCount[side] = other.touchedCount[side];
+        queue[side] = other.queue[side];
+
+        other.queryDistance[side] = nullptr;
+        other.queryParent[side] = nullptr;
+        other.touched[side] = nullptr;
+        other.touchedCount[side] = 0;
+        other.queue[side] = nullptr;
+    }
+}
+
+// Undo the previous query, touching only the vertices it reached
+void ContractionHierarchy::resetWorkspace() {
+    for (int side = 0; side < 2; side++) {
+        for (int i = 0; i < touchedCount[side]; i++) {
+            queryDistance[side][touched[side][i]] = INT_MAX;
+        }
+        touchedCount[side] = 0;
+        queue[side]->clear();
+    }
+}
+
+// Bidirectional upward search. Returns the vertex where the shortest path peaks
+// (or -1) and its length in best. The workspace keeps both search trees until
+// the next query.
+int ContractionHierarchy::search(int source, int target, int& best) {
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    if (target < 0 || target >= numVertices) {
+        throw "Target vertex out of range";
+    }
+
+    resetWorkspace();
+
+    int start[2] = { source, target };
+    for (int side = 0; side < 2; side++) {
+        queryDistance[side][start[side]] = 0;
+        queryParent[side][start[side]] = -1;
+        touched[side][touchedCount[side]++] = start[side];
+        queue[side]->push(start[side], 0);
+    }
+
+    best = INT_MAX;
+    int meeting = -1;
+    bool active[2] = { true, true };
+    int side = 0;
+
+    // Alternate between the two searches; a side stops once its smallest key
+    // cannot improve the best path any more
+    while (active[0] || active[1]) {
+        if (!active[side]) {
+            side = 1 - side;
+        }
+        if (queue[side]->isEmpty()) {
+            active[side] = false;
+            continue;
+        }
+
+        int u;
+        int d;
+        queue[side]->popMin(u, d);
+
+        if (d >= best) {
+            active[side] = false;
+            continue;
+        }
+        if (d > queryDistance[side][u]) {
+            continue; // Stale entry
+        }
+
+        int other = 1 - side;
+        if (queryDistance[other][u] != INT_MAX && d + queryDistance[other][u] < best) {
+            best = d + queryDistance[other][u];
+            meeting = u;
+        }
+
+        // Stall-on-demand: a higher neighbor that reaches u more cheaply proves that
+        // d is not the real distance, so nothing found beyond u can be shortest
+        bool stalled = false;
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int w = queryDistance[side][targets[i]];
+            if (w != INT_MAX && w + weights[i] < d) {
+                stalled = true;
+                break;
+            }
+        }
+        if (stalled) {
+            side = other;
+            continue;
+        }
+
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int v = targets[i];
+            int candidate = d + weights[i];
+            if (candidate < queryDistance[side][v]) {
+                if (queryDistance[side][v] == INT_MAX) {
+                    touched[side][touchedCount[side]++] = v;
+                }
+                queryDistance[side][v] = candidate;
+                queryParent[side][v] = u;
+                queue[side]->push(v, candidate);
+            }
+        }
+
+        side = other;
+    }
+
+    return meeting;
+}
+
+int ContractionHierarchy::distance(int source, int target) {
+    int best;
+    search(source, target, best);
+    return best;
+}
+
+// Expand the arc from -> to into original edges. Writes the vertices after from
+// to out (if given) and returns how many there are.
+int ContractionHierarchy::unpack(int from, int to, int* out) {
+    int count = 0;
+    int top = 0;
+    unpackStack[top++] = from;
+    unpackStack[top++] = to;
+
+    while (top > 0) {
+        int y = unpackStack[--top];
+        int x = unpackStack[--top];
+
+        // The arc is stored at the endpoint that was contracted first
+        int low = rank[x] < rank[y] ? x : y;
+        int high = low == x ? y : x;
+        int arc = -1;
+        for (int i = offsets[low]; i < offsets[low + 1]; i++) {
+            if (targets[i] == high) {
+                arc = i;
+                break;
+            }
+        }
+        if (arc == -1) {
+            throw "Invalid contraction hierarchy";
+        }
+
+        int m = middles[arc];
+        if (m == -1) {
+            if (out) {
+                out[count] = y;
+            }
+            count++;
+        } else {
+            // Expand x -> m first, so it is pushed last
+            unpackStack[top++] = m;
+            unpackStack[top++] = y;
+            unpackStack[top++] = x;
+            unpackStack[top++] = m;
+        }
+    }
+
+    return count;
+}
+
+Path ContractionHierarchy::shortestPath(int source, int target) {
+    int best;
+    int meeting = search(source, target, best);
+    if (meeting == -1) {
+        return Path();
+    }
+
+    // Hierarchy path: source .. meeting from the forward tree, then meeting .. target
+    int forwardLength = 0;
+    for (int v = meeting; v != -1; v = queryParent[0][v]) {
+        forwardLength++;
+    }
+    int chainLength = forwardLength;
+    for (int v = queryParent[1][meeting]; v != -1; v = queryParent[1][v]) {
+        chainLength++;
+    }
+
+    int* chain = new int[chainLength];
+    int k = forwardLength - 1;
+    for (int v = meeting; v != -1; v = queryParent[0][v]) {
+        chain[k--] = v;
+    }
+    k = forwardLength;
+    for (int v = queryParent[1][meeting]; v != -1; v = queryParent[1][v]) {
+        chain[k++] = v;
+    }
+
+    // Count the expanded vertices first, then write them
+    int length = 1;
+    try {
+        for (int i = 0; i + 1 < chainLength; i++) {
+            length += unpack(chain[i], chain[i + 1], nullptr);
+        }
+    } catch (...) {
+        delete[] chain;
+        throw;
+    }
+
+    int* vertices = new int[length];
+    vertices[0] = source;
+    int pos = 1;
+    for (int i = 0; i + 1 < chainLength; i++) {
+        pos += unpack(chain[i], chain[i + 1], vertices + pos); // Cannot fail after the counting pass
+    }
+
+    Path result(vertices, length, best);
+    delete[] vertices;
+    delete[] chain;
+    return result;
+}
+
+// Binary layout (native int size and byte order):
+//   magic "GCHF", version, numVertices, numArcs, numShortcuts,
+//   rank[numVertices], offsets[numVertices + 1],
+//   targets[numArcs], weights[numArcs], middles[numArcs]
+void ContractionHierarchy::save(const char* filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        throw "Cannot open file for writing";
+    }
+
+    int header[4] = { CH_VERSION, numVertices, numArcs, numShortcuts };
+    file.write(CH_MAGIC, sizeof(CH_MAGIC));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(rank), sizeof(int) * numVertices);
+    file.write(reinterpret_cast<const char*>(offsets), sizeof(int) * (numVertices + 1));
+    file.write(reinterpret_cast<const char*>(targets), sizeof(int) * numArcs);
+    file.write(reinterpret_cast<const char*>(weights), sizeof(int) * numArcs);
+    file.write(reinterpret_cast<const char*>(middles), sizeof(int) * numArcs);
+
+    if (!file) {
+        throw "Cannot write file";
+    }
+}
+
+ContractionHierarchy ContractionHierarchy::load(const char* filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw "Cannot open file for reading";
+    }
+
+    char magic[4];
+    int header[4];
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!file || magic[0] != CH_MAGIC[0] || magic[1] != CH_MAGIC[1] ||
+        magic[2] != CH_MAGIC[2] || magic[3] != CH_MAGIC[3]) {
+        throw "Invalid contraction hierarchy file";
+    }
+    if (header[0] != CH_VERSION) {
+        throw "Unsupported contraction hierarchy version";
+    }
+    if (header[1] < 0 || header[2] < 0 || header[3] < 0 || header[3] > header[2]) {
+        throw "Invalid contraction hierarchy file";
+    }
+
+    // The arrays must fill the rest of the file exactly, so that a damaged header
+    // cannot make us allocate more than the file holds
+    long long expectedBytes = (long long)sizeof(CH_MAGIC) + sizeof(header) +
+                              (long long)sizeof(int) * (2LL * header[1] + 1 + 3LL * header[2]);
+    std::streampos dataStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    long long fileBytes = (long long)file.tellg();
+    file.seekg(dataStart);
+    if (!file || fileBytes != expectedBytes) {
+        throw "Invalid contraction hierarchy file";
+    }
+
+    ContractionHierarchy ch;
+    ch.numVertices = header[1];
+    ch.numArcs = header[2];
+    ch.numShortcuts = header[3];
+
+    int n = ch.numVertices;
+    int arcs = ch.numArcs;
+    ch.rank = new int[n > 0 ? n : 1];
+    ch.offsets = new int[n + 1];
+    ch.targets = new int[arcs > 0 ? arcs : 1];
+    ch.weights = new int[arcs > 0 ? arcs : 1];
+    ch.middles = new int[arcs > 0 ? arcs : 1];
+
+    file.read(reinterpret_cast<char*>(ch.rank), sizeof(int) * n);
+    file.read(reinterpret_cast<char*>(ch.offsets), sizeof(int) * (n + 1));
+    file.read(reinterpret_cast<char*>(ch.targets), sizeof(int) * arcs);
+    file.read(reinterpret_cast<char*>(ch.weights), sizeof(int) * arcs);
+    file.read(reinterpret_cast<char*>(ch.middles), sizeof(int) * arcs);
+    if (!file) {
+        throw "Invalid contraction hierarchy file";
+    }
+
+    // Check the structure so that queries cannot run outside the arrays
+    if (ch.offsets[0] != 0 || ch.offsets[n] != arcs) {
+        throw "Invalid contraction hierarchy file";
+    }
+    for (int v = 0; v < n; v++) {
+        if (ch.rank[v] < 0 || ch.rank[v] >= n || ch.offsets[v + 1] < ch.offsets[v]) {
+            throw "Invalid contraction hierarchy file";
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        for (int i = ch.offsets[v]; i < ch.offsets[v + 1]; i++) {
+            int t = ch.targets[i];
+            int m = ch.middles[i];
+            if (t < 0 || t >= n || ch.rank[t] <= ch.rank[v] || ch.weights[i] < 0 ||
+                m < -1 || m >= n || (m != -1 && ch.rank[m] >= ch.rank[v])) {
+                throw "Invalid contraction hierarchy file";
+            }
+        }
+    }
+    if (!ch.shortcutsResolve()) {
+        throw "Invalid contraction hierarchy file";
+    }
+
+    ch.allocateWorkspace();
+    return ch;
+}
+
+// Every shortcut v -> t through m needs the arcs m -> v and m -> t, both stored at
+// m since m was contracted first; otherwise unpacking it fails. Shortcuts are
+// grouped by their middle vertex, so that each middle's arcs are marked once.
+bool ContractionHierarchy::shortcutsResolve() const {
+    int n = numVertices;
+    int* groupStart = new int[n + 1];
+    int* grouped = new int[numShortcuts > 0 ? numShortcuts : 1];
+    int* owner = new int[numArcs > 0 ? numArcs : 1];
+    int* mark = new int[n > 0 ? n : 1];
+
+    for (int v = 0; v <= n; v++) {
+        groupStart[v] = 0;
+    }
+    int shortcuts = 0;
+    for (int v = 0; v < n; v++) {
+        mark[v] = -1;
+        for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+            owner[i] = v;
+            if (middles[i] != -1) {
+                groupStart[middles[i] + 1]++;
+                shortcuts++;
+            }
+        }
+    }
+
+    bool valid = shortcuts == numShortcuts;
+    if (valid) {
+        for (int m = 0; m < n; m++) {
+            groupStart[m + 1] += groupStart[m];
+        }
+        for (int i = 0; i < numArcs; i++) {
+            if (middles[i] != -1) {
+                grouped[groupStart[middles[i]]++] = i;
+            }
+        }
+        // The fill moved every start to the next group's; walk the groups back from 0
+        int begin = 0;
+        for (int m = 0; m < n && valid; m++) {
+            for (int i = offsets[m]; i < offsets[m + 1]; i++) {
+                mark[targets[i]] = m;
+            }
+            for (int k = begin; k < groupStart[m] && valid; k++) {
+                int arc = grouped[k];
+                valid = mark[owner[arc]] == m && mark[targets[arc]] == m;
+            }
+            begin = groupStart[m];
+        }
+    }
+
+    delete[] groupStart;
+    delete[] grouped;
+    delete[] owner;
+    delete[] mark;
+    return valid;
+}
+
+int ContractionHierarchy::getNumVertices() const {
+    return numVertices;
+}
+
+int ContractionHierarchy::getNumArcs() const {
+    return numArcs;
+}
+
+int ContractionHierarchy::getNumShortcuts() const {
+    return numShortcuts;
+}
+
+int ContractionHierarchy::getRank(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+    return rank[vertex];
+}
+
+} // namespace graph
@@ -0,0 +1,84 @@
+// contractionhierarchy.hpp
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include "Graph.hpp"
+#include "Path.hpp"
+#include "PriorityQueues.hpp"
+
+namespace graph {
+
+// Contraction hierarchy for fast repeated shortest-path queries on a graph that
+// rarely changes.
+// Preprocessing contracts the vertices one by one (cheapest edge difference first)
+// and adds a shortcut between two neighbors whenever the path through the
+// contracted vertex is the only shortest one. Every vertex keeps its arcs to
+// neighbors contracted later ("upward" arcs); since the graph is undirected the
+// same upward graph serves the forward and the backward search of a query.
+// Queries reuse a workspace inside the object, so one hierarchy answers one query
+// at a time.
+class ContractionHierarchy {
+public:
+    // Preprocess a graph. Weights must be non-negative.
+    explicit ContractionHierarchy(const Graph& g);
+    ~ContractionHierarchy();
+
+    // Move constructor and move assignment - the moved-from hierarchy is left empty
+    ContractionHierarchy(ContractionHierarchy&& other) noexcept;
+    ContractionHierarchy& operator=(ContractionHierarchy&& other) noexcept;
+
+    // Length of the shortest path, or INT_MAX if target is unreachable
+    int distance(int source, int target);
+
+    // Shortest path with all shortcuts expanded back into original edges
+    Path shortestPath(int source, int target);
+
+    // Store the preprocessed hierarchy in a binary file, or load one written by save
+    void save(const char* filename) const;
+    static ContractionHierarchy load(const char* filename);
+
+    // Accessor methods
+    int getNumVertices() const;
+    int getNumArcs() const;       // Upward arcs, including shortcuts
+    int getNumShortcuts() const;
+    int getRank(int vertex) const; // Position of the vertex in the contraction order
+
+private:
+    int numVertices;
+    int numArcs;
+    int numShortcuts;
+    int* rank;
+
+    // Upward arcs in CSR form. middle is the contracted vertex a shortcut
+    // bypasses, or -1 for an original edge.
+    int* offsets;
+    int* targets;
+    int* weights;
+    int* middles;
+
+    // Query workspace. Distances are INT_MAX between queries; only the vertices
+    // listed in touched are reset afterwards.
+    int* queryDistance[2];
+    int* queryParent[2];
+    int* touched[2];
+    int touchedCount[2];
+    BinaryHeapQueue* queue[2];
+    int* unpackStack;
+
+    ContractionHierarchy();
+    void allocateWorkspace();
+    void release();
+    void takeFrom(ContractionHierarchy& other);
+    int search(int source, int target, int& best);
+    void resetWorkspace();
+    int unpack(int from, int to, int* out);
+    bool shortcutsResolve() const;
+
+    // Hierarchies are large and never copied
+    ContractionHierarchy(const ContractionHierarchy&);
+    ContractionHierarchy& operator=(const ContractionHierarchy&);
+};
+
+} // namespace graph
+
+#endif // CONTRACTIONHIERARCHY_HPP
@@ -0,0 +1,405 @@
+// densegraph.cpp
+#include "DenseGraph.hpp"
+
+// The AVX2 kernels are compiled for AVX2 through function attributes, so the rest
+// of the program keeps the default instruction set and runs on any x86-64
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DENSEGRAPH_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace graph {
+
+// Scalar kernels on 64-bit words
+
+static void andScalar(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                      int words) {
+    for (int i = 0; i < words; i++) {
+        out[i] = a[i] & b[i];
+    }
+}
+
+static void orScalar(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                     int words) {
+    for (int i = 0; i < words; i++) {
+        out[i] = a[i] | b[i];
+    }
+}
+
+static void andNotScalar(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                         int words) {
+    for (int i = 0; i < words; i++) {
+        out[i] = a[i] & ~b[i];
+    }
+}
+
+static long long popcountScalar(const unsigned long long* a, int words) {
+    long long count = 0;
+    for (int i = 0; i < words; i++) {
+        count += __builtin_popcountll(a[i]);
+    }
+    return count;
+}
+
+static long long popcountAndScalar(const unsigned long long* a, const unsigned long long* b, int words) {
+    long long count = 0;
+    for (int i = 0; i < words; i++) {
+        count += __builtin_popcountll(a[i] & b[i]);
+    }
+    return count;
+}
+
+#ifdef DENSEGRAPH_AVX2
+
+// AVX2 kernels - four words per instruction, the remaining words done by the
+// scalar kernels. AVX2 has no popcount instruction: each byte is counted with two
+// 16-entry table lookups (one per nibble) and the byte counts are summed into the
+// four 64-bit lanes with a sum of absolute differences against zero.
+
+__attribute__((target("avx2")))
+static void andAvx2(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                    int words) {
+    int i = 0;
+    for (; i + 4 <= words; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_and_si256(x, y));
+    }
+    andScalar(a + i, b + i, out + i, words - i);
+}
+
+__attribute__((target("avx2")))
+static void orAvx2(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                   int words) {
+    int i = 0;
+    for (; i + 4 <= words; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_or_si256(x, y));
+    }
+    orScalar(a + i, b + i, out + i, words - i);
+}
+
+__attribute__((target("avx2")))
+static void andNotAvx2(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                       int words) {
+    int i = 0;
+    for (; i + 4 <= words; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(out + i), _mm256_andnot_si256(y, x));
+    }
+    andNotScalar(a + i, b + i, out + i, words - i);
+}
+
+// Bits set in each byte
+__attribute__((target("avx2")))
+static __m256i byteCounts(__m256i v) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowNibble = _mm256_set1_epi8(0x0f);
+    __m256i low = _mm256_and_si256(v, lowNibble);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibble);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(table, low), _mm256_shuffle_epi8(table, high));
+}
+
+__attribute__((target("avx2")))
+static long long laneSum(__m256i sums) {
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, sums);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+__attribute__((target("avx2")))
+static long long popcountAvx2(const unsigned long long* a, int words) {
+    __m256i sums = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= words; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(byteCounts(x), _mm256_setzero_si256()));
+    }
+    return laneSum(sums) + popcountScalar(a + i, words - i);
+}
+
+__attribute__((target("avx2")))
+static long long popcountAndAvx2(const unsigned long long* a, const unsigned long long* b, int words) {
+    __m256i sums = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= words; i += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(byteCounts(_mm256_and_si256(x, y)), _mm256_setzero_si256()));
+    }
+    return laneSum(sums) + popcountAndScalar(a + i, b + i, words - i);
+}
+
+#endif // DENSEGRAPH_AVX2
+
+bool DenseGraph::hasAvx2() {
+#ifdef DENSEGRAPH_AVX2
+    __builtin_cpu_init(); // May run from a static initializer, before libgcc's own
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Decided once at startup; setAvx2Enabled can only turn the AVX2 path off and back on
+static bool useAvx2 = DenseGraph::hasAvx2();
+
+void DenseGraph::setAvx2Enabled(bool enable) {
+    useAvx2 = enable && hasAvx2();
+}
+
+bool DenseGraph::isAvx2Enabled() {
+    return useAvx2;
+}
+
+void DenseGraph::andWords(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                          int words) {
+#ifdef DENSEGRAPH_AVX2
+    if (useAvx2) {
+        andAvx2(a, b, out, words);
+        return;
+    }
+#endif
+    andScalar(a, b, out, words);
+}
+
+void DenseGraph::orWords(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                         int words) {
+#ifdef DENSEGRAPH_AVX2
+    if (useAvx2) {
+        orAvx2(a, b, out, words);
+        return;
+    }
+#endif
+    orScalar(a, b, out, words);
+}
+
+void DenseGraph::andNotWords(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                             int words) {
+#ifdef DENSEGRAPH_AVX2
+    if (useAvx2) {
+        andNotAvx2(a, b, out, words);
+        return;
+    }
+#endif
+    andNotScalar(a, b, out, words);
+}
+
+long long DenseGraph::popcountWords(const unsigned long long* a, int words) {
+#ifdef DENSEGRAPH_AVX2
+    if (useAvx2) {
+        return popcountAvx2(a, words);
+    }
+#endif
+    return popcountScalar(a, words);
+}
+
+long long DenseGraph::popcountAndWords(const unsigned long long* a, const unsigned long long* b, int words) {
+#ifdef DENSEGRAPH_AVX2
+    if (useAvx2) {
+        return popcountAndAvx2(a, b, words);
+    }
+#endif
+    return popcountAndScalar(a, b, words);
+}
+
+DenseGraph::DenseGraph(int vertices) : numVertices(0), rowWords(0), numEdges(0), bits(nullptr) {
+    if (vertices <= 0) {
+        throw "Number of vertices must be positive";
+    }
+
+    numVertices = vertices;
+    rowWords = ((vertices + 63) / 64 + 3) / 4 * 4;
+    long long size = (long long)numVertices * rowWords;
+    bits = new unsigned long long[size];
+    for (long long i = 0; i < size; i++) {
+        bits[i] = 0;
+    }
+}
+
+DenseGraph::DenseGraph(const Graph& g) : DenseGraph(g.getNumVertices()) {
+    for (int u = 0; u < numVertices; u++) {
+        for (Graph::Edge* edge = g.getAdjList(u); edge != nullptr; edge = edge->next) {
+            if (u <= edge->destination) {
+                addEdge(u, edge->destination);
+            }
+        }
+    }
+}
+
+DenseGraph::~DenseGraph() {
+    delete[] bits;
+}
+
+void DenseGraph::copyFrom(const DenseGraph& other) {
+    numVertices = other.numVertices;
+    rowWords = other.rowWords;
+    numEdges = other.numEdges;
+    bits = nullptr;
+    if (!other.bits) { // A moved-from graph has no matrix
+        return;
+    }
+
+    long long size = (long long)numVertices * rowWords;
+    bits = new unsigned long long[size];
+    for (long long i = 0; i < size; i++) {
+        bits[i] = other.bits[i];
+    }
+}
+
+// Take over the matrix of another graph, leaving it empty
+void DenseGraph::takeFrom(DenseGraph& other) {
+    numVertices = other.numVertices;
+    rowWords = other.rowWords;
+    numEdges = other.numEdges;
+    bits = other.bits;
+
+    other.numVertices = 0;
+    other.rowWords = 0;
+    other.numEdges = 0;
+    other.bits = nullptr;
+}
+
+// Copy constructor
+DenseGraph::DenseGraph(const DenseGraph& other) {
+    copyFrom(other);
+}
+
+// Assignment operator
+DenseGraph& DenseGraph::operator=(const DenseGraph& other) {
+    if (this != &other) {
+        DenseGraph copy(other);
+        *this = static_cast<DenseGraph&&>(copy);
+    }
+    return *this;
+}
+
+// Move constructor
+DenseGraph::DenseGraph(DenseGraph&& other) noexcept {
+    takeFrom(other);
+}
+
+// Move assignment operator
+DenseGraph& DenseGraph::operator=(DenseGraph&& other) noexcept {
+    if (this != &other) {
+        delete[] bits;
+        takeFrom(other);
+    }
+    return *this;
+}
+
+void DenseGraph::checkVertex(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+}
+
+void DenseGraph::addEdge(int source, int dest) {
+    checkVertex(source);
+    checkVertex(dest);
+    if (hasEdge(source, dest)) {
+        return;
+    }
+
+    bits[(long long)source * rowWords + (dest >> 6)] |= 1ULL << (dest & 63);
+    bits[(long long)dest * rowWords + (source >> 6)] |= 1ULL << (source & 63);
+    numEdges++;
+}
+
+void DenseGraph::removeEdge(int source, int dest) {
+    checkVertex(source);
+    checkVertex(dest);
+    if (!hasEdge(source, dest)) {
+        return;
+    }
+
+    bits[(long long)source * rowWords + (dest >> 6)] &= ~(1ULL << (dest & 63));
+    bits[(long long)dest * rowWords + (source >> 6)] &= ~(1ULL << (source & 63));
+    numEdges--;
+}
+
+bool DenseGraph::hasEdge(int source, int dest) const {
+    checkVertex(source);
+    checkVertex(dest);
+    return (bits[(long long)source * rowWords + (dest >> 6)] >> (dest & 63)) & 1;
+}
+
+int DenseGraph::getNumVertices() const {
+    return numVertices;
+}
+
+long long DenseGraph::getNumEdges() const {
+    return numEdges;
+}
+
+int DenseGraph::getDegree(int vertex) const {
+    checkVertex(vertex);
+    return (int)popcountWords(getRow(vertex), rowWords);
+}
+
+int DenseGraph::countCommonNeighbors(int u, int v) const {
+    checkVertex(u);
+    checkVertex(v);
+    return (int)popcountAndWords(getRow(u), getRow(v), rowWords);
+}
+
+// |N(u) ∪ N(v)| = |N(u)| + |N(v)| - |N(u) ∩ N(v)|, without writing the union
+int DenseGraph::countUnionNeighbors(int u, int v) const {
+    checkVertex(u);
+    checkVertex(v);
+    return (int)(popcountWords(getRow(u), rowWords) + popcountWords(getRow(v), rowWords) -
+                 popcountAndWords(getRow(u), getRow(v), rowWords));
+}
+
+void DenseGraph::commonNeighbors(int u, int v, unsigned long long* out) const {
+    checkVertex(u);
+    checkVertex(v);
+    andWords(getRow(u), getRow(v), out, rowWords);
+}
+
+void DenseGraph::unionNeighbors(int u, int v, unsigned long long* out) const {
+    checkVertex(u);
+    checkVertex(v);
+    orWords(getRow(u), getRow(v), out, rowWords);
+}
+
+int DenseGraph::getRowWords() const {
+    return rowWords;
+}
+
+const unsigned long long* DenseGraph::getRow(int vertex) const {
+    checkVertex(vertex);
+    return bits + (long long)vertex * rowWords;
+}
+
+Graph DenseGraph::toGraph() const {
+    if (numEdges > 1073741823) {
+        throw "Too many edges"; // Graph's limit; a matrix of about 46k vertices or more can exceed it
+    }
+
+    // The set bits of the upper triangle, diagonal included, as one edge list
+    WeightedEdge* edges = new WeightedEdge[numEdges > 0 ? numEdges : 1];
+    int count = 0;
+    for (int u = 0; u < numVertices; u++) {
+        const unsigned long long* row = bits + (long long)u * rowWords;
+        for (int w = u >> 6; w < rowWords; w++) {
+            unsigned long long word = row[w];
+            if (w == (u >> 6)) {
+                word &= ~0ULL << (u & 63);
+            }
+            while (word) {
+                edges[count++] = WeightedEdge(u, w * 64 + __builtin_ctzll(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    Graph result(numVertices, edges, count);
+    delete[] edges;
+    return result;
+}
+
+} // namespace graph
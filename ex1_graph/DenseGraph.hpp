@@ -0,0 +1,85 @@
+// densegraph.hpp
+#ifndef DENSEGRAPH_HPP
+#define DENSEGRAPH_HPP
+
+#include "Graph.hpp"
+
+namespace graph {
+
+// Undirected graph stored as a bit matrix: bit w of row v is set when v and w are
+// adjacent. Meant for dense graphs, where a row of V bits takes less room than a
+// list of the neighbors and operations on neighborhoods become word-wide AND, OR
+// and popcounts.
+//
+// The matrix is unweighted and has no parallel edges. Converting a Graph drops the
+// weights and merges parallel edges; toGraph gives every edge weight 1. A self-loop
+// is the diagonal bit.
+//
+// The row kernels run on AVX2 when the processor supports it (checked at run time)
+// and on 64-bit words otherwise. Both paths give the same results.
+class DenseGraph {
+public:
+    explicit DenseGraph(int vertices);
+    explicit DenseGraph(const Graph& g);
+    ~DenseGraph();
+
+    // Copy and move
+    DenseGraph(const DenseGraph& other);
+    DenseGraph& operator=(const DenseGraph& other);
+    DenseGraph(DenseGraph&& other) noexcept;
+    DenseGraph& operator=(DenseGraph&& other) noexcept;
+
+    // Adding an existing edge or removing a missing one changes nothing
+    void addEdge(int source, int dest);
+    void removeEdge(int source, int dest);
+    bool hasEdge(int source, int dest) const;
+
+    int getNumVertices() const;
+    long long getNumEdges() const;
+    int getDegree(int vertex) const; // Distinct neighbors - a self-loop counts once
+
+    // Neighborhood set operations. The versions writing a row fill getRowWords() words.
+    int countCommonNeighbors(int u, int v) const;
+    int countUnionNeighbors(int u, int v) const;
+    void commonNeighbors(int u, int v, unsigned long long* out) const;
+    void unionNeighbors(int u, int v, unsigned long long* out) const;
+
+    // Row v holds the neighbors of v as a bitset. Rows are padded to a multiple of
+    // four words; the padding bits are always zero.
+    int getRowWords() const;
+    const unsigned long long* getRow(int vertex) const;
+
+    Graph toGraph() const;
+
+    // Kernels on word arrays, for callers combining rows themselves. out may be one
+    // of the inputs.
+    static void andWords(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                         int words);
+    static void orWords(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                        int words);
+    static void andNotWords(const unsigned long long* a, const unsigned long long* b, unsigned long long* out,
+                            int words); // a & ~b
+    static long long popcountWords(const unsigned long long* a, int words);
+    static long long popcountAndWords(const unsigned long long* a, const unsigned long long* b, int words);
+
+    // hasAvx2 tells whether this processor supports the AVX2 kernels. They are used
+    // whenever it does, unless setAvx2Enabled(false) selects the scalar kernels (for
+    // example to compare the two). Not to be switched while kernels are running.
+    static bool hasAvx2();
+    static void setAvx2Enabled(bool enable);
+    static bool isAvx2Enabled();
+
+private:
+    int numVertices;
+    int rowWords;
+    long long numEdges;
+    unsigned long long* bits; // numVertices rows of rowWords words
+
+    void checkVertex(int vertex) const;
+    void copyFrom(const DenseGraph& other);
+    void takeFrom(DenseGraph& other);
+};
+
+} // namespace graph
+
+#endif // DENSEGRAPH_HPP
@@ -0,0 +1,116 @@
+// densetraversals.cpp
+#include "Algorithms.hpp"
+#include <climits>
+
+namespace graph {
+
+// Lowest vertex set in both bitsets, or -1
+static int firstCommon(const unsigned long long* a, const unsigned long long* b, int words) {
+    for (int i = 0; i < words; i++) {
+        unsigned long long common = a[i] & b[i];
+        if (common) {
+            return i * 64 + __builtin_ctzll(common);
+        }
+    }
+    return -1;
+}
+
+SearchTree Algorithms::bfsTree(const DenseGraph& g, int source) {
+    SearchTree result;
+    bfsTree(g, source, result);
+    return result;
+}
+
+// BFS on the bit matrix, one level at a time with the levels as bitsets.
+// A top-down step ORs the rows of the frontier vertices together and removes the
+// visited vertices; a bottom-up step checks every unvisited vertex's row against
+// the frontier instead, which is cheaper once the frontier outnumbers the
+// unvisited vertices. Either way a new vertex's parent is the lowest frontier
+// vertex adjacent to it. Every tree edge has weight 1.
+void Algorithms::bfsTree(const DenseGraph& g, int source, SearchTree& result) {
+    int numVertices = g.getNumVertices();
+
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+
+    result.reset(numVertices, source);
+    int* distance = result.distance;
+    int* parent = result.parent;
+    int* parentWeight = result.parentWeight;
+
+    int words = g.getRowWords();
+    const unsigned long long* matrix = g.getRow(0);
+    unsigned long long* visited = new unsigned long long[words];
+    unsigned long long* frontier = new unsigned long long[words];
+    unsigned long long* next = new unsigned long long[words];
+    for (int i = 0; i < words; i++) {
+        visited[i] = 0;
+        frontier[i] = 0;
+    }
+    visited[source >> 6] |= 1ULL << (source & 63);
+    frontier[source >> 6] |= 1ULL << (source & 63);
+
+    int frontierSize = 1;
+    int unvisited = numVertices - 1;
+    for (int level = 1; frontierSize > 0 && unvisited > 0; level++) {
+        for (int i = 0; i < words; i++) {
+            next[i] = 0;
+        }
+
+        bool topDown = frontierSize <= unvisited;
+        if (topDown) {
+            for (int i = 0; i < words; i++) {
+                for (unsigned long long word = frontier[i]; word; word &= word - 1) {
+                    int u = i * 64 + __builtin_ctzll(word);
+                    DenseGraph::orWords(next, matrix + (long long)u * words, next, words);
+                }
+            }
+            DenseGraph::andNotWords(next, visited, next, words);
+        } else {
+            for (int i = 0; i < words; i++) {
+                // Unvisited vertices of this word, leaving out the padding past the last vertex
+                unsigned long long word = ~visited[i];
+                if (i == (numVertices - 1) >> 6 && (numVertices & 63) != 0) {
+                    word &= (1ULL << (numVertices & 63)) - 1;
+                } else if (i > (numVertices - 1) >> 6) {
+                    word = 0;
+                }
+                for (; word; word &= word - 1) {
+                    int v = i * 64 + __builtin_ctzll(word);
+                    int u = firstCommon(matrix + (long long)v * words, frontier, words);
+                    if (u != -1) {
+                        next[i] |= 1ULL << (v & 63);
+                        parent[v] = u;
+                    }
+                }
+            }
+        }
+
+        // Record the new level and make it the frontier
+        frontierSize = 0;
+        for (int i = 0; i < words; i++) {
+            for (unsigned long long word = next[i]; word; word &= word - 1) {
+                int v = i * 64 + __builtin_ctzll(word);
+                distance[v] = level;
+                if (topDown) {
+                    parent[v] = firstCommon(matrix + (long long)v * words, frontier, words);
+                }
+                parentWeight[v] = 1;
+                frontierSize++;
+            }
+        }
+        DenseGraph::orWords(visited, next, visited, words);
+        unvisited -= frontierSize;
+
+        unsigned long long* temp = frontier;
+        frontier = next;
+        next = temp;
+    }
+
+    delete[] next;
+    delete[] frontier;
+    delete[] visited;
+}
+
+} // namespace graph
@@ -0,0 +1,158 @@
+// distancequeries.cpp
+#include "Algorithms.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <climits>
+#include <exception>
+#include <mutex>
+
+namespace graph {
+
+// Dijkstra from one source into distance[], which must hold INT_MAX everywhere.
+// The queue is empty before and after. With non-negative weights a stale queue
+// entry has a key above its vertex's distance, so no settled array is needed.
+static void distancesFrom(const CSRGraph& g, int source, int* distance, BinaryHeapQueue& pq) {
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
+
+    distance[source] = 0;
+    pq.push(source, 0);
+
+    while (!pq.isEmpty()) {
+        int u;
+        int d;
+        pq.popMin(u, d);
+
+        if (d > distance[u]) {
+            continue; // Stale entry
+        }
+
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int v = destinations[i];
+            if (d + weights[i] < distance[v]) {
+                distance[v] = d + weights[i];
+                pq.push(v, distance[v]);
+            }
+        }
+    }
+}
+
+// Shared driver for the table and the sink versions. Workers take the next source
+// index from an atomic counter, so uneven run times balance out, and keep their queue
+// (and, for a sink, their distance array) for every source they take. Rows of a table
+// are filled in place.
+void Algorithms::multiSourceRun(const CSRGraph& g, const int* sources, int sourceCount, int numThreads,
+                                DistanceTable* table, DistanceRowSink* sink) {
+    int numVertices = g.getNumVertices();
+
+    if (sourceCount < 0) {
+        throw "Source count must not be negative";
+    }
+    if (numThreads <= 0) {
+        throw "Number of threads must be positive";
+    }
+    for (int i = 0; i < sourceCount; i++) {
+        if (sources[i] < 0 || sources[i] >= numVertices) {
+            throw "Source vertex out of range";
+        }
+    }
+    const int* weights = g.getWeights();
+    for (int i = 0; i < g.getNumHalfEdges(); i++) {
+        if (weights[i] < 0) {
+            throw "Multi-source distances need non-negative weights";
+        }
+    }
+
+    if (table) {
+        table->reset(sources, sourceCount, numVertices);
+    }
+    int threads = numThreads < sourceCount ? numThreads : sourceCount;
+    if (threads == 0) {
+        return;
+    }
+
+    std::atomic<int> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error; // Whatever the sink threw, rethrown once every worker is done
+    std::mutex sinkMutex;
+
+    runInParallel(threads, [&](int) {
+        BinaryHeapQueue pq(numVertices);
+        int* own = table ? nullptr : new int[numVertices];
+
+        for (int index = next++; index < sourceCount && !failed; index = next++) {
+            int* distance = table ? table->row(index) : own;
+            for (int v = 0; v < numVertices; v++) {
+                distance[v] = INT_MAX;
+            }
+            distancesFrom(g, sources[index], distance, pq);
+
+            if (sink) {
+                // One row at a time; an exception from the sink stops the run
+                std::lock_guard<std::mutex> lock(sinkMutex);
+                if (!failed) {
+                    try {
+                        sink->row(index, sources[index], distance, numVertices);
+                    } catch (...) {
+                        error = std::current_exception();
+                        failed = true;
+                    }
+                }
+            }
+        }
+
+        delete[] own;
+    });
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void Algorithms::multiSourceDistances(const CSRGraph& g, const int* sources, int sourceCount, int numThreads,
+                                      DistanceTable& table) {
+    multiSourceRun(g, sources, sourceCount, numThreads, &table, nullptr);
+}
+
+void Algorithms::multiSourceDistances(const CSRGraph& g, const int* sources, int sourceCount, int numThreads,
+                                      DistanceRowSink& sink) {
+    multiSourceRun(g, sources, sourceCount, numThreads, nullptr, &sink);
+}
+
+void Algorithms::multiSourceDistances(const Graph& g, const int* sources, int sourceCount, int numThreads,
+                                      DistanceTable& table) {
+    CSRGraph csr(g);
+    multiSourceRun(csr, sources, sourceCount, numThreads, &table, nullptr);
+}
+
+void Algorithms::multiSourceDistances(const Graph& g, const int* sources, int sourceCount, int numThreads,
+                                      DistanceRowSink& sink) {
+    CSRGraph csr(g);
+    multiSourceRun(csr, sources, sourceCount, numThreads, nullptr, &sink);
+}
+
+DistanceTable Algorithms::allPairsDistances(const CSRGraph& g, int numThreads) {
+    int numVertices = g.getNumVertices();
+    int* sources = new int[numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        sources[i] = i;
+    }
+
+    DistanceTable table;
+    try {
+        multiSourceRun(g, sources, numVertices, numThreads, &table, nullptr);
+    } catch (...) {
+        delete[] sources;
+        throw;
+    }
+    delete[] sources;
+    return table;
+}
+
+DistanceTable Algorithms::allPairsDistances(const Graph& g, int numThreads) {
+    CSRGraph csr(g);
+    return allPairsDistances(csr, numThreads);
+}
+
+} // namespace graph
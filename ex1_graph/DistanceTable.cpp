@@ -0,0 +1,117 @@
+// distancetable.cpp
+#include "DistanceTable.hpp"
+
+namespace graph {
+
+DistanceTable::DistanceTable() : numSources(0), numTargets(0), sources(nullptr), distances(nullptr) {}
+
+DistanceTable::~DistanceTable() {
+    delete[] sources;
+    delete[] distances;
+}
+
+// Copy constructor
+DistanceTable::DistanceTable(const DistanceTable& other)
+    : numSources(0), numTargets(0), sources(nullptr), distances(nullptr) {
+    reset(other.sources, other.numSources, other.numTargets);
+    long long size = (long long)numSources * numTargets;
+    for (long long i = 0; i < size; i++) {
+        distances[i] = other.distances[i];
+    }
+}
+
+// Assignment operator
+DistanceTable& DistanceTable::operator=(const DistanceTable& other) {
+    if (this != &other) {
+        DistanceTable copy(other);
+        *this = static_cast<DistanceTable&&>(copy);
+    }
+    return *this;
+}
+
+// Move constructor
+DistanceTable::DistanceTable(DistanceTable&& other) noexcept
+    : numSources(other.numSources), numTargets(other.numTargets), sources(other.sources),
+      distances(other.distances) {
+    other.numSources = 0;
+    other.numTargets = 0;
+    other.sources = nullptr;
+    other.distances = nullptr;
+}
+
+// Move assignment operator
+DistanceTable& DistanceTable::operator=(DistanceTable&& other) noexcept {
+    if (this != &other) {
+        delete[] sources;
+        delete[] distances;
+
+        numSources = other.numSources;
+        numTargets = other.numTargets;
+        sources = other.sources;
+        distances = other.distances;
+
+        other.numSources = 0;
+        other.numTargets = 0;
+        other.sources = nullptr;
+        other.distances = nullptr;
+    }
+    return *this;
+}
+
+void DistanceTable::reset(const int* sourceList, int sourceCount, int targets) {
+    if ((long long)sourceCount * targets != (long long)numSources * numTargets) {
+        delete[] distances;
+        distances = nullptr;
+        if ((long long)sourceCount * targets > 0) {
+            distances = new int[(long long)sourceCount * targets];
+        }
+    }
+    if (sourceCount != numSources) {
+        delete[] sources;
+        sources = sourceCount > 0 ? new int[sourceCount] : nullptr;
+    }
+
+    numSources = sourceCount;
+    numTargets = targets;
+    for (int i = 0; i < sourceCount; i++) {
+        sources[i] = sourceList[i];
+    }
+}
+
+int* DistanceTable::row(int index) {
+    return distances + (long long)index * numTargets;
+}
+
+int DistanceTable::getNumSources() const {
+    return numSources;
+}
+
+int DistanceTable::getNumTargets() const {
+    return numTargets;
+}
+
+int DistanceTable::getSource(int row) const {
+    if (row < 0 || row >= numSources) {
+        throw "Row index out of range";
+    }
+    return sources[row];
+}
+
+int DistanceTable::getDistance(int row, int target) const {
+    if (row < 0 || row >= numSources) {
+        throw "Row index out of range";
+    }
+    if (target < 0 || target >= numTargets) {
+        throw "Vertex index out of range";
+    }
+    return distances[(long long)row * numTargets + target];
+}
+
+const int* DistanceTable::getRow(int row) const {
+    if (row < 0 || row >= numSources) {
+        throw "Row index out of range";
+    }
+    return distances + (long long)row * numTargets;
+}
+
+} // namespace graph
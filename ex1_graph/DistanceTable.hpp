@@ -0,0 +1,52 @@
+// distancetable.hpp
+#ifndef DISTANCETABLE_HPP
+#define DISTANCETABLE_HPP
+
+namespace graph {
+
+// Dense table of shortest distances, one row per source and one column per vertex.
+// Unreachable vertices have distance INT_MAX.
+class DistanceTable {
+public:
+    DistanceTable();
+    ~DistanceTable();
+
+    // Copy and move
+    DistanceTable(const DistanceTable& other);
+    DistanceTable& operator=(const DistanceTable& other);
+    DistanceTable(DistanceTable&& other) noexcept;
+    DistanceTable& operator=(DistanceTable&& other) noexcept;
+
+    int getNumSources() const;
+    int getNumTargets() const;
+    int getSource(int row) const;
+    int getDistance(int row, int target) const;
+    const int* getRow(int row) const;
+
+private:
+    friend class Algorithms;
+
+    int numSources;
+    int numTargets;
+    int* sources;
+    int* distances; // numSources * numTargets entries, row by row
+
+    // Size the table for the given sources, reusing the storage when it fits
+    void reset(const int* sourceList, int sourceCount, int targets);
+    int* row(int index);
+};
+
+// Receives the rows of a multi-source run instead of a DistanceTable, so that the
+// whole table never has to be in memory. Rows arrive one call at a time but in any
+// order, from the worker threads; the distances are only valid during the call.
+// An exception thrown by row stops the run and is rethrown by multiSourceDistances.
+class DistanceRowSink {
+public:
+    virtual ~DistanceRowSink() {}
+
+    virtual void row(int index, int source, const int* distances, int numTargets) = 0;
+};
+
+} // namespace graph
+
+#endif // DISTANCETABLE_HPP
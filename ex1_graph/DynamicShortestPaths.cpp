@@ -0,0 +1,261 @@
+// dynamicshortestpaths.cpp
+#include "DynamicShortestPaths.hpp"
+#include <climits>
+
+namespace graph {
+
+DynamicShortestPaths::DynamicShortestPaths(const Graph& g, int root)
+    : graph(g), numVertices(g.getNumVertices()), source(root), epoch(0), queue(16), repairSize(0) {
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    for (int u = 0; u < numVertices; u++) {
+        for (Graph::Edge* edge = g.getAdjList(u); edge; edge = edge->next) {
+            if (edge->weight < 0) {
+                throw "Dynamic shortest paths need non-negative weights";
+            }
+        }
+    }
+
+    distance = new int[numVertices];
+    parent = new int[numVertices];
+    parentWeight = new int[numVertices];
+    firstChild = new int[numVertices];
+    nextSibling = new int[numVertices];
+    prevSibling = new int[numVertices];
+    stamps = new unsigned int[numVertices];
+    subtree = new int[numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        distance[i] = INT_MAX;
+        parent[i] = -1;
+        parentWeight[i] = 0;
+        firstChild[i] = -1;
+        nextSibling[i] = -1;
+        prevSibling[i] = -1;
+        stamps[i] = 0;
+    }
+
+    // The initial tree is a plain Dijkstra run, improving from the source
+    distance[source] = 0;
+    queue.push(source, 0);
+    propagate();
+    repairSize = 0;
+}
+
+DynamicShortestPaths::~DynamicShortestPaths() {
+    delete[] distance;
+    delete[] parent;
+    delete[] parentWeight;
+    delete[] firstChild;
+    delete[] nextSibling;
+    delete[] prevSibling;
+    delete[] stamps;
+    delete[] subtree;
+}
+
+// Move a vertex under a new parent, keeping the child lists in step
+void DynamicShortestPaths::setParent(int vertex, int newParent, int weight) {
+    int old = parent[vertex];
+    if (old != -1) {
+        if (prevSibling[vertex] != -1) {
+            nextSibling[prevSibling[vertex]] = nextSibling[vertex];
+        } else {
+            firstChild[old] = nextSibling[vertex];
+        }
+        if (nextSibling[vertex] != -1) {
+            prevSibling[nextSibling[vertex]] = prevSibling[vertex];
+        }
+    }
+
+    parent[vertex] = newParent;
+    parentWeight[vertex] = weight;
+    prevSibling[vertex] = -1;
+    nextSibling[vertex] = -1;
+    if (newParent != -1) {
+        nextSibling[vertex] = firstChild[newParent];
+        if (firstChild[newParent] != -1) {
+            prevSibling[firstChild[newParent]] = vertex;
+        }
+        firstChild[newParent] = vertex;
+    }
+}
+
+// Take the edge if it shortens the path to 'to'. Written as a difference so that
+// it cannot overflow.
+void DynamicShortestPaths::relax(int from, int to, int weight) {
+    if (distance[from] != INT_MAX && weight < distance[to] - distance[from]) {
+        distance[to] = distance[from] + weight;
+        setParent(to, from, weight);
+        queue.push(to, distance[to]);
+        repairSize++;
+    }
+}
+
+// Dijkstra from the vertices in the queue, with the usual stale-entry check
+void DynamicShortestPaths::propagate() {
+    while (!queue.isEmpty()) {
+        int u;
+        int d;
+        queue.popMin(u, d);
+        if (d > distance[u]) {
+            continue;
+        }
+
+        for (Graph::Edge* edge = graph.getAdjList(u); edge; edge = edge->next) {
+            if (edge->weight < 0) {
+                throw "Dynamic shortest paths need non-negative weights";
+            }
+            relax(u, edge->destination, edge->weight);
+        }
+    }
+}
+
+// Recompute the subtree below root after its tree edge got heavier or disappeared.
+// Distances outside the subtree stay exact, so they seed the search into it.
+void DynamicShortestPaths::repairSubtree(int root) {
+    if (++epoch == 0) {
+        for (int i = 0; i < numVertices; i++) {
+            stamps[i] = 0;
+        }
+        epoch = 1;
+    }
+
+    int count = 0;
+    subtree[count++] = root;
+    stamps[root] = epoch;
+    for (int i = 0; i < count; i++) {
+        for (int child = firstChild[subtree[i]]; child != -1; child = nextSibling[child]) {
+            subtree[count++] = child;
+            stamps[child] = epoch;
+        }
+    }
+    repairSize += count;
+
+    // Cut every vertex loose, then let the neighbors outside offer their distances
+    for (int i = 0; i < count; i++) {
+        setParent(subtree[i], -1, 0);
+        distance[subtree[i]] = INT_MAX;
+    }
+    for (int i = 0; i < count; i++) {
+        int v = subtree[i];
+        for (Graph::Edge* edge = graph.getAdjList(v); edge; edge = edge->next) {
+            if (edge->weight < 0) {
+                throw "Dynamic shortest paths need non-negative weights";
+            }
+            if (stamps[edge->destination] != epoch) {
+                relax(edge->destination, v, edge->weight);
+            }
+        }
+    }
+    propagate();
+}
+
+// Weight of the lightest edge between u and v, or INT_MAX if there is none. The
+// shorter of the two lists is walked.
+int DynamicShortestPaths::lightestEdge(int u, int v) const {
+    if (graph.getDegree(v) < graph.getDegree(u)) {
+        int temp = u;
+        u = v;
+        v = temp;
+    }
+    int lightest = INT_MAX;
+    for (Graph::Edge* edge = graph.getAdjList(u); edge; edge = edge->next) {
+        if (edge->destination == v && edge->weight < lightest) {
+            lightest = edge->weight;
+        }
+    }
+    if (lightest < 0) {
+        throw "Dynamic shortest paths need non-negative weights";
+    }
+    return lightest;
+}
+
+void DynamicShortestPaths::edgeChanged(int u, int v) {
+    checkVertex(u);
+    checkVertex(v);
+    repairSize = 0;
+    if (u == v) {
+        return; // A self-loop is never on a shortest path
+    }
+
+    // A tree edge that got heavier or vanished invalidates the subtree below it;
+    // any other change can only shorten paths
+    int weight = lightestEdge(u, v);
+    if (parent[v] == u && weight > parentWeight[v]) {
+        repairSubtree(v);
+    } else if (parent[u] == v && weight > parentWeight[u]) {
+        repairSubtree(u);
+    }
+
+    if (weight != INT_MAX) {
+        relax(u, v, weight);
+        relax(v, u, weight);
+        propagate();
+    }
+}
+
+void DynamicShortestPaths::checkVertex(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+}
+
+int DynamicShortestPaths::getNumVertices() const {
+    return numVertices;
+}
+
+int DynamicShortestPaths::getSource() const {
+    return source;
+}
+
+bool DynamicShortestPaths::isReached(int vertex) const {
+    checkVertex(vertex);
+    return distance[vertex] != INT_MAX;
+}
+
+int DynamicShortestPaths::getDistance(int vertex) const {
+    checkVertex(vertex);
+    return distance[vertex];
+}
+
+int DynamicShortestPaths::getParent(int vertex) const {
+    checkVertex(vertex);
+    return parent[vertex];
+}
+
+const int* DynamicShortestPaths::getDistances() const {
+    return distance;
+}
+
+const int* DynamicShortestPaths::getParents() const {
+    return parent;
+}
+
+Path DynamicShortestPaths::pathTo(int vertex) const {
+    checkVertex(vertex);
+    if (distance[vertex] == INT_MAX) {
+        return Path();
+    }
+
+    int length = 1;
+    for (int v = vertex; parent[v] != -1; v = parent[v]) {
+        length++;
+    }
+
+    int* vertices = new int[length];
+    int v = vertex;
+    for (int i = length - 1; i >= 0; i--) {
+        vertices[i] = v;
+        v = parent[v];
+    }
+
+    Path path(vertices, length, distance[vertex]);
+    delete[] vertices;
+    return path;
+}
+
+int DynamicShortestPaths::getLastRepairSize() const {
+    return repairSize;
+}
+
+} // namespace graph
@@ -0,0 +1,84 @@
+// dynamicshortestpaths.hpp
+#ifndef DYNAMICSHORTESTPATHS_HPP
+#define DYNAMICSHORTESTPATHS_HPP
+
+#include "Graph.hpp"
+#include "Path.hpp"
+#include "PriorityQueues.hpp"
+
+namespace graph {
+
+// Shortest-path tree from one source that is repaired after edge changes instead
+// of being recomputed (a tree-based variant of Ramalingam and Reps).
+//
+// The caller changes the graph (addEdge, removeEdge, setWeight) and then reports
+// every changed vertex pair with edgeChanged. Several trees may follow one graph.
+// - If a tree edge got heavier or disappeared, only the subtree below it can get
+//   longer distances. The subtree is cut off, each of its vertices takes the best
+//   distance offered by its neighbors outside it, and Dijkstra runs inside it.
+// - If an edge got lighter or was added, Dijkstra runs from the endpoint it
+//   improves, through the vertices whose distance drops.
+// Either way the work is proportional to the vertices whose distance or parent
+// changes and their edges, not to V. The result always equals a from-scratch
+// Dijkstra run: the same distances and a valid shortest-path tree.
+//
+// Weights must be non-negative. The graph must outlive the tree and keep its
+// number of vertices.
+class DynamicShortestPaths {
+public:
+    DynamicShortestPaths(const Graph& g, int source);
+    ~DynamicShortestPaths();
+
+    // Repair the tree after the edges between u and v were added, removed or
+    // reweighted. Between the two only the lightest edge counts, so pairs with
+    // parallel edges are handled too. Walks the shorter adjacency list of the two
+    // even when nothing changes.
+    void edgeChanged(int u, int v);
+
+    int getNumVertices() const;
+    int getSource() const;
+    bool isReached(int vertex) const;
+    int getDistance(int vertex) const; // INT_MAX if unreachable
+    int getParent(int vertex) const;   // -1 for the source and unreachable vertices
+    const int* getDistances() const;
+    const int* getParents() const;
+    Path pathTo(int vertex) const;     // Path() if unreachable
+
+    // Vertices the last edgeChanged cut off or improved - its cost, up to their degrees
+    int getLastRepairSize() const;
+
+private:
+    const Graph& graph;
+    int numVertices;
+    int source;
+    int* distance;
+    int* parent;
+    int* parentWeight;
+
+    // Children of every vertex in the tree, as doubly linked sibling lists
+    int* firstChild;
+    int* nextSibling;
+    int* prevSibling;
+
+    // Workspace of a repair
+    unsigned int* stamps;   // stamps[v] == epoch: v is in the cut-off subtree
+    unsigned int epoch;
+    int* subtree;
+    BinaryHeapQueue queue;
+    int repairSize;
+
+    void setParent(int vertex, int newParent, int weight);
+    void relax(int from, int to, int weight);
+    void propagate();
+    void repairSubtree(int root);
+    int lightestEdge(int u, int v) const;
+    void checkVertex(int vertex) const;
+
+    // Trees are never copied
+    DynamicShortestPaths(const DynamicShortestPaths&);
+    DynamicShortestPaths& operator=(const DynamicShortestPaths&);
+};
+
+} // namespace graph
+
+#endif // DYNAMICSHORTESTPATHS_HPP
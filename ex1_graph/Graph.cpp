@@ -1,82 +1,473 @@
 // graph.cpp
 #include "Graph.hpp"
+#include "ConnectivityIndex.hpp"
 #include <iostream>
 
 namespace graph {
 
-// Edge struct implementation
-Graph::Edge::Edge(int dest, int w) : destination(dest), weight(w), next(nullptr) {}
+// Smallest and largest number of nodes in a single slab
+const int MIN_SLAB_SIZE = 64;
+const int MAX_SLAB_SIZE = 65536;
+
+// Markers for unused hash index entries, and the smallest index
+const int EMPTY_SLOT = -1;
+const int DELETED_SLOT = -2;
+const int MIN_INDEX_CAPACITY = 16;
+
+const int Graph::DEFAULT_INDEX_THRESHOLD;
+const int Graph::NO_INDEX;
 
-Graph::Edge::~Edge() {
-    delete next; // Delete the chain of edges
+// Index capacity for the given number of neighbors: a power of two at most a quarter full
+static int indexCapacity(int size) {
+    int capacity = MIN_INDEX_CAPACITY;
+    while (capacity < 4 * size + 4) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+static unsigned int indexSlot(int dest, int capacity) {
+    unsigned int h = (unsigned int)dest * 2654435769u;
+    return (h ^ (h >> 16)) & (unsigned int)(capacity - 1);
 }
 
+// Edge struct implementation
+Graph::Edge::Edge() : destination(0), weight(0), next(nullptr) {}
+
+Graph::Edge::Edge(int dest, int w) : destination(dest), weight(w), next(nullptr) {}
+
 // Graph constructors and destructor
-Graph::Graph(int vertices) : numVertices(vertices) {
+Graph::Graph(int vertices)
+    : numVertices(vertices), slabs(nullptr), currentSlab(nullptr), freeList(nullptr),
+      indexThreshold(DEFAULT_INDEX_THRESHOLD) {
     if (vertices <= 0) {
         throw "Number of vertices must be positive";
     }
     
-    adjacencyList = new Edge*[vertices];
-    for (int i = 0; i < vertices; i++) {
-        adjacencyList[i] = nullptr;
-    }
+    allocateVertexArrays();
+}
+
+Graph::Graph(int vertices, const WeightedEdge* edges, int edgeCount) : Graph(vertices) {
+    addEdges(edges, edgeCount);
 }
 
 Graph::~Graph() {
-    for (int i = 0; i < numVertices; i++) {
-        delete adjacencyList[i]; // This will trigger the Edge destructor chain
-    }
-    delete[] adjacencyList;
+    // Edge nodes live in the slabs, so the lists need no walking
+    releaseSlabs();
+    releaseVertexArrays();
 }
 
 // Copy constructor
-Graph::Graph(const Graph& other) : numVertices(other.numVertices) {
-    adjacencyList = new Edge*[numVertices];
+Graph::Graph(const Graph& other) : slabs(nullptr), currentSlab(nullptr), freeList(nullptr) {
+    copyFrom(other);
+}
+
+// Move constructor
+Graph::Graph(Graph&& other) noexcept
+    : adjacencyList(other.adjacencyList), numVertices(other.numVertices),
+      slabs(other.slabs), currentSlab(other.currentSlab), freeList(other.freeList),
+      degrees(other.degrees), indexes(other.indexes), indexThreshold(other.indexThreshold),
+      connectivity(other.connectivity) {
+    other.adjacencyList = nullptr;
+    other.numVertices = 0;
+    other.slabs = nullptr;
+    other.currentSlab = nullptr;
+    other.freeList = nullptr;
+    other.degrees = nullptr;
+    other.indexes = nullptr;
+    other.connectivity = nullptr;
+}
+
+// Assignment operator
+Graph& Graph::operator=(const Graph& other) {
+    if (this != &other) {
+        // Clean up existing data
+        releaseSlabs();
+        releaseVertexArrays();
+        
+        // Copy new data
+        copyFrom(other);
+    }
+    return *this;
+}
+
+// Move assignment operator
+Graph& Graph::operator=(Graph&& other) noexcept {
+    if (this != &other) {
+        releaseSlabs();
+        releaseVertexArrays();
+        
+        adjacencyList = other.adjacencyList;
+        numVertices = other.numVertices;
+        slabs = other.slabs;
+        currentSlab = other.currentSlab;
+        freeList = other.freeList;
+        degrees = other.degrees;
+        indexes = other.indexes;
+        indexThreshold = other.indexThreshold;
+        connectivity = other.connectivity;
+        
+        other.adjacencyList = nullptr;
+        other.numVertices = 0;
+        other.slabs = nullptr;
+        other.currentSlab = nullptr;
+        other.freeList = nullptr;
+        other.degrees = nullptr;
+        other.indexes = nullptr;
+        other.connectivity = nullptr;
+    }
+    return *this;
+}
+
+void Graph::swap(Graph& other) noexcept {
+    Edge** tempList = adjacencyList;
+    adjacencyList = other.adjacencyList;
+    other.adjacencyList = tempList;
+    
+    int tempVertices = numVertices;
+    numVertices = other.numVertices;
+    other.numVertices = tempVertices;
+    
+    EdgeSlab* tempSlab = slabs;
+    slabs = other.slabs;
+    other.slabs = tempSlab;
+    
+    tempSlab = currentSlab;
+    currentSlab = other.currentSlab;
+    other.currentSlab = tempSlab;
+    
+    Edge* tempFree = freeList;
+    freeList = other.freeList;
+    other.freeList = tempFree;
+    
+    int* tempDegrees = degrees;
+    degrees = other.degrees;
+    other.degrees = tempDegrees;
     
+    EdgeIndex** tempIndexes = indexes;
+    indexes = other.indexes;
+    other.indexes = tempIndexes;
+    
+    int tempThreshold = indexThreshold;
+    indexThreshold = other.indexThreshold;
+    other.indexThreshold = tempThreshold;
+    
+    ConnectivityIndex* tempConnectivity = connectivity;
+    connectivity = other.connectivity;
+    other.connectivity = tempConnectivity;
+}
+
+// Drop all edges; the slabs stay allocated and are filled again from the start
+void Graph::clear() {
     for (int i = 0; i < numVertices; i++) {
         adjacencyList[i] = nullptr;
-        
+        degrees[i] = 0;
+        dropIndex(i);
+    }
+    for (EdgeSlab* slab = slabs; slab; slab = slab->next) {
+        slab->used = 0;
+    }
+    currentSlab = slabs;
+    freeList = nullptr;
+    
+    if (connectivity) {
+        connectivity->reset();
+    }
+}
+
+// Deep copy of another graph; all nodes go into a single slab of the exact size
+void Graph::copyFrom(const Graph& other) {
+    numVertices = other.numVertices;
+    indexThreshold = other.indexThreshold;
+    allocateVertexArrays();
+    
+    int edgeCount = 0;
+    for (int i = 0; i < numVertices; i++) {
+        for (Edge* current = other.adjacencyList[i]; current; current = current->next) {
+            edgeCount++;
+        }
+    }
+    if (edgeCount > 0) {
+        addSlab(edgeCount);
+    }
+    
+    for (int i = 0; i < numVertices; i++) {
         // Deep copy the linked list
         Edge* current = other.adjacencyList[i];
         Edge** tail = &adjacencyList[i];
         
         while (current) {
-            *tail = new Edge(current->destination, current->weight);
+            *tail = allocateEdge(current->destination, current->weight);
             tail = &((*tail)->next);
             current = current->next;
         }
+        
+        degrees[i] = other.degrees[i];
+        if (degrees[i] > indexThreshold) {
+            buildIndex(i);
+        }
+    }
+    
+    if (other.connectivity) {
+        connectivity = new ConnectivityIndex(*this);
     }
 }
 
-// Assignment operator
-Graph& Graph::operator=(const Graph& other) {
-    if (this != &other) {
-        // Clean up existing data
-        for (int i = 0; i < numVertices; i++) {
-            delete adjacencyList[i];
+// Per-vertex arrays, all empty
+void Graph::allocateVertexArrays() {
+    adjacencyList = new Edge*[numVertices];
+    degrees = new int[numVertices];
+    indexes = new EdgeIndex*[numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        adjacencyList[i] = nullptr;
+        degrees[i] = 0;
+        indexes[i] = nullptr;
+    }
+    connectivity = nullptr;
+}
+
+void Graph::releaseVertexArrays() {
+    for (int i = 0; indexes && i < numVertices; i++) {
+        dropIndex(i);
+    }
+    delete[] indexes;
+    delete[] degrees;
+    delete[] adjacencyList;
+    delete connectivity;
+}
+
+// Add a new slab in front of the slab list
+void Graph::addSlab(int capacity) {
+    EdgeSlab* slab = new EdgeSlab;
+    slab->nodes = new Edge[capacity];
+    slab->capacity = capacity;
+    slab->used = 0;
+    slab->next = slabs;
+    slabs = slab;
+    currentSlab = slab;
+}
+
+// Release every slab at once
+void Graph::releaseSlabs() {
+    while (slabs) {
+        EdgeSlab* next = slabs->next;
+        delete[] slabs->nodes;
+        delete slabs;
+        slabs = next;
+    }
+    currentSlab = nullptr;
+    freeList = nullptr;
+}
+
+// Take a node from the free list, or from the current slab
+Graph::Edge* Graph::allocateEdge(int dest, int weight) {
+    Edge* edge;
+    
+    if (freeList) {
+        edge = freeList;
+        freeList = freeList->next;
+    } else {
+        // After clear() the older slabs are empty again, so move on to the next one with room
+        while (currentSlab && currentSlab->used == currentSlab->capacity) {
+            currentSlab = currentSlab->next;
         }
-        delete[] adjacencyList;
         
-        // Copy new data
-        numVertices = other.numVertices;
-        adjacencyList = new Edge*[numVertices];
+        if (!currentSlab) {
+            // Each new slab doubles the previous one, up to MAX_SLAB_SIZE. The previous
+            // one may be a bulk slab of up to 2^31 - 2 nodes, so clamp before doubling.
+            int capacity = !slabs ? MIN_SLAB_SIZE
+                         : slabs->capacity >= MAX_SLAB_SIZE / 2 ? MAX_SLAB_SIZE : slabs->capacity * 2;
+            if (capacity < MIN_SLAB_SIZE) {
+                capacity = MIN_SLAB_SIZE;
+            }
+            addSlab(capacity);
+        }
+        edge = &currentSlab->nodes[currentSlab->used++];
+    }
+    
+    edge->destination = dest;
+    edge->weight = weight;
+    edge->next = nullptr;
+    return edge;
+}
+
+// Return a node to the free list so the next addEdge can reuse it
+void Graph::releaseEdge(Edge* edge) {
+    edge->next = freeList;
+    freeList = edge;
+}
+
+// Put a node at the front of a vertex's list. The old head is now reached through
+// the new node, so if it is the indexed node for its neighbor the entry is updated.
+void Graph::linkFront(int vertex, Edge* edge) {
+    Edge* head = adjacencyList[vertex];
+    edge->next = head;
+    adjacencyList[vertex] = edge;
+    
+    // Only vertices above the threshold have an index, so most calls stop here
+    if (++degrees[vertex] > indexThreshold) {
+        EdgeIndex* index = indexes[vertex];
+        if (!index) {
+            buildIndex(vertex);
+            return;
+        }
+        if (head) {
+            relinkIndexed(index, head, &adjacencyList[vertex], &edge->next);
+        }
+        indexInsert(index, edge->destination, &adjacencyList[vertex]);
+    }
+}
+
+// Unlink the node that link points at and release it. Its successor is now
+// reached through the same link.
+void Graph::unlink(int vertex, Edge** link) {
+    Edge* edge = *link;
+    *link = edge->next;
+    
+    if (--degrees[vertex] <= indexThreshold) {
+        if (degrees[vertex] == indexThreshold) {
+            dropIndex(vertex); // Back at the threshold
+        }
+    } else {
+        EdgeIndex* index = indexes[vertex];
+        if (edge->next) {
+            relinkIndexed(index, edge->next, &edge->next, link);
+        }
         
-        for (int i = 0; i < numVertices; i++) {
-            adjacencyList[i] = nullptr;
-            
-            // Deep copy the linked list
-            Edge* current = other.adjacencyList[i];
-            Edge** tail = &adjacencyList[i];
-            
-            while (current) {
-                *tail = new Edge(current->destination, current->weight);
-                tail = &((*tail)->next);
-                current = current->next;
+        IndexEntry* entry = indexFind(index, edge->destination);
+        entry->count--;
+        if (entry->count == 0) {
+            entry->destination = DELETED_SLOT;
+            entry->link = nullptr;
+            index->size--;
+        } else if (entry->link == link) {
+            // The indexed node is gone; find one of its parallel nodes
+            Edge** other = &adjacencyList[vertex];
+            while ((*other)->destination != edge->destination) {
+                other = &((*other)->next);
             }
+            entry->link = other;
+        }
+        
+        // Shrink the table again once most of the list is gone
+        if (index->capacity > MIN_INDEX_CAPACITY && index->size * 16 < index->capacity) {
+            indexRehash(index, indexCapacity(index->size));
         }
     }
-    return *this;
+    releaseEdge(edge);
+}
+
+// The node is now reached through newLink instead of oldLink
+void Graph::relinkIndexed(EdgeIndex* index, Edge* edge, Edge** oldLink, Edge** newLink) {
+    IndexEntry* entry = indexFind(index, edge->destination);
+    if (entry->link == oldLink) {
+        entry->link = newLink;
+    }
+}
+
+// The link pointing at a node for dest in a vertex's list, or nullptr
+Graph::Edge** Graph::findLink(int vertex, int dest) const {
+    if (degrees[vertex] > indexThreshold) {
+        IndexEntry* entry = indexFind(indexes[vertex], dest);
+        return entry ? entry->link : nullptr;
+    }
+    
+    Edge** link = &adjacencyList[vertex];
+    while (*link) {
+        if ((*link)->destination == dest) {
+            return link;
+        }
+        link = &((*link)->next);
+    }
+    return nullptr;
+}
+
+void Graph::buildIndex(int vertex) {
+    EdgeIndex* index = new EdgeIndex;
+    index->capacity = MIN_INDEX_CAPACITY; // Grows with the number of distinct neighbors
+    index->entries = new IndexEntry[index->capacity];
+    for (int i = 0; i < index->capacity; i++) {
+        index->entries[i].destination = EMPTY_SLOT;
+        index->entries[i].link = nullptr;
+    }
+    index->size = 0;
+    index->occupied = 0;
+    
+    for (Edge** link = &adjacencyList[vertex]; *link; link = &((*link)->next)) {
+        indexInsert(index, (*link)->destination, link);
+    }
+    indexes[vertex] = index;
+}
+
+void Graph::dropIndex(int vertex) {
+    if (indexes[vertex]) {
+        delete[] indexes[vertex]->entries;
+        delete indexes[vertex];
+        indexes[vertex] = nullptr;
+    }
+}
+
+// Count a node for dest; the first node for a neighbor is the one the entry points at
+void Graph::indexInsert(EdgeIndex* index, int dest, Edge** link) {
+    IndexEntry* entry = indexFind(index, dest);
+    if (entry) {
+        entry->count++;
+        return;
+    }
+    
+    if (2 * (index->occupied + 1) > index->capacity) {
+        indexRehash(index, indexCapacity(index->size + 1));
+    }
+    unsigned int mask = (unsigned int)(index->capacity - 1);
+    unsigned int slot = indexSlot(dest, index->capacity);
+    while (index->entries[slot].destination >= 0) {
+        slot = (slot + 1) & mask;
+    }
+    if (index->entries[slot].destination == EMPTY_SLOT) {
+        index->occupied++;
+    }
+    index->entries[slot].destination = dest;
+    index->entries[slot].count = 1;
+    index->entries[slot].link = link;
+    index->size++;
+}
+
+Graph::IndexEntry* Graph::indexFind(const EdgeIndex* index, int dest) {
+    unsigned int mask = (unsigned int)(index->capacity - 1);
+    unsigned int slot = indexSlot(dest, index->capacity);
+    while (index->entries[slot].destination != EMPTY_SLOT) {
+        if (index->entries[slot].destination == dest) {
+            return &index->entries[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    return nullptr;
+}
+
+// Move the live entries into a table of the given capacity, dropping deleted ones
+void Graph::indexRehash(EdgeIndex* index, int capacity) {
+    IndexEntry* old = index->entries;
+    int oldCapacity = index->capacity;
+    
+    index->entries = new IndexEntry[capacity];
+    index->capacity = capacity;
+    for (int i = 0; i < capacity; i++) {
+        index->entries[i].destination = EMPTY_SLOT;
+        index->entries[i].link = nullptr;
+    }
+    
+    unsigned int mask = (unsigned int)(capacity - 1);
+    for (int i = 0; i < oldCapacity; i++) {
+        if (old[i].destination >= 0) {
+            unsigned int slot = indexSlot(old[i].destination, capacity);
+            while (index->entries[slot].destination != EMPTY_SLOT) {
+                slot = (slot + 1) & mask;
+            }
+            index->entries[slot] = old[i];
+        }
+    }
+    index->occupied = index->size;
+    delete[] old;
 }
 
 void Graph::addEdge(int source, int dest, int weight) {
@@ -85,14 +476,105 @@ void Graph::addEdge(int source, int dest, int weight) {
     }
     
     // Add edge from source to dest
-    Edge* newEdge = new Edge(dest, weight);
-    newEdge->next = adjacencyList[source];
-    adjacencyList[source] = newEdge;
+    linkFront(source, allocateEdge(dest, weight));
     
     // Since this is an undirected graph, add edge from dest to source as well
-    Edge* newEdgeReverse = new Edge(source, weight);
-    newEdgeReverse->next = adjacencyList[dest];
-    adjacencyList[dest] = newEdgeReverse;
+    linkFront(dest, allocateEdge(source, weight));
+    
+    if (connectivity) {
+        connectivity->unite(source, dest);
+    }
+}
+
+void Graph::addEdges(const WeightedEdge* edges, int edgeCount) {
+    if (edgeCount < 0) {
+        throw "Edge count must not be negative";
+    }
+    if (edgeCount > 1073741823) {
+        throw "Too many edges"; // Keeps 2 * edgeCount, the size of the bulk slab, within an int
+    }
+    for (int i = 0; i < edgeCount; i++) {
+        if (edges[i].source < 0 || edges[i].source >= numVertices ||
+            edges[i].dest < 0 || edges[i].dest >= numVertices) {
+            throw "Vertex index out of range";
+        }
+    }
+    if (edgeCount == 0) {
+        return;
+    }
+    
+    // Count the new neighbors of every vertex and turn the counts into start offsets
+    int* offsets = new int[numVertices + 1];
+    for (int i = 0; i <= numVertices; i++) {
+        offsets[i] = 0;
+    }
+    for (int i = 0; i < edgeCount; i++) {
+        offsets[edges[i].source + 1]++;
+        offsets[edges[i].dest + 1]++;
+    }
+    for (int i = 0; i < numVertices; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    
+    // One slab holds both directions of every new edge
+    addSlab(2 * edgeCount);
+    Edge* nodes = currentSlab->nodes;
+    currentSlab->used = 2 * edgeCount;
+    
+    int* cursor = new int[numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        cursor[i] = offsets[i];
+    }
+    for (int i = 0; i < edgeCount; i++) {
+        int u = edges[i].source;
+        int v = edges[i].dest;
+        
+        nodes[cursor[u]].destination = v;
+        nodes[cursor[u]].weight = edges[i].weight;
+        cursor[u]++;
+        
+        nodes[cursor[v]].destination = u;
+        nodes[cursor[v]].weight = edges[i].weight;
+        cursor[v]++;
+    }
+    
+    // Link each vertex's range in order and put it in front of its existing list
+    for (int v = 0; v < numVertices; v++) {
+        if (offsets[v] == offsets[v + 1]) {
+            continue;
+        }
+        for (int k = offsets[v]; k < offsets[v + 1] - 1; k++) {
+            nodes[k].next = &nodes[k + 1];
+        }
+        Edge* oldHead = adjacencyList[v];
+        nodes[offsets[v + 1] - 1].next = oldHead;
+        adjacencyList[v] = &nodes[offsets[v]];
+        degrees[v] += offsets[v + 1] - offsets[v];
+        
+        // The old head is now reached from the last new node; the new nodes go into the index
+        EdgeIndex* index = indexes[v];
+        if (degrees[v] > indexThreshold && !index) {
+            buildIndex(v);
+        } else if (index) {
+            if (oldHead) {
+                relinkIndexed(index, oldHead, &adjacencyList[v], &nodes[offsets[v + 1] - 1].next);
+            }
+            Edge** link = &adjacencyList[v];
+            for (int k = offsets[v]; k < offsets[v + 1]; k++) {
+                indexInsert(index, nodes[k].destination, link);
+                link = &nodes[k].next;
+            }
+        }
+    }
+    
+    delete[] cursor;
+    delete[] offsets;
+    
+    if (connectivity) {
+        for (int i = 0; i < edgeCount; i++) {
+            connectivity->unite(edges[i].source, edges[i].dest);
+        }
+    }
 }
 
 void Graph::removeEdge(int source, int dest) {
@@ -103,36 +585,27 @@ void Graph::removeEdge(int source, int dest) {
     bool edgeRemoved = false;
     
     // Remove edge from source to dest
-    Edge** curr = &adjacencyList[source];
-    while (*curr) {
-        if ((*curr)->destination == dest) {
-            Edge* temp = *curr;
-            *curr = (*curr)->next;
-            temp->next = nullptr; // Prevent deleting the entire chain
-            delete temp;
-            edgeRemoved = true;
-            break;
-        }
-        curr = &((*curr)->next);
+    Edge** link = findLink(source, dest);
+    if (link) {
+        unlink(source, link);
+        edgeRemoved = true;
     }
     
     // Remove edge from dest to source
-    curr = &adjacencyList[dest];
-    while (*curr) {
-        if ((*curr)->destination == source) {
-            Edge* temp = *curr;
-            *curr = (*curr)->next;
-            temp->next = nullptr; // Prevent deleting the entire chain
-            delete temp;
-            edgeRemoved = true;
-            break;
-        }
-        curr = &((*curr)->next);
+    link = findLink(dest, source);
+    if (link) {
+        unlink(dest, link);
+        edgeRemoved = true;
     }
     
     if (!edgeRemoved) {
         throw "Edge does not exist";
     }
+    
+    // Only the removal of the last edge between the two can split a component
+    if (connectivity) {
+        connectivity->edgeRemoved(*this, source, dest);
+    }
 }
 
 void Graph::print_graph() const {
@@ -147,10 +620,128 @@ void Graph::print_graph() const {
     }
 }
 
+// Search from an indexed endpoint if there is one, else from the shorter list
+bool Graph::searchFromDest(int source, int dest) const {
+    if (degrees[source] > indexThreshold) {
+        return false;
+    }
+    return degrees[dest] > indexThreshold || degrees[dest] < degrees[source];
+}
+
+bool Graph::hasEdge(int source, int dest) const {
+    if (source < 0 || source >= numVertices || dest < 0 || dest >= numVertices) {
+        throw "Vertex index out of range";
+    }
+    
+    if (searchFromDest(source, dest)) {
+        return findLink(dest, source) != nullptr;
+    }
+    return findLink(source, dest) != nullptr;
+}
+
+int Graph::getWeight(int source, int dest) const {
+    if (source < 0 || source >= numVertices || dest < 0 || dest >= numVertices) {
+        throw "Vertex index out of range";
+    }
+    
+    Edge** link;
+    if (searchFromDest(source, dest)) {
+        link = findLink(dest, source);
+    } else {
+        link = findLink(source, dest);
+    }
+    if (!link) {
+        throw "Edge does not exist";
+    }
+    return (*link)->weight;
+}
+
+void Graph::setWeight(int source, int dest, int weight) {
+    if (source < 0 || source >= numVertices || dest < 0 || dest >= numVertices) {
+        throw "Vertex index out of range";
+    }
+    
+    if (reweight(source, dest, weight) == 0) {
+        throw "Edge does not exist";
+    }
+    if (source != dest) {
+        reweight(dest, source, weight);
+    }
+}
+
+// Set the weight of every node for dest in a vertex's list and return their number
+int Graph::reweight(int vertex, int dest, int weight) {
+    if (degrees[vertex] > indexThreshold) {
+        IndexEntry* entry = indexFind(indexes[vertex], dest);
+        if (!entry) {
+            return 0;
+        }
+        if (entry->count == 1) {
+            (*entry->link)->weight = weight;
+            return 1;
+        }
+    }
+    
+    int count = 0;
+    for (Edge* edge = adjacencyList[vertex]; edge; edge = edge->next) {
+        if (edge->destination == dest) {
+            edge->weight = weight;
+            count++;
+        }
+    }
+    return count;
+}
+
+void Graph::setIndexThreshold(int degree) {
+    if (degree < 0) {
+        throw "Index threshold must not be negative";
+    }
+    
+    indexThreshold = degree;
+    for (int i = 0; i < numVertices; i++) {
+        if (degrees[i] > indexThreshold && !indexes[i]) {
+            buildIndex(i);
+        } else if (degrees[i] <= indexThreshold) {
+            dropIndex(i);
+        }
+    }
+}
+
+int Graph::getIndexThreshold() const {
+    return indexThreshold;
+}
+
+void Graph::trackConnectivity(bool enable) {
+    if (enable && !connectivity) {
+        connectivity = new ConnectivityIndex(*this);
+    } else if (!enable) {
+        delete connectivity;
+        connectivity = nullptr;
+    }
+}
+
+bool Graph::isTrackingConnectivity() const {
+    return connectivity != nullptr;
+}
+
+const ConnectivityIndex& Graph::getConnectivity() const {
+    if (!connectivity) {
+        throw "Connectivity is not tracked";
+    }
+    return *connectivity;
+}
+
 int Graph::getNumVertices() const {
     return numVertices;
 }
 
+int Graph::getDegree(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+    return degrees[vertex];
+}
+
 Graph::Edge* Graph::getAdjList(int vertex) const {
     if (vertex < 0 || vertex >= numVertices) {
         throw "Vertex index out of range";
@@ -4,6 +4,18 @@
 
 namespace graph {
 
+class ConnectivityIndex;
+
+// A single undirected edge, used to describe a graph as an edge list
+struct WeightedEdge {
+    int source;
+    int dest;
+    int weight;
+    
+    WeightedEdge() : source(0), dest(0), weight(0) {}
+    WeightedEdge(int s, int d, int w = 1) : source(s), dest(d), weight(w) {}
+};
+
 class Graph {
 public:
     // This struct represents an edge in the adjacency list
@@ -12,30 +24,130 @@ public:
         int weight;
         Edge* next;
         
+        Edge();
         Edge(int dest, int w);
-        ~Edge();
     };
 
     // Constructor and destructor
     Graph(int vertices);
     ~Graph();
     
+    // Build a graph from an edge list in one pass (see addEdges)
+    Graph(int vertices, const WeightedEdge* edges, int edgeCount);
+    
     // Copy constructor and assignment operator
     Graph(const Graph& other);
     Graph& operator=(const Graph& other);
     
+    // Move constructor and move assignment - take over the lists and slabs.
+    // The moved-from graph is left with no vertices.
+    Graph(Graph&& other) noexcept;
+    Graph& operator=(Graph&& other) noexcept;
+    void swap(Graph& other) noexcept;
+    
+    // Remove every edge but keep the allocated slabs for reuse
+    void clear();
+    
     // Main graph operations
     void addEdge(int source, int dest, int weight = 1);
+    
+    // Bulk insertion - validates every edge first, counts degrees and places the new
+    // neighbors of each vertex contiguously in one slab, in input order and ahead of
+    // the edges the vertex already had. Nothing is added if any edge is invalid.
+    void addEdges(const WeightedEdge* edges, int edgeCount);
     void removeEdge(int source, int dest);
     void print_graph() const; 
     
+    // Edge lookups. An indexed endpoint answers in expected O(1); otherwise the
+    // shorter of the two lists is walked. With parallel edges any one of them is found.
+    // On an indexed vertex removeEdge is O(1) as well, except that removing one of
+    // several parallel edges may walk the list to find the next one.
+    bool hasEdge(int source, int dest) const;
+    int getWeight(int source, int dest) const;
+    
+    // Give every edge between source and dest the new weight. Expected O(1) when both
+    // endpoints are indexed and there are no parallel edges; otherwise the lists
+    // of the two endpoints are walked.
+    void setWeight(int source, int dest, int weight);
+    
+    // Vertices with more than this many list entries get a hash index over their
+    // list, which also makes removeEdge O(1) there. NO_INDEX turns indexing off.
+    static const int DEFAULT_INDEX_THRESHOLD = 64;
+    static const int NO_INDEX = 2147483647;
+    void setIndexThreshold(int degree);
+    int getIndexThreshold() const;
+    
+    // Connected components kept up to date by addEdge, addEdges, removeEdge and clear
+    // (see ConnectivityIndex.hpp). Off by default; turning it on costs one pass over
+    // the edges. A copy of the graph tracks connectivity if the original does.
+    void trackConnectivity(bool enable);
+    bool isTrackingConnectivity() const;
+    const ConnectivityIndex& getConnectivity() const;
+    
     // Accessor methods
     int getNumVertices() const;
+    int getDegree(int vertex) const; // List entries - a self-loop counts twice
     Edge* getAdjList(int vertex) const;
     
 private:
+    // A block of edge nodes. Nodes are handed out in order and released
+    // all at once, so no node is ever deleted individually.
+    struct EdgeSlab {
+        Edge* nodes;
+        int capacity;
+        int used;
+        EdgeSlab* next;
+    };
+    
+    // Open-addressing hash table over one vertex's list, one entry per neighbor.
+    // The entry holds the link that points at one node for that neighbor - the list
+    // head or the previous node's next - so the node can be unlinked without walking
+    // the list, and the number of parallel nodes for the neighbor.
+    struct IndexEntry {
+        int destination; // EMPTY_SLOT or DELETED_SLOT when unused
+        int count;
+        Edge** link;
+    };
+    struct EdgeIndex {
+        IndexEntry* entries;
+        int capacity;    // Power of two
+        int size;        // Live entries (distinct neighbors)
+        int occupied;    // Live and deleted entries
+    };
+    
     Edge** adjacencyList; // Array of linked lists
     int numVertices;
+    EdgeSlab* slabs;      // Most recently allocated slab first
+    EdgeSlab* currentSlab; // Slab that new nodes are taken from
+    Edge* freeList;       // Nodes returned by removeEdge, linked through next
+    int* degrees;         // List length of every vertex
+    EdgeIndex** indexes;  // Hash index of every vertex above indexThreshold, else nullptr
+    int indexThreshold;
+    ConnectivityIndex* connectivity; // nullptr unless connectivity is tracked
+    
+    // Edge node management
+    Edge* allocateEdge(int dest, int weight);
+    void releaseEdge(Edge* edge);
+    void addSlab(int capacity);
+    void releaseSlabs();
+    void copyFrom(const Graph& other);
+    void allocateVertexArrays();
+    void releaseVertexArrays();
+    
+    // List maintenance that keeps the indexes up to date
+    void linkFront(int vertex, Edge* edge);
+    void unlink(int vertex, Edge** link);
+    Edge** findLink(int vertex, int dest) const;
+    bool searchFromDest(int source, int dest) const;
+    int reweight(int vertex, int dest, int weight);
+    
+    // Hash index management
+    void buildIndex(int vertex);
+    void dropIndex(int vertex);
+    static void indexInsert(EdgeIndex* index, int dest, Edge** link);
+    static IndexEntry* indexFind(const EdgeIndex* index, int dest);
+    void relinkIndexed(EdgeIndex* index, Edge* edge, Edge** oldLink, Edge** newLink);
+    static void indexRehash(EdgeIndex* index, int capacity);
 };
 
 } // namespace graph
@@ -0,0 +1,196 @@
+// graphfile.cpp
+#include "GraphFile.hpp"
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace graph {
+
+const char GRAPH_FILE_MAGIC[8] = { 'G', 'R', 'A', 'P', 'H', 'C', 'S', 'R' };
+const unsigned int BYTE_ORDER_TAG = 0x01020304u;
+const unsigned int SWAPPED_BYTE_ORDER_TAG = 0x04030201u;
+const unsigned long long SECTION_ALIGNMENT = 64;
+
+namespace {
+
+struct GraphFileHeader {
+    char magic[8];
+    unsigned int byteOrder;
+    unsigned int version;
+    int numVertices;
+    int numHalfEdges;
+    unsigned long long offsetsPos;
+    unsigned long long destinationsPos;
+    unsigned long long weightsPos;
+    unsigned long long fileSize;
+    char reserved[8];
+};
+
+static_assert(sizeof(GraphFileHeader) == 64, "Graph file header must be 64 bytes");
+
+unsigned long long alignSection(unsigned long long position) {
+    return (position + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+// Write zero bytes up to the given position
+void padTo(std::ofstream& file, unsigned long long written, unsigned long long position) {
+    static const char zeros[SECTION_ALIGNMENT] = {};
+    file.write(zeros, (std::streamsize)(position - written));
+}
+
+} // namespace
+
+void GraphFile::write(const char* filename, const Graph& g) {
+    CSRGraph csr(g);
+    write(filename, csr);
+}
+
+void GraphFile::write(const char* filename, const CSRGraph& g) {
+    unsigned long long numVertices = (unsigned long long)g.getNumVertices();
+    unsigned long long numHalfEdges = (unsigned long long)g.getNumHalfEdges();
+
+    GraphFileHeader header = {};
+    for (int i = 0; i < 8; i++) {
+        header.magic[i] = GRAPH_FILE_MAGIC[i];
+    }
+    header.byteOrder = BYTE_ORDER_TAG;
+    header.version = GRAPH_FILE_VERSION;
+    header.numVertices = g.getNumVertices();
+    header.numHalfEdges = g.getNumHalfEdges();
+    header.offsetsPos = alignSection(sizeof(GraphFileHeader));
+    header.destinationsPos = alignSection(header.offsetsPos + sizeof(int) * (numVertices + 1));
+    header.weightsPos = alignSection(header.destinationsPos + sizeof(int) * numHalfEdges);
+    header.fileSize = header.weightsPos + sizeof(int) * numHalfEdges;
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw "Cannot open file for writing";
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    padTo(file, sizeof(header), header.offsetsPos);
+    file.write(reinterpret_cast<const char*>(g.getOffsets()), sizeof(int) * (numVertices + 1));
+    padTo(file, header.offsetsPos + sizeof(int) * (numVertices + 1), header.destinationsPos);
+    file.write(reinterpret_cast<const char*>(g.getDestinations()), sizeof(int) * numHalfEdges);
+    padTo(file, header.destinationsPos + sizeof(int) * numHalfEdges, header.weightsPos);
+    file.write(reinterpret_cast<const char*>(g.getWeights()), sizeof(int) * numHalfEdges);
+
+    if (!file) {
+        throw "Cannot write file";
+    }
+}
+
+// Map the file, check it and return a view of its arrays. On failure the mapping
+// is undone before throwing.
+static CSRGraph mapGraphFile(const char* filename, bool checkDestinations, void*& data, long long& size) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        throw "Cannot open file for reading";
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(GraphFileHeader)) {
+        close(fd);
+        throw "Invalid graph file";
+    }
+    size = (long long)info.st_size;
+
+    // A shared read-only mapping: every process mapping the file uses the same pages
+    data = mmap(nullptr, (size_t)size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        data = nullptr;
+        throw "Cannot map file";
+    }
+
+    const char* error = nullptr;
+    const char* bytes = static_cast<const char*>(data);
+    const GraphFileHeader* header = reinterpret_cast<const GraphFileHeader*>(bytes);
+
+    for (int i = 0; i < 8 && !error; i++) {
+        if (header->magic[i] != GRAPH_FILE_MAGIC[i]) {
+            error = "Invalid graph file";
+        }
+    }
+    if (!error && header->byteOrder == SWAPPED_BYTE_ORDER_TAG) {
+        error = "Graph file has the wrong byte order";
+    } else if (!error && header->byteOrder != BYTE_ORDER_TAG) {
+        error = "Invalid graph file";
+    } else if (!error && header->version != GRAPH_FILE_VERSION) {
+        error = "Unsupported graph file version";
+    }
+
+    // Every section must lie inside the file and be aligned for int access
+    if (!error) {
+        unsigned long long n = (unsigned long long)header->numVertices;
+        unsigned long long h = (unsigned long long)header->numHalfEdges;
+        if (header->numVertices <= 0 || header->numHalfEdges < 0 ||
+            header->fileSize != (unsigned long long)size ||
+            header->offsetsPos % sizeof(int) != 0 || header->destinationsPos % sizeof(int) != 0 ||
+            header->weightsPos % sizeof(int) != 0 ||
+            header->offsetsPos < sizeof(GraphFileHeader) || header->destinationsPos < sizeof(GraphFileHeader) ||
+            header->weightsPos < sizeof(GraphFileHeader) ||
+            header->offsetsPos > header->fileSize || header->fileSize - header->offsetsPos < sizeof(int) * (n + 1) ||
+            header->destinationsPos > header->fileSize || header->fileSize - header->destinationsPos < sizeof(int) * h ||
+            header->weightsPos > header->fileSize || header->fileSize - header->weightsPos < sizeof(int) * h) {
+            error = "Invalid graph file";
+        }
+    }
+
+    const int* offsets = nullptr;
+    const int* destinations = nullptr;
+    const int* weights = nullptr;
+    if (!error) {
+        offsets = reinterpret_cast<const int*>(bytes + header->offsetsPos);
+        destinations = reinterpret_cast<const int*>(bytes + header->destinationsPos);
+        weights = reinterpret_cast<const int*>(bytes + header->weightsPos);
+
+        int n = header->numVertices;
+        if (offsets[0] != 0 || offsets[n] != header->numHalfEdges) {
+            error = "Invalid graph file";
+        }
+        for (int v = 0; !error && v < n; v++) {
+            if (offsets[v + 1] < offsets[v]) {
+                error = "Invalid graph file";
+            }
+        }
+        for (int i = 0; checkDestinations && !error && i < header->numHalfEdges; i++) {
+            if (destinations[i] < 0 || destinations[i] >= n) {
+                error = "Invalid graph file";
+            }
+        }
+    }
+
+    if (error) {
+        munmap(data, (size_t)size);
+        data = nullptr;
+        throw error;
+    }
+
+    return CSRGraph::view(header->numVertices, header->numHalfEdges, offsets, destinations, weights);
+}
+
+MappedGraph::MappedGraph(const char* filename, bool checkDestinations)
+    : data(nullptr), size(0), graph(mapGraphFile(filename, checkDestinations, data, size)) {}
+
+MappedGraph::~MappedGraph() {
+    if (data) {
+        munmap(data, (size_t)size);
+    }
+}
+
+const CSRGraph& MappedGraph::getGraph() const {
+    return graph;
+}
+
+int MappedGraph::getNumVertices() const {
+    return graph.getNumVertices();
+}
+
+long long MappedGraph::getFileSize() const {
+    return size;
+}
+
+} // namespace graph
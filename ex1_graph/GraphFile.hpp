@@ -0,0 +1,66 @@
+// graphfile.hpp
+#ifndef GRAPHFILE_HPP
+#define GRAPHFILE_HPP
+
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+
+namespace graph {
+
+// Binary graph file, laid out so that it can be mapped and used in place:
+//
+//   header (64 bytes)
+//     magic        8 bytes  "GRAPHCSR"
+//     byteOrder    uint32   0x01020304 as written by the producing machine
+//     version      uint32   GRAPH_FILE_VERSION
+//     numVertices  int32
+//     numHalfEdges int32    every undirected edge is stored twice, as in CSRGraph
+//     offsetsPos, destinationsPos, weightsPos, fileSize   uint64 byte positions
+//   offsets        int32[numVertices + 1]
+//   destinations   int32[numHalfEdges]
+//   weights        int32[numHalfEdges]
+//
+// Every section starts on a 64-byte boundary. Integers are stored in the byte
+// order of the writer; a reader with the other byte order rejects the file.
+const unsigned int GRAPH_FILE_VERSION = 1;
+
+class GraphFile {
+public:
+    // Write a graph in the binary format, replacing the file if it exists
+    static void write(const char* filename, const Graph& g);
+    static void write(const char* filename, const CSRGraph& g);
+};
+
+// A graph file mapped read-only into memory. The CSR graph it hands out reads the
+// mapped pages directly, so opening costs no parsing or copying, and processes
+// mapping the same file share one copy in the page cache.
+class MappedGraph {
+public:
+    // Map a file and check it: the header, that the offsets never decrease, and,
+    // unless checkDestinations is false, that every destination is a vertex. Skipping
+    // the destinations saves reading the whole file, but then only a file known to
+    // be intact is safe to traverse. No check verifies that every edge is stored in
+    // both directions, as GraphFile writes them; algorithms on a file that breaks
+    // this see the arcs it does hold, one-way ones included.
+    explicit MappedGraph(const char* filename, bool checkDestinations = true);
+    ~MappedGraph();
+
+    // View of the mapped arrays - valid while this object exists
+    const CSRGraph& getGraph() const;
+
+    int getNumVertices() const;
+    long long getFileSize() const;
+
+private:
+    void* data;
+    long long size;
+    CSRGraph graph;
+
+    // Mappings are never copied
+    MappedGraph(const MappedGraph&);
+    MappedGraph& operator=(const MappedGraph&);
+};
+
+} // namespace graph
+
+#endif // GRAPHFILE_HPP
@@ -0,0 +1,507 @@
+// graphreader.cpp
+#include "GraphReader.hpp"
+#include "Parallel.hpp"
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace graph {
+
+namespace {
+
+// Growable array of edges owned by one thread
+class EdgeBuffer {
+public:
+    EdgeBuffer() : data(new WeightedEdge[64]), size(0), capacity(64) {}
+
+    ~EdgeBuffer() {
+        delete[] data;
+    }
+
+    void push(int source, int dest, int weight) {
+        if (size == capacity) {
+            grow(capacity * 2);
+        }
+        data[size].source = source;
+        data[size].dest = dest;
+        data[size].weight = weight;
+        size++;
+    }
+
+    void append(const EdgeBuffer& other) {
+        if (size + other.size > capacity) {
+            grow(capacity * 2 > size + other.size ? capacity * 2 : size + other.size);
+        }
+        for (int i = 0; i < other.size; i++) {
+            data[size++] = other.data[i];
+        }
+    }
+
+    void clear() {
+        size = 0;
+    }
+
+    int getSize() const {
+        return size;
+    }
+
+    // Hand the array over to the caller, leaving the buffer empty
+    WeightedEdge* release() {
+        WeightedEdge* result = data;
+        data = new WeightedEdge[64];
+        size = 0;
+        capacity = 64;
+        return result;
+    }
+
+private:
+    WeightedEdge* data;
+    int size;
+    int capacity;
+
+    void grow(int newCapacity) {
+        WeightedEdge* bigger = new WeightedEdge[newCapacity];
+        for (int i = 0; i < size; i++) {
+            bigger[i] = data[i];
+        }
+        delete[] data;
+        data = bigger;
+        capacity = newCapacity;
+    }
+
+    EdgeBuffer(const EdgeBuffer&);
+    EdgeBuffer& operator=(const EdgeBuffer&);
+};
+
+// What one thread found in its piece of a block
+struct PieceResult {
+    EdgeBuffer edges;
+    int maxVertex;         // Largest 0-based vertex seen, -1 if none
+    int declaredVertices;  // From a DIMACS problem line, -1 if none
+    const char* error;
+};
+
+// Settings shared by all pieces of one file
+struct ParseSettings {
+    EdgeListFormat format;
+    bool dropReverse;
+    bool hasValues;    // Matrix Market: false for "pattern" files
+    bool realValues;   // Matrix Market: values may have a fraction or exponent
+};
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Parse an optionally signed decimal integer at p and move p past it.
+// Returns false (with p past the blanks) if there is no number.
+bool parseInteger(const char*& p, long long& value) {
+    while (isBlank(*p)) {
+        p++;
+    }
+    bool negative = *p == '-';
+    const char* start = p;
+    if (*p == '-' || *p == '+') {
+        p++;
+    }
+    if (*p < '0' || *p > '9') {
+        p = start;
+        return false;
+    }
+
+    long long v = 0;
+    while (*p >= '0' && *p <= '9') {
+        if (v < 100000000000LL) { // Larger values are out of range anyway
+            v = v * 10 + (*p - '0');
+        }
+        p++;
+    }
+    value = negative ? -v : v;
+    return true;
+}
+
+// Parse a Matrix Market value, rounding real values to the nearest integer
+bool parseValue(const char*& p, bool realValues, long long& value) {
+    while (isBlank(*p)) {
+        p++;
+    }
+    if (!realValues) {
+        return parseInteger(p, value);
+    }
+
+    // strtod would skip the newline, so check that a number starts here first
+    if (!((*p >= '0' && *p <= '9') || *p == '-' || *p == '+' || *p == '.')) {
+        return false;
+    }
+    char* end;
+    double real = std::strtod(p, &end);
+    if (end == p) {
+        return false;
+    }
+    p = end;
+    if (real > 1e11 || real < -1e11) {
+        real = real > 0 ? 1e11 : -1e11;
+    }
+    value = (long long)(real < 0 ? real - 0.5 : real + 0.5);
+    return true;
+}
+
+// After the last field of a line: true if only blanks follow, up to the end of
+// the line or a comment starting with one of the given characters
+bool atLineEnd(const char* p, const char* commentChars) {
+    while (isBlank(*p)) {
+        p++;
+    }
+    return *p == '\n' || (*p != '\0' && std::strchr(commentChars, *p) != nullptr);
+}
+
+// Check and store one edge. Vertices are already 0-based.
+const char* addEdge(PieceResult& result, const ParseSettings& settings, long long u, long long v, long long w) {
+    if (u < 0 || v < 0 || u >= INT_MAX || v >= INT_MAX) {
+        return "Vertex index out of range";
+    }
+    if (w < INT_MIN || w > INT_MAX) {
+        return "Weight out of range";
+    }
+    if (settings.dropReverse && u > v) {
+        return nullptr;
+    }
+
+    result.edges.push((int)u, (int)v, (int)w);
+    if (u > result.maxVertex) {
+        result.maxVertex = (int)u;
+    }
+    if (v > result.maxVertex) {
+        result.maxVertex = (int)v;
+    }
+    return nullptr;
+}
+
+// Parse one line (p points at its start, the line ends with '\n')
+const char* parseLine(const char* p, PieceResult& result, const ParseSettings& settings) {
+    while (isBlank(*p)) {
+        p++;
+    }
+    if (*p == '\n') {
+        return nullptr; // Empty line
+    }
+
+    long long u;
+    long long v;
+    long long w = 1;
+
+    switch (settings.format) {
+    case FORMAT_SNAP:
+        if (*p == '#' || *p == '%') {
+            return nullptr;
+        }
+        if (!parseInteger(p, u) || !parseInteger(p, v)) {
+            return "Invalid SNAP line";
+        }
+        parseInteger(p, w); // The weight column is optional
+        if (!atLineEnd(p, "#%")) {
+            return "Invalid SNAP line";
+        }
+        return addEdge(result, settings, u, v, w);
+
+    case FORMAT_DIMACS:
+        if (*p == 'c') {
+            return nullptr;
+        }
+        if (*p == 'p') {
+            // "p sp <vertices> <arcs>"
+            p++;
+            while (isBlank(*p)) {
+                p++;
+            }
+            while (*p != '\n' && !isBlank(*p)) {
+                p++;
+            }
+            long long n;
+            long long m;
+            if (!parseInteger(p, n) || !parseInteger(p, m) || !atLineEnd(p, "") || n <= 0 || n >= INT_MAX) {
+                return "Invalid DIMACS problem line";
+            }
+            result.declaredVertices = (int)n;
+            return nullptr;
+        }
+        if (*p != 'a') {
+            return "Invalid DIMACS line";
+        }
+        p++;
+        if (!parseInteger(p, u) || !parseInteger(p, v) || !parseInteger(p, w) || !atLineEnd(p, "")) {
+            return "Invalid DIMACS line";
+        }
+        return addEdge(result, settings, u - 1, v - 1, w);
+
+    case FORMAT_MATRIX_MARKET:
+        if (*p == '%') {
+            return nullptr;
+        }
+        if (!parseInteger(p, u) || !parseInteger(p, v) ||
+            (settings.hasValues && !parseValue(p, settings.realValues, w)) || !atLineEnd(p, "%")) {
+            return "Invalid Matrix Market line";
+        }
+        return addEdge(result, settings, u - 1, v - 1, w);
+    }
+    return nullptr;
+}
+
+// Parse the lines in [begin, end); end directly follows a '\n'
+void parsePiece(const char* begin, const char* end, PieceResult& result, const ParseSettings& settings) {
+    const char* p = begin;
+    while (p < end && !result.error) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        result.error = parseLine(p, result, settings);
+        p = lineEnd + 1;
+    }
+}
+
+// Compare the next word at p with a lowercase keyword, ignoring case
+bool matchWord(const char*& p, const char* keyword) {
+    while (isBlank(*p)) {
+        p++;
+    }
+    const char* q = p;
+    for (; *keyword; keyword++, q++) {
+        char c = *q >= 'A' && *q <= 'Z' ? (char)(*q - 'A' + 'a') : *q;
+        if (c != *keyword) {
+            return false;
+        }
+    }
+    if (*q != '\n' && !isBlank(*q)) {
+        return false;
+    }
+    p = q;
+    return true;
+}
+
+// Matrix Market header, read line by line before the parallel part.
+// Returns an error, or nullptr; done is set once the size line has been read.
+const char* parseMatrixMarketHeader(const char*& p, const char* end, bool& sawBanner, bool& done,
+                                    ParseSettings& settings, int& numVertices) {
+    while (p < end && !done) {
+        const char* line = p;
+        p = static_cast<const char*>(std::memchr(p, '\n', end - p)) + 1;
+
+        if (!sawBanner) {
+            // "%%MatrixMarket matrix coordinate <field> <symmetry>"
+            if (std::strncmp(line, "%%MatrixMarket", 14) != 0) {
+                return "Invalid Matrix Market banner";
+            }
+            line += 14;
+            if (!matchWord(line, "matrix") || !matchWord(line, "coordinate")) {
+                return "Unsupported Matrix Market file";
+            }
+            if (matchWord(line, "pattern")) {
+                settings.hasValues = false;
+            } else if (matchWord(line, "integer")) {
+                settings.realValues = false;
+            } else if (!matchWord(line, "real")) {
+                return "Unsupported Matrix Market file";
+            }
+            if (!matchWord(line, "general") && !matchWord(line, "symmetric")) {
+                return "Unsupported Matrix Market file";
+            }
+            sawBanner = true;
+            continue;
+        }
+
+        while (isBlank(*line)) {
+            line++;
+        }
+        if (*line == '%' || *line == '\n') {
+            continue;
+        }
+
+        // Size line: "<rows> <columns> <entries>"
+        long long rows;
+        long long columns;
+        long long entries;
+        if (!parseInteger(line, rows) || !parseInteger(line, columns) || !parseInteger(line, entries) ||
+            !atLineEnd(line, "%") || rows <= 0 || rows >= INT_MAX || entries < 0) {
+            return "Invalid Matrix Market size line";
+        }
+        if (rows != columns) {
+            return "Matrix Market graph must be square";
+        }
+        numVertices = (int)rows;
+        done = true;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+WeightedEdge* GraphReader::readEdges(const char* filename, EdgeListFormat format, const ReaderOptions& options,
+                                     int& numVertices, int& edgeCount) {
+    if (options.numThreads <= 0) {
+        throw "Number of threads must be positive";
+    }
+    if (options.blockSize <= 0) {
+        throw "Block size must be positive";
+    }
+
+    FILE* file = std::fopen(filename, "rb");
+    if (!file) {
+        throw "Cannot open file for reading";
+    }
+
+    int threads = options.numThreads;
+    ParseSettings settings = { format, options.dropReverseDuplicates, true, true };
+    bool headerDone = format != FORMAT_MATRIX_MARKET;
+    bool sawBanner = false;
+    int headerVertices = -1;
+
+    // One extra byte so that a last line without '\n' can be terminated
+    size_t capacity = (size_t)options.blockSize * threads;
+    char* buffer = new char[capacity + 1];
+    size_t carried = 0;
+
+    PieceResult* results = new PieceResult[threads];
+    EdgeBuffer all;
+    int maxVertex = -1;
+    int declaredVertices = -1;
+    const char* error = nullptr;
+
+    while (!error) {
+        size_t got = std::fread(buffer + carried, 1, capacity - carried, file);
+        size_t length = carried + got;
+        bool atEnd = got < capacity - carried;
+        if (length == 0) {
+            break;
+        }
+
+        // Only whole lines are parsed now; a partial last line moves to the next block
+        size_t usable;
+        if (atEnd) {
+            if (buffer[length - 1] != '\n') {
+                buffer[length++] = '\n';
+            }
+            usable = length;
+        } else {
+            usable = length;
+            while (usable > 0 && buffer[usable - 1] != '\n') {
+                usable--;
+            }
+            if (usable == 0) {
+                // A single line longer than the buffer: make room and read on
+                char* bigger = new char[2 * capacity + 1];
+                std::memcpy(bigger, buffer, length);
+                delete[] buffer;
+                buffer = bigger;
+                capacity *= 2;
+                carried = length;
+                continue;
+            }
+        }
+
+        const char* begin = buffer;
+        const char* end = buffer + usable;
+        if (!headerDone) {
+            error = parseMatrixMarketHeader(begin, end, sawBanner, headerDone, settings, headerVertices);
+        }
+
+        // Cut the block at line starts, one piece per thread
+        const char** pieceStart = new const char*[threads + 1];
+        pieceStart[0] = begin;
+        pieceStart[threads] = end;
+        for (int t = 1; t < threads; t++) {
+            const char* p = begin + (end - begin) * t / threads;
+            if (p < pieceStart[t - 1]) {
+                p = pieceStart[t - 1];
+            }
+            while (p > begin && p < end && p[-1] != '\n') {
+                p++;
+            }
+            pieceStart[t] = p;
+        }
+
+        if (!error) {
+            runInParallel(threads, [&](int thread) {
+                results[thread].edges.clear();
+                results[thread].maxVertex = -1;
+                results[thread].declaredVertices = -1;
+                results[thread].error = nullptr;
+                parsePiece(pieceStart[thread], pieceStart[thread + 1], results[thread], settings);
+            });
+        }
+        delete[] pieceStart;
+
+        // Append the pieces in file order
+        for (int t = 0; t < threads && !error; t++) {
+            error = results[t].error;
+            all.append(results[t].edges);
+            if (results[t].maxVertex > maxVertex) {
+                maxVertex = results[t].maxVertex;
+            }
+            if (results[t].declaredVertices != -1) {
+                declaredVertices = results[t].declaredVertices;
+            }
+        }
+
+        carried = length - usable;
+        std::memmove(buffer, buffer + usable, carried);
+        if (atEnd && carried == 0) {
+            break;
+        }
+    }
+
+    std::fclose(file);
+    delete[] buffer;
+    delete[] results;
+
+    // The number of vertices comes from the header, or else from the largest vertex
+    if (!error) {
+        if (format == FORMAT_MATRIX_MARKET) {
+            numVertices = headerDone ? headerVertices : -1;
+            if (!headerDone) {
+                error = "Invalid Matrix Market header";
+            }
+        } else if (format == FORMAT_DIMACS) {
+            numVertices = declaredVertices;
+            if (declaredVertices == -1) {
+                error = "Missing DIMACS problem line";
+            }
+        } else {
+            numVertices = maxVertex + 1;
+            if (numVertices == 0) {
+                error = "Graph file contains no edges";
+            }
+        }
+    }
+    if (!error && maxVertex >= numVertices) {
+        error = "Vertex index out of range";
+    }
+    if (error) {
+        throw error;
+    }
+
+    edgeCount = all.getSize();
+    return all.release();
+}
+
+Graph GraphReader::read(const char* filename, EdgeListFormat format, const ReaderOptions& options) {
+    int numVertices;
+    int edgeCount;
+    WeightedEdge* edges = readEdges(filename, format, options, numVertices, edgeCount);
+
+    Graph g(numVertices, edges, edgeCount);
+    delete[] edges;
+    return g;
+}
+
+Graph GraphReader::readSnap(const char* filename, const ReaderOptions& options) {
+    return read(filename, FORMAT_SNAP, options);
+}
+
+Graph GraphReader::readDimacs(const char* filename, const ReaderOptions& options) {
+    return read(filename, FORMAT_DIMACS, options);
+}
+
+Graph GraphReader::readMatrixMarket(const char* filename, const ReaderOptions& options) {
+    return read(filename, FORMAT_MATRIX_MARKET, options);
+}
+
+} // namespace graph
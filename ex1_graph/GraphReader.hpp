@@ -0,0 +1,49 @@
+// graphreader.hpp
+#ifndef GRAPHREADER_HPP
+#define GRAPHREADER_HPP
+
+#include "Graph.hpp"
+
+namespace graph {
+
+// Text formats understood by GraphReader
+enum EdgeListFormat {
+    FORMAT_SNAP,           // "u v [w]" per line, '#' or '%' comments, 0-based vertices
+    FORMAT_DIMACS,         // DIMACS shortest-path .gr: "p sp n m", "a u v w", 'c' comments, 1-based
+    FORMAT_MATRIX_MARKET   // Matrix Market coordinate: banner, size line, "i j [value]", 1-based
+};
+
+struct ReaderOptions {
+    int numThreads;             // Threads parsing each block
+    int blockSize;              // Bytes of text per thread and block
+    bool dropReverseDuplicates; // Keep an edge only if source <= dest - for files that
+                                // list every undirected edge in both directions
+
+    ReaderOptions(int threads = 1, bool dropReverse = false)
+        : numThreads(threads), blockSize(1 << 22), dropReverseDuplicates(dropReverse) {}
+};
+
+// Streaming readers for edge-list files.
+// The file is read one block at a time; each block is cut at line boundaries
+// into one piece per thread, and the threads parse their pieces into private edge
+// buffers that are appended in file order. Only the edge list is kept in memory,
+// never the whole text. Integers are parsed by hand; Matrix Market real values
+// are rounded to the nearest integer weight.
+class GraphReader {
+public:
+    static Graph readSnap(const char* filename, const ReaderOptions& options = ReaderOptions());
+    static Graph readDimacs(const char* filename, const ReaderOptions& options = ReaderOptions());
+    static Graph readMatrixMarket(const char* filename, const ReaderOptions& options = ReaderOptions());
+
+    // The parsed edges with 0-based vertices, for building other representations.
+    // The caller deletes the returned array with delete[].
+    static WeightedEdge* readEdges(const char* filename, EdgeListFormat format, const ReaderOptions& options,
+                                   int& numVertices, int& edgeCount);
+
+private:
+    static Graph read(const char* filename, EdgeListFormat format, const ReaderOptions& options);
+};
+
+} // namespace graph
+
+#endif // GRAPHREADER_HPP
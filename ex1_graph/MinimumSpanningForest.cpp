@@ -0,0 +1,459 @@
+// minimumspanningforest.cpp
+#include "MinimumSpanningForest.hpp"
+#include "Algorithms.hpp"
+#include <climits>
+
+namespace graph {
+
+MinimumSpanningForest::MinimumSpanningForest(const Graph& g)
+    : graph(g), numVertices(g.getNumVertices()), numEdges(0), totalWeight(0), freeCount(0), epoch(0) {
+    int numNodes = 2 * numVertices - 1;
+    child[0] = new int[numNodes];
+    child[1] = new int[numNodes];
+    parent = new int[numNodes];
+    flipped = new bool[numNodes];
+    heaviest = new int[numNodes];
+    splayStack = new int[numNodes];
+    for (int i = 0; i < numNodes; i++) {
+        child[0][i] = -1;
+        child[1][i] = -1;
+        parent[i] = -1;
+        flipped[i] = false;
+        heaviest[i] = i;
+    }
+
+    edges = new ForestEdge[numVertices - 1];
+    freeSlots = new int[numVertices - 1];
+    for (int slot = numVertices - 2; slot >= 0; slot--) {
+        freeSlots[freeCount++] = slot;
+    }
+    firstEdge = new int[numVertices];
+    marks = new unsigned int[numVertices];
+    queues = new int[2 * (long long)numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        firstEdge[i] = -1;
+        marks[i] = 0;
+    }
+
+    // Start from Kruskal's forest. Every tree hangs from its first vertex by plain
+    // parent pointers, which is a valid link-cut tree with no preferred paths yet.
+    Graph forest(numVertices);
+    Algorithms::kruskal(g, forest);
+    for (int root = 0; root < numVertices; root++) {
+        if (marks[root] != 0) {
+            continue;
+        }
+        int head = 0;
+        int tail = 0;
+        queues[tail++] = root;
+        marks[root] = 1;
+        while (head < tail) {
+            int x = queues[head++];
+            for (Graph::Edge* edge = forest.getAdjList(x); edge; edge = edge->next) {
+                int y = edge->destination;
+                if (marks[y] == 0) {
+                    marks[y] = 1;
+                    queues[tail++] = y;
+                    int node = numVertices + addForestEdge(x, y, edge->weight);
+                    parent[y] = node;
+                    parent[node] = x;
+                }
+            }
+        }
+    }
+}
+
+MinimumSpanningForest::~MinimumSpanningForest() {
+    delete[] child[0];
+    delete[] child[1];
+    delete[] parent;
+    delete[] flipped;
+    delete[] heaviest;
+    delete[] splayStack;
+    delete[] edges;
+    delete[] freeSlots;
+    delete[] firstEdge;
+    delete[] marks;
+    delete[] queues;
+}
+
+// Link-cut tree. Vertex nodes carry no weight and lose against every edge node.
+
+bool MinimumSpanningForest::heavier(int a, int b) const {
+    if (a < numVertices) {
+        return false;
+    }
+    return b < numVertices || edges[a - numVertices].weight > edges[b - numVertices].weight;
+}
+
+bool MinimumSpanningForest::isSplayRoot(int node) const {
+    int up = parent[node];
+    return up == -1 || (child[0][up] != node && child[1][up] != node);
+}
+
+void MinimumSpanningForest::update(int node) {
+    int best = node;
+    for (int side = 0; side < 2; side++) {
+        int below = child[side][node];
+        if (below != -1 && heavier(heaviest[below], best)) {
+            best = heaviest[below];
+        }
+    }
+    heaviest[node] = best;
+}
+
+void MinimumSpanningForest::pushDown(int node) {
+    if (flipped[node]) {
+        int temp = child[0][node];
+        child[0][node] = child[1][node];
+        child[1][node] = temp;
+        for (int side = 0; side < 2; side++) {
+            if (child[side][node] != -1) {
+                flipped[child[side][node]] = !flipped[child[side][node]];
+            }
+        }
+        flipped[node] = false;
+    }
+}
+
+void MinimumSpanningForest::rotate(int node) {
+    int up = parent[node];
+    int top = parent[up];
+    int side = child[1][up] == node ? 1 : 0;
+
+    if (!isSplayRoot(up)) {
+        child[child[0][top] == up ? 0 : 1][top] = node;
+    }
+    parent[node] = top;
+
+    child[side][up] = child[1 - side][node];
+    if (child[side][up] != -1) {
+        parent[child[side][up]] = up;
+    }
+    child[1 - side][node] = up;
+    parent[up] = node;
+
+    update(up);
+    update(node);
+}
+
+// Bring a node to the root of its splay tree. Pending reversals are pushed down
+// from the top first, without recursion.
+void MinimumSpanningForest::splay(int node) {
+    int count = 0;
+    int x = node;
+    splayStack[count++] = x;
+    while (!isSplayRoot(x)) {
+        x = parent[x];
+        splayStack[count++] = x;
+    }
+    while (count > 0) {
+        pushDown(splayStack[--count]);
+    }
+
+    while (!isSplayRoot(node)) {
+        int up = parent[node];
+        if (!isSplayRoot(up)) {
+            int top = parent[up];
+            bool sameSide = (child[0][top] == up) == (child[0][up] == node);
+            rotate(sameSide ? up : node);
+        }
+        rotate(node);
+    }
+}
+
+// Make the path from the root of the node's tree to the node preferred, with the
+// node at the root of its splay tree
+void MinimumSpanningForest::access(int node) {
+    int last = -1;
+    for (int x = node; x != -1; x = parent[x]) {
+        splay(x);
+        child[1][x] = last;
+        update(x);
+        last = x;
+    }
+    splay(node);
+}
+
+void MinimumSpanningForest::makeRoot(int node) {
+    access(node);
+    flipped[node] = !flipped[node];
+}
+
+int MinimumSpanningForest::findRoot(int node) {
+    access(node);
+    int x = node;
+    while (true) {
+        pushDown(x);
+        if (child[0][x] == -1) {
+            break;
+        }
+        x = child[0][x];
+    }
+    splay(x);
+    return x;
+}
+
+// Node of the heaviest edge between two vertices of one tree, or a vertex node if
+// the path has no edges
+int MinimumSpanningForest::heaviestOnPath(int u, int v) {
+    makeRoot(u);
+    access(v);
+    return heaviest[v];
+}
+
+// Forest edges
+
+// Take a free slot for a new forest edge and put it into the lists of both ends.
+// Its link-cut node starts out alone.
+int MinimumSpanningForest::addForestEdge(int u, int v, int weight) {
+    int slot = freeSlots[--freeCount];
+    ForestEdge& edge = edges[slot];
+    edge.ends[0] = u;
+    edge.ends[1] = v;
+    edge.weight = weight;
+
+    // Put the edge at the front of the lists of both ends
+    for (int end = 0; end < 2; end++) {
+        int vertex = edge.ends[end];
+        int first = firstEdge[vertex];
+        edge.next[end] = first;
+        edge.prev[end] = -1;
+        if (first != -1) {
+            edges[first].prev[edges[first].ends[0] == vertex ? 0 : 1] = slot;
+        }
+        firstEdge[vertex] = slot;
+    }
+
+    int node = numVertices + slot;
+    child[0][node] = -1;
+    child[1][node] = -1;
+    parent[node] = -1;
+    flipped[node] = false;
+    heaviest[node] = node;
+
+    numEdges++;
+    totalWeight += weight;
+    return slot;
+}
+
+void MinimumSpanningForest::link(int u, int v, int weight) {
+    int node = numVertices + addForestEdge(u, v, weight);
+    makeRoot(u);
+    parent[u] = node;
+    makeRoot(node);
+    parent[node] = v;
+}
+
+void MinimumSpanningForest::cut(int slot) {
+    ForestEdge& edge = edges[slot];
+    int node = numVertices + slot;
+
+    // With one end as the root, the other end's splay tree is exactly the two nodes
+    for (int end = 0; end < 2; end++) {
+        int from = end == 0 ? edge.ends[0] : node;
+        int to = end == 0 ? node : edge.ends[1];
+        makeRoot(from);
+        access(to);
+        child[0][to] = -1;
+        parent[from] = -1;
+        update(to);
+    }
+
+    for (int end = 0; end < 2; end++) {
+        int vertex = edge.ends[end];
+        int before = edge.prev[end];
+        int after = edge.next[end];
+        if (before != -1) {
+            edges[before].next[edges[before].ends[0] == vertex ? 0 : 1] = after;
+        } else {
+            firstEdge[vertex] = after;
+        }
+        if (after != -1) {
+            edges[after].prev[edges[after].ends[0] == vertex ? 0 : 1] = before;
+        }
+    }
+
+    freeSlots[freeCount++] = slot;
+    numEdges--;
+    totalWeight -= edge.weight;
+}
+
+// Slot of the forest edge between u and v, or -1. Both lists are walked in step.
+int MinimumSpanningForest::findForestEdge(int u, int v) const {
+    int atU = firstEdge[u];
+    int atV = firstEdge[v];
+    while (atU != -1 || atV != -1) {
+        if (atU != -1) {
+            int end = edges[atU].ends[0] == u ? 0 : 1;
+            if (edges[atU].ends[1 - end] == v) {
+                return atU;
+            }
+            atU = edges[atU].next[end];
+        }
+        if (atV != -1) {
+            int end = edges[atV].ends[0] == v ? 0 : 1;
+            if (edges[atV].ends[1 - end] == u) {
+                return atV;
+            }
+            atV = edges[atV].next[end];
+        }
+    }
+    return -1;
+}
+
+// u and v were just separated. Search both halves in step along forest edges; the
+// half that runs out first is the smaller one, and the lightest graph edge leaving
+// it (if any) joins the halves again.
+void MinimumSpanningForest::reconnect(int u, int v) {
+    if (epoch > 4294967292u) {
+        for (int i = 0; i < numVertices; i++) {
+            marks[i] = 0;
+        }
+        epoch = 0;
+    }
+    epoch += 2;
+
+    int* queue[2] = { queues, queues + numVertices };
+    int head[2] = { 0, 0 };
+    int tail[2] = { 1, 1 };
+    queue[0][0] = u;
+    queue[1][0] = v;
+    marks[u] = epoch;
+    marks[v] = epoch + 1;
+
+    int side = 0;
+    while (head[side] < tail[side]) {
+        int x = queue[side][head[side]++];
+        for (int slot = firstEdge[x]; slot != -1;) {
+            int end = edges[slot].ends[0] == x ? 0 : 1;
+            int other = edges[slot].ends[1 - end];
+            if (marks[other] != epoch + side) {
+                marks[other] = epoch + side;
+                queue[side][tail[side]++] = other;
+            }
+            slot = edges[slot].next[end];
+        }
+        side = 1 - side;
+    }
+
+    int from = -1;
+    int to = -1;
+    int weight = 0;
+    for (int i = 0; i < tail[side]; i++) {
+        int x = queue[side][i];
+        for (Graph::Edge* edge = graph.getAdjList(x); edge; edge = edge->next) {
+            if (marks[edge->destination] != epoch + side && (from == -1 || edge->weight < weight)) {
+                from = x;
+                to = edge->destination;
+                weight = edge->weight;
+            }
+        }
+    }
+    if (from != -1) {
+        link(from, to, weight);
+    }
+}
+
+void MinimumSpanningForest::edgeAdded(int u, int v, int weight) {
+    checkVertex(u);
+    checkVertex(v);
+    if (u == v) {
+        return;
+    }
+
+    if (findRoot(u) != findRoot(v)) {
+        link(u, v, weight);
+        return;
+    }
+
+    // The edge closes a cycle; it replaces the heaviest edge there if lighter
+    int node = heaviestOnPath(u, v);
+    if (node >= numVertices && edges[node - numVertices].weight > weight) {
+        cut(node - numVertices);
+        link(u, v, weight);
+    }
+}
+
+void MinimumSpanningForest::edgeRemoved(int u, int v) {
+    checkVertex(u);
+    checkVertex(v);
+    if (u == v) {
+        return;
+    }
+
+    int slot = findForestEdge(u, v);
+    if (slot == -1) {
+        return; // Removing an edge outside the forest changes nothing
+    }
+
+    // A parallel edge of the same weight takes over the forest edge
+    int x = graph.getDegree(u) <= graph.getDegree(v) ? u : v;
+    int y = x == u ? v : u;
+    for (Graph::Edge* edge = graph.getAdjList(x); edge; edge = edge->next) {
+        if (edge->destination == y && edge->weight == edges[slot].weight) {
+            return;
+        }
+    }
+
+    cut(slot);
+    reconnect(u, v);
+}
+
+void MinimumSpanningForest::checkVertex(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+}
+
+int MinimumSpanningForest::getNumVertices() const {
+    return numVertices;
+}
+
+int MinimumSpanningForest::getNumEdges() const {
+    return numEdges;
+}
+
+long long MinimumSpanningForest::getTotalWeight() const {
+    return totalWeight;
+}
+
+bool MinimumSpanningForest::connected(int u, int v) {
+    checkVertex(u);
+    checkVertex(v);
+    return u == v || findRoot(u) == findRoot(v);
+}
+
+int MinimumSpanningForest::bottleneck(int u, int v) {
+    if (!connected(u, v)) {
+        throw "Vertices are not connected";
+    }
+    int node = heaviestOnPath(u, v);
+    return node >= numVertices ? edges[node - numVertices].weight : INT_MIN;
+}
+
+Graph MinimumSpanningForest::toGraph() const {
+    Graph result(numVertices);
+    toGraph(result);
+    return result;
+}
+
+void MinimumSpanningForest::toGraph(Graph& result) const {
+    if (result.getNumVertices() == numVertices) {
+        result.clear();
+    } else {
+        result = Graph(numVertices);
+    }
+
+    for (int x = 0; x < numVertices; x++) {
+        for (int slot = firstEdge[x]; slot != -1;) {
+            int end = edges[slot].ends[0] == x ? 0 : 1;
+            if (end == 0) {
+                result.addEdge(x, edges[slot].ends[1], edges[slot].weight);
+            }
+            slot = edges[slot].next[end];
+        }
+    }
+}
+
+} // namespace graph
@@ -0,0 +1,109 @@
+// minimumspanningforest.hpp
+#ifndef MINIMUMSPANNINGFOREST_HPP
+#define MINIMUMSPANNINGFOREST_HPP
+
+#include "Graph.hpp"
+
+namespace graph {
+
+// Minimum spanning forest of a graph that changes, kept up to date instead of
+// being rebuilt by prim or kruskal.
+//
+// The forest lives in a link-cut tree where every forest edge is a node of its own
+// carrying its weight, so the heaviest edge on the path between two vertices is
+// found in O(log V) amortized.
+// - An added edge that joins two trees is linked in. One that closes a cycle
+//   replaces the heaviest edge on the cycle if it is lighter. O(log V) amortized.
+// - A removed forest edge splits its tree. The two halves are searched from both
+//   ends at once along the forest edges until the smaller one is known, and the
+//   lightest graph edge leaving the smaller half reconnects them. That costs the
+//   edges of the smaller half, not of the graph.
+//
+// The caller changes the graph and reports the change. The graph must outlive the
+// forest and keep its number of vertices. The link-cut tree is restructured by
+// queries too, so a forest serves one caller at a time.
+class MinimumSpanningForest {
+public:
+    // The forest of the graph's current edges
+    explicit MinimumSpanningForest(const Graph& g);
+    ~MinimumSpanningForest();
+
+    // An edge of the given weight was added to the graph
+    void edgeAdded(int u, int v, int weight);
+
+    // An edge between u and v was removed from the graph. After Graph::setWeight,
+    // call edgeRemoved and then edgeAdded with the new weight.
+    void edgeRemoved(int u, int v);
+
+    int getNumVertices() const;
+    int getNumEdges() const;       // Forest edges - numVertices minus the number of trees
+    long long getTotalWeight() const;
+    bool connected(int u, int v);
+
+    // Weight of the heaviest forest edge between u and v: the smallest threshold at
+    // which single-linkage clustering puts them together. INT_MIN if u == v.
+    int bottleneck(int u, int v);
+
+    // The forest as a graph
+    Graph toGraph() const;
+    void toGraph(Graph& result) const;
+
+private:
+    // A forest edge; its link-cut node is numVertices + its slot
+    struct ForestEdge {
+        int ends[2];
+        int weight;
+        int next[2];  // Forest edges at ends[0] and ends[1]
+        int prev[2];
+    };
+
+    const Graph& graph;
+    int numVertices;
+    int numEdges;
+    long long totalWeight;
+
+    // Link-cut tree over 2 * numVertices - 1 nodes: splay trees of preferred paths,
+    // with a lazy reversal flag and the node of the heaviest edge in each subtree
+    int* child[2];
+    int* parent;
+    bool* flipped;
+    int* heaviest;
+    int* splayStack;
+
+    // Forest edges by slot, the free slots, and the first forest edge at every vertex
+    ForestEdge* edges;
+    int* freeSlots;
+    int freeCount;
+    int* firstEdge;
+
+    // Workspace of a replacement search (and of the constructor, which marks with 1)
+    unsigned int* marks;
+    unsigned int epoch;
+    int* queues;
+
+    bool heavier(int a, int b) const;
+    bool isSplayRoot(int node) const;
+    void update(int node);
+    void pushDown(int node);
+    void rotate(int node);
+    void splay(int node);
+    void access(int node);
+    void makeRoot(int node);
+    int findRoot(int node);
+    int heaviestOnPath(int u, int v);
+
+    int addForestEdge(int u, int v, int weight);
+    void link(int u, int v, int weight);
+    void cut(int slot);
+    int findForestEdge(int u, int v) const;
+    void reconnect(int u, int v);
+    void checkVertex(int vertex) const;
+
+    // Forests are never copied
+    MinimumSpanningForest(const MinimumSpanningForest&);
+    MinimumSpanningForest& operator=(const MinimumSpanningForest&);
+};
+
+} // namespace graph
+
+#endif // MINIMUMSPANNINGFOREST_HPP
@@ -0,0 +1,214 @@
+// parallel.hpp
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+namespace graph {
+
+// Threads started by one runInParallel call. Each worker waits for start() before
+// running its task, so if creating a later thread fails the earlier ones are
+// cancelled instead of entering a task (and possibly a Barrier) with members
+// missing. The first exception stored by fail() is kept for the caller. The
+// destructor cancels workers that have not started and joins every thread, so a
+// group never destroys a joinable std::thread.
+class WorkerGroup {
+private:
+    std::thread* threads;
+    int count;
+    std::mutex mutex;
+    std::condition_variable condition;
+    int state;                // WAITING, RUNNING or CANCELLED
+    std::exception_ptr error;
+
+    enum { WAITING, RUNNING, CANCELLED };
+
+    WorkerGroup(const WorkerGroup&);
+    WorkerGroup& operator=(const WorkerGroup&);
+
+public:
+    WorkerGroup(int capacity) : threads(new std::thread[capacity]), count(0), state(WAITING) {}
+
+    ~WorkerGroup() {
+        join();
+        delete[] threads;
+    }
+
+    template <typename Function>
+    void add(Function function) {
+        threads[count] = std::thread(function);
+        count++;
+    }
+
+    // Called by a worker before its task; false if the group was cancelled
+    bool waitForStart() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (state == WAITING) {
+            condition.wait(lock);
+        }
+        return state == RUNNING;
+    }
+
+    void start() {
+        std::lock_guard<std::mutex> lock(mutex);
+        state = RUNNING;
+        condition.notify_all();
+    }
+
+    void fail(std::exception_ptr exception) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+            error = exception;
+        }
+    }
+
+    // Wait for every thread; workers still waiting are cancelled
+    void join() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (state == WAITING) {
+                state = CANCELLED;
+                condition.notify_all();
+            }
+        }
+        for (int i = 0; i < count; i++) {
+            if (threads[i].joinable()) {
+                threads[i].join();
+            }
+        }
+    }
+
+    std::exception_ptr getError() const {
+        return error;
+    }
+};
+
+// Run task(threadIndex) on numThreads threads and wait for all of them.
+// Thread 0 is the calling thread, so numThreads == 1 starts no thread at all.
+// An exception from any task, or from starting a thread, is rethrown here once
+// every thread has finished. Tasks that meet at a Barrier must not throw between
+// waits: the other threads would wait for the failed one forever.
+template <typename Task>
+void runInParallel(int numThreads, Task task) {
+    if (numThreads <= 0) {
+        throw "Number of threads must be positive";
+    }
+
+    std::exception_ptr error;
+    {
+        WorkerGroup group(numThreads - 1);
+        bool started = true;
+        try {
+            for (int t = 1; t < numThreads; t++) {
+                group.add([&group, task, t]() {
+                    if (group.waitForStart()) {
+                        try {
+                            task(t);
+                        } catch (...) {
+                            group.fail(std::current_exception());
+                        }
+                    }
+                });
+            }
+        } catch (...) {
+            group.fail(std::current_exception());
+            started = false;
+        }
+
+        if (started) {
+            group.start();
+            try {
+                task(0);
+            } catch (...) {
+                group.fail(std::current_exception());
+            }
+        }
+        group.join();
+        error = group.getError();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Reusable barrier for a fixed group of threads
+class Barrier {
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    int count;
+    int waiting;
+    int generation;
+
+public:
+    Barrier(int threads) : count(threads), waiting(0), generation(0) {}
+
+    // Block until every thread of the group has arrived
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        int arrivedGeneration = generation;
+
+        if (++waiting == count) {
+            waiting = 0;
+            generation++;
+            condition.notify_all();
+        } else {
+            while (arrivedGeneration == generation) {
+                condition.wait(lock);
+            }
+        }
+    }
+};
+
+// Growable array of ints owned by a single thread
+class IntBuffer {
+private:
+    int* data;
+    int size;
+    int capacity;
+
+public:
+    IntBuffer() : data(new int[16]), size(0), capacity(16) {}
+
+    ~IntBuffer() {
+        delete[] data;
+    }
+
+    void push(int value) {
+        if (size == capacity) {
+            int* bigger = new int[capacity * 2];
+            for (int i = 0; i < size; i++) {
+                bigger[i] = data[i];
+            }
+            delete[] data;
+            data = bigger;
+            capacity *= 2;
+        }
+        data[size++] = value;
+    }
+
+    void clear() {
+        size = 0;
+    }
+
+    int getSize() const {
+        return size;
+    }
+
+    const int* getData() const {
+        return data;
+    }
+
+private:
+    // Buffers are never copied
+    IntBuffer(const IntBuffer&);
+    IntBuffer& operator=(const IntBuffer&);
+};
+
+} // namespace graph
+
+#endif // PARALLEL_HPP
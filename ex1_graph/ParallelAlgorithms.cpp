@@ -0,0 +1,783 @@
+// parallelalgorithms.cpp
+#include "Algorithms.hpp"
+#include "Parallel.hpp"
+#include "Utils.hpp"
+#include <atomic>
+#include <climits>
+
+namespace graph {
+
+// Number of frontier vertices a thread claims at a time
+const int BFS_CHUNK_SIZE = 64;
+
+Graph Algorithms::bfsParallel(const Graph& g, int source, int numThreads) {
+    if (source < 0 || source >= g.getNumVertices()) {
+        throw "Source vertex out of range";
+    }
+    CSRGraph csr(g);
+    return bfsParallel(csr, source, numThreads);
+}
+
+Graph Algorithms::bfsParallel(const CSRGraph& g, int source, int numThreads) {
+    Graph result(g.getNumVertices());
+    bfsParallel(g, source, numThreads, result);
+    return result;
+}
+
+// Level-synchronous parallel BFS.
+// All levels live in one array in BFS order; the current frontier is the window
+// [levelStart, levelEnd). Threads take chunks of the frontier, claim unvisited
+// neighbors with a compare-and-swap on their parent entry and collect them in a
+// private buffer. Between levels thread 0 appends the buffers after the window.
+void Algorithms::bfsParallel(const CSRGraph& g, int source, int numThreads, Graph& result) {
+    int numVertices = g.getNumVertices();
+
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    if (numThreads <= 0) {
+        throw "Number of threads must be positive";
+    }
+
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
+
+    // Use the caller's graph for the BFS tree
+    prepareResult(result, numVertices);
+
+    // parent[v] == -1 means unvisited; the source is its own parent
+    std::atomic<int>* parent = new std::atomic<int>[numVertices];
+    int* parentWeight = new int[numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        parent[i].store(-1, std::memory_order_relaxed);
+    }
+    parent[source].store(source, std::memory_order_relaxed);
+
+    int* order = new int[numVertices];
+    order[0] = source;
+    int levelStart = 0;
+    int levelEnd = 1;
+
+    IntBuffer* buffers = new IntBuffer[numThreads];
+    std::atomic<int> cursor(0);
+    Barrier barrier(numThreads);
+
+    runInParallel(numThreads, [&](int thread) {
+        IntBuffer& found = buffers[thread];
+
+        while (true) {
+            // Expand the frontier chunk by chunk
+            int start;
+            while ((start = levelStart + cursor.fetch_add(BFS_CHUNK_SIZE)) < levelEnd) {
+                int end = start + BFS_CHUNK_SIZE < levelEnd ? start + BFS_CHUNK_SIZE : levelEnd;
+
+                for (int k = start; k < end; k++) {
+                    int u = order[k];
+                    for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                        int v = destinations[i];
+
+                        // Cheap check first, then claim the vertex
+                        int expected = -1;
+                        if (parent[v].load(std::memory_order_relaxed) == -1 &&
+                            parent[v].compare_exchange_strong(expected, u)) {
+                            parentWeight[v] = weights[i];
+                            found.push(v);
+                        }
+                    }
+                }
+            }
+
+            barrier.wait();
+
+            // Thread 0 appends every buffer to build the next level
+            if (thread == 0) {
+                int next = levelEnd;
+                for (int t = 0; t < numThreads; t++) {
+                    const int* data = buffers[t].getData();
+                    for (int i = 0; i < buffers[t].getSize(); i++) {
+                        order[next++] = data[i];
+                    }
+                    buffers[t].clear();
+                }
+                levelStart = levelEnd;
+                levelEnd = next;
+                cursor.store(0);
+            }
+
+            barrier.wait();
+
+            if (levelStart == levelEnd) {
+                break;
+            }
+        }
+    });
+
+    // Build the BFS tree in visiting order
+    for (int k = 1; k < levelEnd; k++) {
+        int v = order[k];
+        result.addEdge(parent[v].load(std::memory_order_relaxed), v, parentWeight[v]);
+    }
+
+    delete[] buffers;
+    delete[] order;
+    delete[] parentWeight;
+    delete[] parent;
+}
+
+// Which edges a delta-stepping pass relaxes
+const int RELAX_LIGHT = 0;
+const int RELAX_HEAVY = 1;
+const int RELAX_DONE = 2;
+
+// Parallel delta-stepping.
+// Worker threads only relax edges: each takes chunks of the current work list,
+// lowers distances with a compare-and-swap loop and records improved vertices in a
+// private buffer. Between passes thread 0 moves those vertices into their buckets
+// and picks the next work list: the current bucket for light edges while it keeps
+// refilling, then all vertices removed from it for heavy edges, then the next bucket.
+void Algorithms::deltaStepping(const CSRGraph& g, int source, int delta, int numThreads,
+                               int* distance, int* parent) {
+    int numVertices = g.getNumVertices();
+
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    if (delta <= 0) {
+        throw "Delta must be positive";
+    }
+    if (numThreads <= 0) {
+        throw "Number of threads must be positive";
+    }
+
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
+
+    int maxWeight = 0;
+    bool zeroWeight = false;
+    for (int i = 0; i < g.getNumHalfEdges(); i++) {
+        if (weights[i] < 0) {
+            throw "Delta-stepping needs non-negative weights";
+        }
+        if (weights[i] > maxWeight) {
+            maxWeight = weights[i];
+        }
+        zeroWeight = zeroWeight || weights[i] == 0;
+    }
+
+    std::atomic<int>* dist = new std::atomic<int>[numVertices];
+    int* processedAt = new int[numVertices];  // Distance a vertex was last expanded with
+    int* removedFrom = new int[numVertices];  // Last bucket the vertex was removed from
+    for (int i = 0; i < numVertices; i++) {
+        dist[i].store(INT_MAX, std::memory_order_relaxed);
+        processedAt[i] = -1;
+        removedFrom[i] = -1;
+    }
+    dist[source].store(0, std::memory_order_relaxed);
+
+    // Live entries are never more than maxWeight / delta + 1 buckets ahead of the
+    // current one, so the buckets can be reused circularly
+    int numBuckets = maxWeight / delta + 2;
+    IntBuffer* buckets = new IntBuffer[numBuckets];
+    buckets[0].push(source);
+    int currentBucket = 0;
+
+    IntBuffer frontier;  // Work list of a light pass
+    IntBuffer removed;   // Vertices removed from the current bucket, for the heavy pass
+    IntBuffer* found = new IntBuffer[numThreads];
+
+    const int* work = nullptr;
+    int workSize = 0;
+    int mode = RELAX_LIGHT;
+    std::atomic<int> cursor(0);
+    Barrier barrier(numThreads);
+
+    // Move the valid entries of the current bucket into the frontier
+    auto takeCurrentBucket = [&]() {
+        IntBuffer& bucket = buckets[currentBucket % numBuckets];
+        frontier.clear();
+        for (int k = 0; k < bucket.getSize(); k++) {
+            int v = bucket.getData()[k];
+            int d = dist[v].load(std::memory_order_relaxed);
+
+            // Skip entries that moved to another bucket or were already expanded at this distance
+            if (d / delta != currentBucket || processedAt[v] == d) {
+                continue;
+            }
+            processedAt[v] = d;
+            frontier.push(v);
+
+            if (removedFrom[v] != currentBucket) {
+                removedFrom[v] = currentBucket;
+                removed.push(v);
+            }
+        }
+        bucket.clear();
+    };
+
+    // Thread 0 only: choose the next work list, or finish
+    auto advance = [&]() {
+        if (mode == RELAX_LIGHT) {
+            takeCurrentBucket();
+            if (frontier.getSize() > 0) {
+                work = frontier.getData();
+                workSize = frontier.getSize();
+                return;
+            }
+
+            // The bucket stayed empty: relax the heavy edges of everything removed from it
+            mode = RELAX_HEAVY;
+            work = removed.getData();
+            workSize = removed.getSize();
+            return;
+        }
+
+        // After the heavy pass, move on to the next non-empty bucket
+        removed.clear();
+        mode = RELAX_DONE;
+        for (int step = 1; step <= numBuckets; step++) {
+            if (buckets[(currentBucket + step) % numBuckets].getSize() > 0) {
+                currentBucket += step;
+                mode = RELAX_LIGHT;
+                break;
+            }
+        }
+        if (mode == RELAX_LIGHT) {
+            takeCurrentBucket();
+            work = frontier.getData();
+            workSize = frontier.getSize();
+        }
+    };
+
+    advance();
+
+    runInParallel(numThreads, [&](int thread) {
+        IntBuffer& improved = found[thread];
+
+        while (mode != RELAX_DONE) {
+            bool light = mode == RELAX_LIGHT;
+            int start;
+
+            while ((start = cursor.fetch_add(BFS_CHUNK_SIZE)) < workSize) {
+                int end = start + BFS_CHUNK_SIZE < workSize ? start + BFS_CHUNK_SIZE : workSize;
+
+                for (int k = start; k < end; k++) {
+                    int v = work[k];
+                    int d = dist[v].load(std::memory_order_relaxed);
+
+                    for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+                        if ((weights[i] <= delta) != light) {
+                            continue;
+                        }
+
+                        // Atomic minimum on the neighbor's distance
+                        int u = destinations[i];
+                        int candidate = d + weights[i];
+                        int old = dist[u].load(std::memory_order_relaxed);
+                        while (candidate < old) {
+                            if (dist[u].compare_exchange_weak(old, candidate)) {
+                                improved.push(u);
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+
+            barrier.wait();
+
+            if (thread == 0) {
+                // Put every improved vertex into the bucket of its new distance
+                for (int t = 0; t < numThreads; t++) {
+                    for (int k = 0; k < found[t].getSize(); k++) {
+                        int u = found[t].getData()[k];
+                        int b = dist[u].load(std::memory_order_relaxed) / delta;
+                        buckets[b % numBuckets].push(u);
+                    }
+                    found[t].clear();
+                }
+                cursor.store(0);
+                advance();
+            }
+
+            barrier.wait();
+        }
+    });
+
+    for (int i = 0; i < numVertices; i++) {
+        distance[i] = dist[i].load(std::memory_order_relaxed);
+        parent[i] = -1;
+    }
+
+    if (!zeroWeight) {
+        // With positive weights any neighbor on a tight edge is strictly closer,
+        // so taking the first one never creates a cycle and every vertex is independent
+        runInParallel(numThreads, [&](int thread) {
+            for (int v = thread; v < numVertices; v += numThreads) {
+                if (v == source || distance[v] == INT_MAX) {
+                    continue;
+                }
+                for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+                    int u = destinations[i];
+                    if (distance[u] != INT_MAX && distance[u] + weights[i] == distance[v]) {
+                        parent[v] = u;
+                        break;
+                    }
+                }
+            }
+        });
+    } else {
+        // Zero-weight edges can make tight edges point both ways; a BFS over the
+        // tight edges from the source gives an acyclic choice
+        int* queue = new int[numVertices];
+        int head = 0;
+        int tail = 0;
+        queue[tail++] = source;
+        parent[source] = source;
+
+        while (head < tail) {
+            int u = queue[head++];
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                int v = destinations[i];
+                if (parent[v] == -1 && distance[u] + weights[i] == distance[v]) {
+                    parent[v] = u;
+                    queue[tail++] = v;
+                }
+            }
+        }
+        parent[source] = -1;
+        delete[] queue;
+    }
+
+    delete[] found;
+    delete[] buckets;
+    delete[] removedFrom;
+    delete[] processedAt;
+    delete[] dist;
+}
+
+// Radix sort digits and the smallest block a sorting or partitioning thread gets
+const int RADIX_BITS = 8;
+const int RADIX_BUCKETS = 1 << RADIX_BITS;
+const int SORT_MIN_BLOCK = 1 << 15;
+
+// Number of threads worth using on count items - small inputs are not split
+static int blockThreads(int count, int numThreads) {
+    int threads = count / SORT_MIN_BLOCK < numThreads ? count / SORT_MIN_BLOCK : numThreads;
+    return threads > 1 ? threads : 1;
+}
+
+// Weight as an unsigned key in which negative weights come first
+static inline unsigned int weightKey(int weight) {
+    return (unsigned int)weight ^ 0x80000000u;
+}
+
+// LSD radix sort, one 8-bit digit per pass.
+// Every thread owns a contiguous block: it counts the digits of its block, the
+// counts are turned into start positions digit by digit and block by block, and
+// each thread then scatters its block in order. That keeps every pass stable.
+void Algorithms::sortEdgesByWeight(WeightedEdge* edges, int edgeCount, int numThreads) {
+    if (numThreads <= 0) {
+        throw "Number of threads must be positive";
+    }
+    if (edgeCount < 2) {
+        return;
+    }
+
+    int threads = blockThreads(edgeCount, numThreads);
+    int blockSize = (edgeCount + threads - 1) / threads;
+
+    WeightedEdge* buffer = new WeightedEdge[edgeCount];
+    int* counts = new int[threads * RADIX_BUCKETS];  // counts[t * RADIX_BUCKETS + digit]
+    WeightedEdge* from = edges;
+    WeightedEdge* to = buffer;
+
+    for (int shift = 0; shift < 32; shift += RADIX_BITS) {
+        // Histogram of the digit in every block
+        runInParallel(threads, [&](int thread) {
+            int* count = counts + thread * RADIX_BUCKETS;
+            for (int d = 0; d < RADIX_BUCKETS; d++) {
+                count[d] = 0;
+            }
+            int start = thread * blockSize;
+            int end = start + blockSize < edgeCount ? start + blockSize : edgeCount;
+            for (int i = start; i < end; i++) {
+                count[(weightKey(from[i].weight) >> shift) & (RADIX_BUCKETS - 1)]++;
+            }
+        });
+
+        // Skip the pass when every edge has the same digit
+        int firstDigit = (weightKey(from[0].weight) >> shift) & (RADIX_BUCKETS - 1);
+        int sameDigit = 0;
+        for (int t = 0; t < threads; t++) {
+            sameDigit += counts[t * RADIX_BUCKETS + firstDigit];
+        }
+        if (sameDigit == edgeCount) {
+            continue;
+        }
+
+        // Start positions: all blocks for digit 0, then all blocks for digit 1, ...
+        int position = 0;
+        for (int d = 0; d < RADIX_BUCKETS; d++) {
+            for (int t = 0; t < threads; t++) {
+                int count = counts[t * RADIX_BUCKETS + d];
+                counts[t * RADIX_BUCKETS + d] = position;
+                position += count;
+            }
+        }
+
+        runInParallel(threads, [&](int thread) {
+            int* next = counts + thread * RADIX_BUCKETS;
+            int start = thread * blockSize;
+            int end = start + blockSize < edgeCount ? start + blockSize : edgeCount;
+            for (int i = start; i < end; i++) {
+                to[next[(weightKey(from[i].weight) >> shift) & (RADIX_BUCKETS - 1)]++] = from[i];
+            }
+        });
+
+        WeightedEdge* swapped = from;
+        from = to;
+        to = swapped;
+    }
+
+    // An odd number of passes leaves the result in the buffer
+    if (from != edges) {
+        for (int i = 0; i < edgeCount; i++) {
+            edges[i] = from[i];
+        }
+    }
+
+    delete[] counts;
+    delete[] buffer;
+}
+
+// Stable parallel partition: the items for which keep() holds move to the front,
+// both groups keeping their order. buffer needs room for count items.
+// Returns the number of kept items.
+template <typename T, typename Predicate>
+static int partitionStable(T* items, int count, T* buffer, int numThreads, Predicate keep) {
+    int threads = blockThreads(count, numThreads);
+    int blockSize = (count + threads - 1) / threads;
+    int* keptInBlock = new int[threads];
+
+    runInParallel(threads, [&](int thread) {
+        int start = thread * blockSize;
+        int end = start + blockSize < count ? start + blockSize : count;
+        int kept = 0;
+        for (int i = start; i < end; i++) {
+            if (keep(items[i])) {
+                kept++;
+            }
+        }
+        keptInBlock[thread] = kept;
+    });
+
+    int totalKept = 0;
+    for (int t = 0; t < threads; t++) {
+        totalKept += keptInBlock[t];
+    }
+
+    runInParallel(threads, [&](int thread) {
+        int start = thread * blockSize;
+        int end = start + blockSize < count ? start + blockSize : count;
+
+        // Kept items of earlier blocks go first, rejected ones after all kept items
+        int nextKept = 0;
+        for (int t = 0; t < thread; t++) {
+            nextKept += keptInBlock[t];
+        }
+        int nextRejected = totalKept + (start < count ? start : count) - nextKept;
+
+        for (int i = start; i < end; i++) {
+            if (keep(items[i])) {
+                buffer[nextKept++] = items[i];
+            } else {
+                buffer[nextRejected++] = items[i];
+            }
+        }
+    });
+
+    runInParallel(threads, [&](int thread) {
+        int start = thread * blockSize;
+        int end = start + blockSize < count ? start + blockSize : count;
+        for (int i = start; i < end; i++) {
+            items[i] = buffer[i];
+        }
+    });
+
+    delete[] keptInBlock;
+    return totalKept;
+}
+
+// Every undirected edge of a CSR graph once, without self-loops
+static WeightedEdge* collectEdges(const CSRGraph& g, int& edgeCount) {
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
+
+    WeightedEdge* edges = new WeightedEdge[g.getNumEdges() + 1];
+    edgeCount = 0;
+    for (int u = 0; u < g.getNumVertices(); u++) {
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            if (u < destinations[i]) {
+                edges[edgeCount++] = WeightedEdge(u, destinations[i], weights[i]);
+            }
+        }
+    }
+    return edges;
+}
+
+Graph Algorithms::boruvka(const Graph& g, int numThreads) {
+    CSRGraph csr(g);
+    return boruvka(csr, numThreads);
+}
+
+Graph Algorithms::boruvka(const CSRGraph& g, int numThreads) {
+    Graph result(g.getNumVertices());
+    boruvka(g, numThreads, result);
+    return result;
+}
+
+// Marks a component that has no outgoing edge this round
+const unsigned long long NO_EDGE = ~0ULL;
+
+// Parallel Boruvka.
+// The edge list never moves; the active edges of a round are indices into it.
+// Each round threads scan chunks of the active edges and lower the best edge of
+// both endpoint components with an atomic minimum on (weight, edge index). Thread 0
+// then unites the components along the picked edges, renumbers them densely, and
+// the threads relabel the vertices and drop the edges that became internal.
+void Algorithms::boruvka(const CSRGraph& g, int numThreads, Graph& result) {
+    int numVertices = g.getNumVertices();
+
+    if (numThreads <= 0) {
+        throw "Number of threads must be positive";
+    }
+
+    prepareResult(result, numVertices);
+
+    int edgeCount;
+    WeightedEdge* edges = collectEdges(g, edgeCount);
+
+    int* active = new int[edgeCount + 1];
+    int* activeBuffer = new int[edgeCount + 1];
+    for (int i = 0; i < edgeCount; i++) {
+        active[i] = i;
+    }
+    int activeCount = edgeCount;
+
+    // Every vertex starts as its own component
+    int* component = new int[numVertices];
+    for (int v = 0; v < numVertices; v++) {
+        component[v] = v;
+    }
+    int numComponents = numVertices;
+
+    std::atomic<unsigned long long>* best = new std::atomic<unsigned long long>[numVertices];
+    int* newLabel = new int[numVertices];
+    int* rootLabel = new int[numVertices];
+    std::atomic<int> cursor(0);
+
+    while (activeCount > 0) {
+        int threads = blockThreads(activeCount, numThreads);
+
+        for (int c = 0; c < numComponents; c++) {
+            best[c].store(NO_EDGE, std::memory_order_relaxed);
+        }
+        cursor.store(0);
+
+        // Lightest edge leaving every component
+        runInParallel(threads, [&](int) {
+            int start;
+            while ((start = cursor.fetch_add(BFS_CHUNK_SIZE)) < activeCount) {
+                int end = start + BFS_CHUNK_SIZE < activeCount ? start + BFS_CHUNK_SIZE : activeCount;
+
+                for (int k = start; k < end; k++) {
+                    int e = active[k];
+                    unsigned long long key = (unsigned long long)weightKey(edges[e].weight) << 32 | (unsigned int)e;
+                    int ends[2] = { component[edges[e].source], component[edges[e].dest] };
+
+                    for (int side = 0; side < 2; side++) {
+                        // Atomic minimum on the component's best key
+                        unsigned long long old = best[ends[side]].load(std::memory_order_relaxed);
+                        while (key < old) {
+                            if (best[ends[side]].compare_exchange_weak(old, key)) {
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        });
+
+        // Merge along the picked edges. With distinct keys they form a forest; the
+        // check only skips an edge picked by both of its components.
+        UnionFind merged(numComponents);
+        bool progress = false;
+        for (int c = 0; c < numComponents; c++) {
+            unsigned long long key = best[c].load(std::memory_order_relaxed);
+            if (key == NO_EDGE) {
+                continue;
+            }
+            const WeightedEdge& edge = edges[(int)(key & 0xffffffffULL)];
+            int a = component[edge.source];
+            int b = component[edge.dest];
+            if (!merged.connected(a, b)) {
+                merged.unite(a, b);
+                result.addEdge(edge.source, edge.dest, edge.weight);
+                progress = true;
+            }
+        }
+        if (!progress) {
+            break;
+        }
+
+        // Dense labels for the merged components
+        int labels = 0;
+        for (int c = 0; c < numComponents; c++) {
+            rootLabel[c] = -1;
+        }
+        for (int c = 0; c < numComponents; c++) {
+            int root = merged.find(c);
+            if (rootLabel[root] == -1) {
+                rootLabel[root] = labels++;
+            }
+            newLabel[c] = rootLabel[root];
+        }
+        numComponents = labels;
+
+        int relabelThreads = blockThreads(numVertices, numThreads);
+        runInParallel(relabelThreads, [&](int thread) {
+            for (int v = thread; v < numVertices; v += relabelThreads) {
+                component[v] = newLabel[component[v]];
+            }
+        });
+
+        activeCount = partitionStable(active, activeCount, activeBuffer, numThreads, [&](int e) {
+            return component[edges[e].source] != component[edges[e].dest];
+        });
+    }
+
+    delete[] rootLabel;
+    delete[] newLabel;
+    delete[] best;
+    delete[] component;
+    delete[] activeBuffer;
+    delete[] active;
+    delete[] edges;
+}
+
+Graph Algorithms::filterKruskal(const Graph& g, int numThreads) {
+    CSRGraph csr(g);
+    return filterKruskal(csr, numThreads);
+}
+
+Graph Algorithms::filterKruskal(const CSRGraph& g, int numThreads) {
+    Graph result(g.getNumVertices());
+    filterKruskal(g, numThreads, result);
+    return result;
+}
+
+// Edge lists up to this size are sorted directly
+const int FILTER_KRUSKAL_BASE = 1 << 14;
+const int PIVOT_SAMPLES = 15;
+
+// Median weight of evenly spaced samples
+static int pickPivot(const WeightedEdge* edges, int count) {
+    int samples[PIVOT_SAMPLES];
+    int numSamples = count < PIVOT_SAMPLES ? count : PIVOT_SAMPLES;
+    for (int i = 0; i < numSamples; i++) {
+        int value = edges[(int)((long long)i * count / numSamples)].weight;
+        int j = i;
+        while (j > 0 && samples[j - 1] > value) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = value;
+    }
+    return samples[numSamples / 2];
+}
+
+// Add the edges of a sorted (or equal-weight) list that join two components
+static void kruskalScan(const WeightedEdge* edges, int count, UnionFind& uf, Graph& result, int& treeEdges) {
+    for (int i = 0; i < count; i++) {
+        if (!uf.connected(edges[i].source, edges[i].dest)) {
+            uf.unite(edges[i].source, edges[i].dest);
+            result.addEdge(edges[i].source, edges[i].dest, edges[i].weight);
+            treeEdges++;
+        }
+    }
+}
+
+// One Filter-Kruskal step on edges[0, count), using buffer[0, count) as scratch.
+// The light part is finished before the heavy part is filtered, so the filter
+// sees every union the light edges caused.
+static void filterKruskalRun(WeightedEdge* edges, int count, WeightedEdge* buffer, int numThreads,
+                             int numVertices, UnionFind& uf, Graph& result, int& treeEdges) {
+    if (count == 0 || treeEdges == numVertices - 1) {
+        return;
+    }
+    if (count <= FILTER_KRUSKAL_BASE) {
+        Algorithms::sortEdgesByWeight(edges, count);
+        kruskalScan(edges, count, uf, result, treeEdges);
+        return;
+    }
+
+    int pivot = pickPivot(edges, count);
+    int light = partitionStable(edges, count, buffer, numThreads, [&](const WeightedEdge& e) {
+        return e.weight < pivot;
+    });
+    if (light == 0) {
+        // The pivot is the smallest weight: split off the edges equal to it
+        light = partitionStable(edges, count, buffer, numThreads, [&](const WeightedEdge& e) {
+            return e.weight <= pivot;
+        });
+        if (light == count) {
+            kruskalScan(edges, count, uf, result, treeEdges); // All weights are equal
+            return;
+        }
+    }
+
+    filterKruskalRun(edges, light, buffer, numThreads, numVertices, uf, result, treeEdges);
+
+    // Only heavy edges between different components can still join the forest.
+    // A single thread may compress paths while filtering; several threads must not.
+    WeightedEdge* heavy = edges + light;
+    int heavyCount = count - light;
+    int kept;
+    if (blockThreads(heavyCount, numThreads) == 1) {
+        kept = partitionStable(heavy, heavyCount, buffer + light, 1, [&](const WeightedEdge& e) {
+            return !uf.connected(e.source, e.dest);
+        });
+    } else {
+        kept = partitionStable(heavy, heavyCount, buffer + light, numThreads, [&](const WeightedEdge& e) {
+            return uf.root(e.source) != uf.root(e.dest);
+        });
+    }
+
+    filterKruskalRun(heavy, kept, buffer + light, numThreads, numVertices, uf, result, treeEdges);
+}
+
+void Algorithms::filterKruskal(const CSRGraph& g, int numThreads, Graph& result) {
+    int numVertices = g.getNumVertices();
+
+    if (numThreads <= 0) {
+        throw "Number of threads must be positive";
+    }
+
+    prepareResult(result, numVertices);
+
+    int edgeCount;
+    WeightedEdge* edges = collectEdges(g, edgeCount);
+    WeightedEdge* buffer = new WeightedEdge[edgeCount + 1];
+
+    UnionFind uf(numVertices);
+    int treeEdges = 0;
+    filterKruskalRun(edges, edgeCount, buffer, numThreads, numVertices, uf, result, treeEdges);
+
+    delete[] buffer;
+    delete[] edges;
+}
+
+} // namespace graph
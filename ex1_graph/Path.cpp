@@ -0,0 +1,90 @@
+// path.cpp
+#include "Path.hpp"
+
+namespace graph {
+
+Path::Path() : vertices(nullptr), length(0), cost(0) {}
+
+Path::Path(const int* pathVertices, int pathLength, int pathCost)
+    : vertices(nullptr), length(pathLength), cost(pathCost) {
+    if (pathLength <= 0) {
+        throw "Path must contain at least one vertex";
+    }
+    vertices = new int[length];
+    for (int i = 0; i < length; i++) {
+        vertices[i] = pathVertices[i];
+    }
+}
+
+Path::~Path() {
+    delete[] vertices;
+}
+
+// Copy constructor
+Path::Path(const Path& other) : vertices(nullptr), length(other.length), cost(other.cost) {
+    if (other.vertices) {
+        vertices = new int[length];
+        for (int i = 0; i < length; i++) {
+            vertices[i] = other.vertices[i];
+        }
+    }
+}
+
+// Assignment operator
+Path& Path::operator=(const Path& other) {
+    if (this != &other) {
+        Path copy(other);
+        *this = static_cast<Path&&>(copy);
+    }
+    return *this;
+}
+
+// Move constructor
+Path::Path(Path&& other) noexcept : vertices(other.vertices), length(other.length), cost(other.cost) {
+    other.vertices = nullptr;
+    other.length = 0;
+    other.cost = 0;
+}
+
+// Move assignment operator
+Path& Path::operator=(Path&& other) noexcept {
+    if (this != &other) {
+        delete[] vertices;
+        vertices = other.vertices;
+        length = other.length;
+        cost = other.cost;
+
+        other.vertices = nullptr;
+        other.length = 0;
+        other.cost = 0;
+    }
+    return *this;
+}
+
+bool Path::exists() const {
+    return vertices != nullptr;
+}
+
+int Path::getCost() const {
+    if (!exists()) {
+        throw "Path does not exist";
+    }
+    return cost;
+}
+
+int Path::getLength() const {
+    return length;
+}
+
+int Path::getVertex(int index) const {
+    if (index < 0 || index >= length) {
+        throw "Path index out of range";
+    }
+    return vertices[index];
+}
+
+const int* Path::getVertices() const {
+    return vertices;
+}
+
+} // namespace graph
@@ -0,0 +1,35 @@
+// path.hpp
+#ifndef PATH_HPP
+#define PATH_HPP
+
+namespace graph {
+
+// A path between two vertices together with its total weight.
+// A default-constructed Path means that no path exists.
+class Path {
+public:
+    Path();
+    Path(const int* pathVertices, int pathLength, int pathCost);
+    ~Path();
+
+    // Copy and move
+    Path(const Path& other);
+    Path& operator=(const Path& other);
+    Path(Path&& other) noexcept;
+    Path& operator=(Path&& other) noexcept;
+
+    bool exists() const;
+    int getCost() const;            // Sum of the edge weights
+    int getLength() const;          // Number of vertices, including both endpoints
+    int getVertex(int index) const;
+    const int* getVertices() const;
+
+private:
+    int* vertices;
+    int length;
+    int cost;
+};
+
+} // namespace graph
+
+#endif // PATH_HPP
@@ -0,0 +1,201 @@
+// pathqueries.cpp
+#include "Algorithms.hpp"
+#include <climits>
+
+namespace graph {
+
+// The searches below keep their labels in QueryContexts, so a query only touches
+// the entries of the vertices it reaches. The versions without contexts use
+// temporary ones, which costs O(V) per query for the allocation.
+
+Path Algorithms::bidirectionalDijkstra(const Graph& g, int source, int target, int* settledCount) {
+    QueryContext forward;
+    QueryContext backward;
+    return bidirectionalDijkstra(g, source, target, forward, backward, settledCount);
+}
+
+// Bidirectional Dijkstra.
+// Both searches run on the same undirected graph. Every edge scanned by one side
+// that reaches a vertex labelled by the other side is a candidate meeting point;
+// the best candidate is final once topForward + topBackward >= best.
+Path Algorithms::bidirectionalDijkstra(const Graph& g, int source, int target, QueryContext& forward,
+                                       QueryContext& backward, int* settledCount) {
+    int numVertices = g.getNumVertices();
+
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    if (target < 0 || target >= numVertices) {
+        throw "Target vertex out of range";
+    }
+    if (&forward == &backward) {
+        throw "Bidirectional search needs two contexts";
+    }
+
+    // Index 0 is the forward search from source, index 1 the backward search from target
+    QueryContext* context[2] = { &forward, &backward };
+    int start[2] = { source, target };
+    for (int side = 0; side < 2; side++) {
+        context[side]->begin(numVertices, start[side]);
+        context[side]->reach(start[side], 0, -1, 0);
+        context[side]->record(start[side]);
+    }
+
+    int settled = 0;
+
+    if (source == target) {
+        if (settledCount) {
+            *settledCount = 0;
+        }
+        return Path(&source, 1, 0);
+    }
+
+    forward.queue.push(source, 0);
+    backward.queue.push(target, 0);
+
+    long long best = LLONG_MAX;
+    int meeting = -1;
+
+    while (!forward.queue.isEmpty() && !backward.queue.isEmpty()) {
+        int dF = forward.queue.topKey();
+        int dB = backward.queue.topKey();
+        if ((long long)dF + dB >= best) {
+            break;
+        }
+
+        // Expand the side with the smaller key
+        int side = dF <= dB ? 0 : 1;
+        QueryContext& here = *context[side];
+        QueryContext& there = *context[1 - side];
+        int u;
+        int d;
+        here.queue.popMin(u, d);
+
+        if (d > here.distance[u]) {
+            continue; // Stale entry
+        }
+        settled++;
+
+        for (Graph::Edge* edge = g.getAdjList(u); edge != nullptr; edge = edge->next) {
+            int v = edge->destination;
+            int candidate = d + edge->weight;
+
+            if (!here.seen(v)) {
+                here.reach(v, candidate, u, edge->weight);
+                here.record(v);
+                here.queue.push(v, candidate);
+            } else if (candidate < here.distance[v]) {
+                here.reach(v, candidate, u, edge->weight);
+                here.queue.push(v, candidate);
+            }
+
+            // A path through v joins the two searches
+            if (there.seen(v) && (long long)here.distance[v] + there.distance[v] < best) {
+                best = (long long)here.distance[v] + there.distance[v];
+                meeting = v;
+            }
+        }
+    }
+
+    Path result;
+    if (meeting != -1) {
+        // Source .. meeting from the forward parents, then meeting .. target from the backward ones
+        const int* forwardParent = forward.parent;
+        const int* backwardParent = backward.parent;
+        int forwardLength = 0;
+        for (int v = meeting; v != -1; v = forwardParent[v]) {
+            forwardLength++;
+        }
+        int length = forwardLength;
+        for (int v = backwardParent[meeting]; v != -1; v = backwardParent[v]) {
+            length++;
+        }
+
+        int* vertices = new int[length];
+        int k = forwardLength - 1;
+        for (int v = meeting; v != -1; v = forwardParent[v]) {
+            vertices[k--] = v;
+        }
+        k = forwardLength;
+        for (int v = backwardParent[meeting]; v != -1; v = backwardParent[v]) {
+            vertices[k++] = v;
+        }
+
+        result = Path(vertices, length, (int)best);
+        delete[] vertices;
+    }
+
+    if (settledCount) {
+        *settledCount = settled;
+    }
+    return result;
+}
+
+Path Algorithms::aStar(const Graph& g, int source, int target, const Heuristic& heuristic, int* settledCount) {
+    QueryContext context;
+    return aStar(g, source, target, heuristic, context, settledCount);
+}
+
+// A* search.
+// The queue is keyed by distance + estimate. A vertex is expanded again if it is
+// later reached by a shorter path, so an admissible but inconsistent heuristic still
+// gives the shortest path.
+Path Algorithms::aStar(const Graph& g, int source, int target, const Heuristic& heuristic, QueryContext& context,
+                       int* settledCount) {
+    int numVertices = g.getNumVertices();
+
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+    if (target < 0 || target >= numVertices) {
+        throw "Target vertex out of range";
+    }
+
+    context.begin(numVertices, source);
+    context.reach(source, 0, -1, 0);
+    context.record(source);
+    BinaryHeapQueue& queue = context.queue;
+    queue.push(source, heuristic.estimate(source));
+
+    const int* distance = context.distance;
+    int settled = 0;
+    bool found = false;
+
+    while (!queue.isEmpty()) {
+        int u;
+        int key;
+        queue.popMin(u, key);
+
+        // Skip entries pushed before a shorter path to u was found
+        if (key - heuristic.estimate(u) > distance[u]) {
+            continue;
+        }
+        settled++;
+
+        if (u == target) {
+            found = true;
+            break;
+        }
+
+        for (Graph::Edge* edge = g.getAdjList(u); edge != nullptr; edge = edge->next) {
+            int v = edge->destination;
+            int candidate = distance[u] + edge->weight;
+
+            if (!context.seen(v)) {
+                context.reach(v, candidate, u, edge->weight);
+                context.record(v);
+                queue.push(v, candidate + heuristic.estimate(v));
+            } else if (candidate < distance[v]) {
+                context.reach(v, candidate, u, edge->weight);
+                queue.push(v, candidate + heuristic.estimate(v));
+            }
+        }
+    }
+
+    if (settledCount) {
+        *settledCount = settled;
+    }
+    return found ? context.pathTo(target) : Path();
+}
+
+} // namespace graph
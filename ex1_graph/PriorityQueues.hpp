@@ -0,0 +1,399 @@
+// priorityqueues.hpp
+#ifndef PRIORITYQUEUES_HPP
+#define PRIORITYQUEUES_HPP
+
+namespace graph {
+
+// Queue policies for Dijkstra and Prim.
+// All of them are lazy: a vertex is pushed only when it is reached, and pushing it
+// again with a smaller key leaves the old entry in place. The caller skips entries
+// of vertices it has already settled. Every policy offers the same operations:
+//   Queue(int numVertices), isEmpty(), push(vertex, key), popMin(vertex, key),
+//   topKey() (the key popMin would return next), clear()
+
+// Binary min-heap with lazy insertion
+class BinaryHeapQueue {
+private:
+    struct Entry {
+        int key;
+        int vertex;
+    };
+
+    Entry* heap;
+    int capacity;
+    int heapSize;
+
+    void grow() {
+        Entry* bigger = new Entry[capacity * 2];
+        for (int i = 0; i < heapSize; i++) {
+            bigger[i] = heap[i];
+        }
+        delete[] heap;
+        heap = bigger;
+        capacity *= 2;
+    }
+
+    // Buffers are never copied
+    BinaryHeapQueue(const BinaryHeapQueue&);
+    BinaryHeapQueue& operator=(const BinaryHeapQueue&);
+
+public:
+    BinaryHeapQueue(int numVertices) : capacity(numVertices > 16 ? numVertices : 16), heapSize(0) {
+        heap = new Entry[capacity];
+    }
+
+    ~BinaryHeapQueue() {
+        delete[] heap;
+    }
+
+    bool isEmpty() const {
+        return heapSize == 0;
+    }
+
+    void push(int vertex, int key) {
+        if (heapSize == capacity) {
+            grow();
+        }
+
+        // Sift the new entry up from the last position
+        int i = heapSize++;
+        while (i > 0 && heap[(i - 1) / 2].key > key) {
+            heap[i] = heap[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        heap[i].key = key;
+        heap[i].vertex = vertex;
+    }
+
+    void popMin(int& vertex, int& key) {
+        if (heapSize == 0) {
+            throw "Priority queue is empty";
+        }
+
+        vertex = heap[0].vertex;
+        key = heap[0].key;
+
+        // Sift the last entry down from the root, without recursion
+        Entry last = heap[--heapSize];
+        int i = 0;
+        while (true) {
+            int child = 2 * i + 1;
+            if (child >= heapSize) {
+                break;
+            }
+            if (child + 1 < heapSize && heap[child + 1].key < heap[child].key) {
+                child++;
+            }
+            if (heap[child].key >= last.key) {
+                break;
+            }
+            heap[i] = heap[child];
+            i = child;
+        }
+        heap[i] = last;
+    }
+
+    int topKey() const {
+        if (heapSize == 0) {
+            throw "Priority queue is empty";
+        }
+        return heap[0].key;
+    }
+
+    void clear() {
+        heapSize = 0;
+    }
+};
+
+// D-ary min-heap with lazy insertion. With D = 4 or 8 the children of a node
+// share one or two cache lines and the heap is about half as deep as a binary one.
+template <int D>
+class DaryHeapQueue {
+private:
+    struct Entry {
+        int key;
+        int vertex;
+    };
+
+    Entry* heap;
+    int capacity;
+    int heapSize;
+
+    void grow() {
+        Entry* bigger = new Entry[capacity * 2];
+        for (int i = 0; i < heapSize; i++) {
+            bigger[i] = heap[i];
+        }
+        delete[] heap;
+        heap = bigger;
+        capacity *= 2;
+    }
+
+    DaryHeapQueue(const DaryHeapQueue&);
+    DaryHeapQueue& operator=(const DaryHeapQueue&);
+
+public:
+    DaryHeapQueue(int numVertices) : capacity(numVertices > 16 ? numVertices : 16), heapSize(0) {
+        heap = new Entry[capacity];
+    }
+
+    ~DaryHeapQueue() {
+        delete[] heap;
+    }
+
+    bool isEmpty() const {
+        return heapSize == 0;
+    }
+
+    void push(int vertex, int key) {
+        if (heapSize == capacity) {
+            grow();
+        }
+
+        int i = heapSize++;
+        while (i > 0 && heap[(i - 1) / D].key > key) {
+            heap[i] = heap[(i - 1) / D];
+            i = (i - 1) / D;
+        }
+        heap[i].key = key;
+        heap[i].vertex = vertex;
+    }
+
+    void popMin(int& vertex, int& key) {
+        if (heapSize == 0) {
+            throw "Priority queue is empty";
+        }
+
+        vertex = heap[0].vertex;
+        key = heap[0].key;
+
+        Entry last = heap[--heapSize];
+        int i = 0;
+        while (true) {
+            int first = D * i + 1;
+            if (first >= heapSize) {
+                break;
+            }
+
+            // Smallest of the (up to) D children
+            int end = first + D < heapSize ? first + D : heapSize;
+            int child = first;
+            for (int c = first + 1; c < end; c++) {
+                if (heap[c].key < heap[child].key) {
+                    child = c;
+                }
+            }
+
+            if (heap[child].key >= last.key) {
+                break;
+            }
+            heap[i] = heap[child];
+            i = child;
+        }
+        heap[i] = last;
+    }
+
+    int topKey() const {
+        if (heapSize == 0) {
+            throw "Priority queue is empty";
+        }
+        return heap[0].key;
+    }
+
+    void clear() {
+        heapSize = 0;
+    }
+};
+
+// Bucket queue for small non-negative integer keys (Dial's algorithm).
+// Buckets form a circular array indexed by key; popMin scans forward from the
+// smallest key. All live keys must fit in a window as wide as the bucket array,
+// which holds for Dijkstra (keys lie in [d, d + maxWeight]) and for Prim (keys are
+// edge weights); the array doubles whenever a key falls outside the window.
+class BucketQueue {
+private:
+    int* bucketHead;   // First entry of each bucket, -1 if empty
+    int numBuckets;    // Always a power of two
+
+    // Entry pool, linked into buckets or into the free list
+    int* entryVertex;
+    int* entryKey;
+    int* entryNext;
+    int entryCapacity;
+    int freeEntry;
+
+    int size;          // Number of live entries
+    mutable int minKey; // No live entry has a smaller key; topKey moves it forward
+    int maxKey;        // No live entry has a larger key
+
+    void growEntries() {
+        int capacity = entryCapacity * 2;
+        int* vertices = new int[capacity];
+        int* keys = new int[capacity];
+        int* next = new int[capacity];
+
+        for (int i = 0; i < entryCapacity; i++) {
+            vertices[i] = entryVertex[i];
+            keys[i] = entryKey[i];
+            next[i] = entryNext[i];
+        }
+        // The new entries form the free list
+        for (int i = entryCapacity; i < capacity; i++) {
+            next[i] = i + 1 < capacity ? i + 1 : -1;
+        }
+
+        delete[] entryVertex;
+        delete[] entryKey;
+        delete[] entryNext;
+        entryVertex = vertices;
+        entryKey = keys;
+        entryNext = next;
+        freeEntry = entryCapacity;
+        entryCapacity = capacity;
+    }
+
+    // Make the window at least 'width' keys wide and relink all entries
+    void growBuckets(int width) {
+        int buckets = numBuckets;
+        while (buckets < width) {
+            buckets *= 2;
+        }
+
+        int* heads = new int[buckets];
+        for (int i = 0; i < buckets; i++) {
+            heads[i] = -1;
+        }
+        for (int b = 0; b < numBuckets; b++) {
+            int e = bucketHead[b];
+            while (e != -1) {
+                int next = entryNext[e];
+                int slot = entryKey[e] & (buckets - 1);
+                entryNext[e] = heads[slot];
+                heads[slot] = e;
+                e = next;
+            }
+        }
+
+        delete[] bucketHead;
+        bucketHead = heads;
+        numBuckets = buckets;
+    }
+
+    // Scan forward to the first non-empty bucket; every key in it equals minKey
+    void skipEmptyBuckets() const {
+        while (bucketHead[minKey & (numBuckets - 1)] == -1) {
+            minKey++;
+        }
+    }
+
+    BucketQueue(const BucketQueue&);
+    BucketQueue& operator=(const BucketQueue&);
+
+public:
+    BucketQueue(int numVertices)
+        : numBuckets(64), entryCapacity(numVertices > 16 ? numVertices : 16),
+          freeEntry(0), size(0), minKey(0), maxKey(0) {
+        bucketHead = new int[numBuckets];
+        for (int i = 0; i < numBuckets; i++) {
+            bucketHead[i] = -1;
+        }
+
+        entryVertex = new int[entryCapacity];
+        entryKey = new int[entryCapacity];
+        entryNext = new int[entryCapacity];
+        for (int i = 0; i < entryCapacity; i++) {
+            entryNext[i] = i + 1 < entryCapacity ? i + 1 : -1;
+        }
+    }
+
+    ~BucketQueue() {
+        delete[] bucketHead;
+        delete[] entryVertex;
+        delete[] entryKey;
+        delete[] entryNext;
+    }
+
+    bool isEmpty() const {
+        return size == 0;
+    }
+
+    void push(int vertex, int key) {
+        if (key < 0) {
+            throw "Bucket queue keys must be non-negative";
+        }
+
+        // Widen the window [minKey, maxKey] to include the new key
+        if (size == 0) {
+            minKey = key;
+            maxKey = key;
+        } else {
+            if (key < minKey) {
+                minKey = key;
+            }
+            if (key > maxKey) {
+                maxKey = key;
+            }
+        }
+        if ((long long)maxKey - minKey >= numBuckets) {
+            growBuckets(maxKey - minKey + 1);
+        }
+
+        if (freeEntry == -1) {
+            growEntries();
+        }
+        int e = freeEntry;
+        freeEntry = entryNext[e];
+
+        int slot = key & (numBuckets - 1);
+        entryVertex[e] = vertex;
+        entryKey[e] = key;
+        entryNext[e] = bucketHead[slot];
+        bucketHead[slot] = e;
+        size++;
+    }
+
+    void popMin(int& vertex, int& key) {
+        if (size == 0) {
+            throw "Priority queue is empty";
+        }
+
+        skipEmptyBuckets();
+
+        int slot = minKey & (numBuckets - 1);
+        int e = bucketHead[slot];
+        bucketHead[slot] = entryNext[e];
+
+        vertex = entryVertex[e];
+        key = entryKey[e];
+
+        entryNext[e] = freeEntry;
+        freeEntry = e;
+        size--;
+    }
+
+    int topKey() const {
+        if (size == 0) {
+            throw "Priority queue is empty";
+        }
+        skipEmptyBuckets();
+        return minKey;
+    }
+
+    void clear() {
+        for (int b = 0; b < numBuckets; b++) {
+            int e = bucketHead[b];
+            while (e != -1) {
+                int next = entryNext[e];
+                entryNext[e] = freeEntry;
+                freeEntry = e;
+                e = next;
+            }
+            bucketHead[b] = -1;
+        }
+        size = 0;
+    }
+};
+
+} // namespace graph
+
+#endif // PRIORITYQUEUES_HPP
@@ -0,0 +1,112 @@
+// querycontext.cpp
+#include "QueryContext.hpp"
+#include <climits>
+
+namespace graph {
+
+QueryContext::QueryContext()
+    : capacity(0), numVertices(0), epoch(0), stamps(nullptr), distance(nullptr), parent(nullptr),
+      parentWeight(nullptr), reached(nullptr), reachedCount(0), source(-1), queue(16) {}
+
+QueryContext::~QueryContext() {
+    delete[] stamps;
+    delete[] distance;
+    delete[] parent;
+    delete[] parentWeight;
+    delete[] reached;
+}
+
+// Only the stamps need clearing, and only when the arrays are replaced or the
+// epoch counter wraps around
+void QueryContext::begin(int vertices, int root) {
+    if (vertices > capacity) {
+        delete[] stamps;
+        delete[] distance;
+        delete[] parent;
+        delete[] parentWeight;
+        delete[] reached;
+        stamps = new unsigned int[vertices];
+        distance = new int[vertices];
+        parent = new int[vertices];
+        parentWeight = new int[vertices];
+        reached = new int[vertices];
+        capacity = vertices;
+        for (int i = 0; i < capacity; i++) {
+            stamps[i] = 0;
+        }
+        epoch = 0;
+    }
+
+    epoch++;
+    if (epoch == 0) {
+        for (int i = 0; i < capacity; i++) {
+            stamps[i] = 0;
+        }
+        epoch = 1;
+    }
+
+    numVertices = vertices;
+    reachedCount = 0;
+    source = root;
+    queue.clear();
+}
+
+void QueryContext::checkVertex(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+}
+
+int QueryContext::getSource() const {
+    return source;
+}
+
+int QueryContext::getReachedCount() const {
+    return reachedCount;
+}
+
+const int* QueryContext::getReached() const {
+    return reached;
+}
+
+bool QueryContext::isReached(int vertex) const {
+    checkVertex(vertex);
+    return seen(vertex);
+}
+
+int QueryContext::getDistance(int vertex) const {
+    checkVertex(vertex);
+    return seen(vertex) ? distance[vertex] : INT_MAX;
+}
+
+int QueryContext::getParent(int vertex) const {
+    checkVertex(vertex);
+    return seen(vertex) ? parent[vertex] : -1;
+}
+
+Path QueryContext::pathTo(int vertex) const {
+    checkVertex(vertex);
+    if (!seen(vertex)) {
+        return Path();
+    }
+
+    int length = 1;
+    for (int v = vertex; parent[v] != -1; v = parent[v]) {
+        length++;
+    }
+
+    int* vertices = new int[length];
+    int cost = 0;
+    int v = vertex;
+    for (int i = length - 1; i >= 0; i--) {
+        vertices[i] = v;
+        cost += parentWeight[v];
+        v = parent[v];
+    }
+
+    Path path(vertices, length, cost);
+    delete[] vertices;
+    return path;
+}
+
+} // namespace graph
@@ -0,0 +1,85 @@
+// querycontext.hpp
+#ifndef QUERYCONTEXT_HPP
+#define QUERYCONTEXT_HPP
+
+#include "Path.hpp"
+#include "PriorityQueues.hpp"
+
+namespace graph {
+
+// Reusable workspace for bounded searches (Algorithms::boundedBfs and
+// boundedDijkstra) and point-to-point queries (bidirectionalDijkstra and aStar).
+// The per-vertex arrays are allocated once and kept across queries. A vertex's
+// entries count only if its stamp equals the current epoch, so starting a query
+// costs O(1) instead of clearing V entries, and a query costs time in proportion
+// to the part of the graph it reaches.
+//
+// After a query the context holds its result: the reached vertices in the order
+// they were reached (BFS, point-to-point queries) or settled (boundedDijkstra), and
+// their distances and parents. For the point-to-point queries these are the labels
+// at the time the search stopped, not final distances.
+// A context serves one query at a time; use one per thread.
+class QueryContext {
+public:
+    QueryContext();
+    ~QueryContext();
+
+    int getSource() const;          // -1 before the first query
+    int getReachedCount() const;
+    const int* getReached() const;  // The reached vertices, source first
+
+    // Results of the last query. Vertices it did not reach have distance INT_MAX
+    // and parent -1. The distance is the number of edges for boundedBfs.
+    bool isReached(int vertex) const;
+    int getDistance(int vertex) const;
+    int getParent(int vertex) const;
+
+    // The path the search found from the source, with the sum of its edge weights.
+    // Path() if the vertex was not reached.
+    Path pathTo(int vertex) const;
+
+private:
+    friend class Algorithms;
+
+    int capacity;           // Vertices the arrays have room for
+    int numVertices;        // Vertices of the graph of the last query
+    unsigned int epoch;
+    unsigned int* stamps;   // stamps[v] == epoch: the entries of v are valid
+    int* distance;
+    int* parent;
+    int* parentWeight;
+    int* reached;           // Reached vertices in order; also the BFS queue
+    int reachedCount;
+    int source;
+    BinaryHeapQueue queue;  // Grows to the largest frontier seen
+
+    // Start a query on a graph with the given number of vertices
+    void begin(int vertices, int root);
+
+    bool seen(int vertex) const {
+        return stamps[vertex] == epoch;
+    }
+
+    // Give a vertex a (new) distance and tree edge
+    void reach(int vertex, int dist, int from, int weight) {
+        stamps[vertex] = epoch;
+        distance[vertex] = dist;
+        parent[vertex] = from;
+        parentWeight[vertex] = weight;
+    }
+
+    // Append a vertex to the reached list once its distance is final
+    void record(int vertex) {
+        reached[reachedCount++] = vertex;
+    }
+
+    void checkVertex(int vertex) const;
+
+    // Workspaces are never copied
+    QueryContext(const QueryContext&);
+    QueryContext& operator=(const QueryContext&);
+};
+
+} // namespace graph
+
+#endif // QUERYCONTEXT_HPP
@@ -0,0 +1,199 @@
+// searchtree.cpp
+#include "SearchTree.hpp"
+#include <climits>
+
+namespace graph {
+
+SearchTree::SearchTree()
+    : numVertices(0), source(-1), parent(nullptr), parentWeight(nullptr), distance(nullptr), graph(nullptr) {}
+
+SearchTree::~SearchTree() {
+    delete[] parent;
+    delete[] parentWeight;
+    delete[] distance;
+    delete graph;
+}
+
+// Copy constructor - the cached graph is not copied, it is rebuilt on demand
+SearchTree::SearchTree(const SearchTree& other)
+    : numVertices(other.numVertices), source(other.source), parent(nullptr), parentWeight(nullptr),
+      distance(nullptr), graph(nullptr) {
+    if (numVertices > 0) {
+        parent = new int[numVertices];
+        parentWeight = new int[numVertices];
+        distance = new int[numVertices];
+        for (int i = 0; i < numVertices; i++) {
+            parent[i] = other.parent[i];
+            parentWeight[i] = other.parentWeight[i];
+            distance[i] = other.distance[i];
+        }
+    }
+}
+
+// Assignment operator
+SearchTree& SearchTree::operator=(const SearchTree& other) {
+    if (this != &other) {
+        SearchTree copy(other);
+        *this = static_cast<SearchTree&&>(copy);
+    }
+    return *this;
+}
+
+// Move constructor
+SearchTree::SearchTree(SearchTree&& other) noexcept
+    : numVertices(other.numVertices), source(other.source), parent(other.parent),
+      parentWeight(other.parentWeight), distance(other.distance), graph(other.graph) {
+    other.numVertices = 0;
+    other.source = -1;
+    other.parent = nullptr;
+    other.parentWeight = nullptr;
+    other.distance = nullptr;
+    other.graph = nullptr;
+}
+
+// Move assignment operator
+SearchTree& SearchTree::operator=(SearchTree&& other) noexcept {
+    if (this != &other) {
+        delete[] parent;
+        delete[] parentWeight;
+        delete[] distance;
+        delete graph;
+
+        numVertices = other.numVertices;
+        source = other.source;
+        parent = other.parent;
+        parentWeight = other.parentWeight;
+        distance = other.distance;
+        graph = other.graph;
+
+        other.numVertices = 0;
+        other.source = -1;
+        other.parent = nullptr;
+        other.parentWeight = nullptr;
+        other.distance = nullptr;
+        other.graph = nullptr;
+    }
+    return *this;
+}
+
+void SearchTree::reset(int vertices, int root) {
+    if (vertices != numVertices) {
+        delete[] parent;
+        delete[] parentWeight;
+        delete[] distance;
+        parent = new int[vertices];
+        parentWeight = new int[vertices];
+        distance = new int[vertices];
+        numVertices = vertices;
+    }
+    delete graph;
+    graph = nullptr;
+
+    source = root;
+    for (int i = 0; i < numVertices; i++) {
+        parent[i] = -1;
+        parentWeight[i] = 0;
+        distance[i] = INT_MAX;
+    }
+    if (source >= 0) {
+        distance[source] = 0;
+    }
+}
+
+void SearchTree::checkVertex(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+}
+
+int SearchTree::getNumVertices() const {
+    return numVertices;
+}
+
+int SearchTree::getSource() const {
+    return source;
+}
+
+bool SearchTree::isReached(int vertex) const {
+    checkVertex(vertex);
+    return distance[vertex] != INT_MAX;
+}
+
+int SearchTree::getParent(int vertex) const {
+    checkVertex(vertex);
+    return parent[vertex];
+}
+
+int SearchTree::getParentWeight(int vertex) const {
+    checkVertex(vertex);
+    return parentWeight[vertex];
+}
+
+int SearchTree::getDistance(int vertex) const {
+    checkVertex(vertex);
+    return distance[vertex];
+}
+
+const int* SearchTree::getParents() const {
+    return parent;
+}
+
+const int* SearchTree::getDistances() const {
+    return distance;
+}
+
+Path SearchTree::pathTo(int vertex) const {
+    checkVertex(vertex);
+    if (distance[vertex] == INT_MAX) {
+        return Path();
+    }
+
+    int length = 1;
+    for (int v = vertex; parent[v] != -1; v = parent[v]) {
+        length++;
+    }
+
+    // Walk up to the root again, filling the path from its end
+    int* vertices = new int[length];
+    int cost = 0;
+    int v = vertex;
+    for (int i = length - 1; i >= 0; i--) {
+        vertices[i] = v;
+        cost += parentWeight[v];
+        v = parent[v];
+    }
+
+    Path path(vertices, length, cost);
+    delete[] vertices;
+    return path;
+}
+
+const Graph& SearchTree::toGraph() const {
+    if (numVertices == 0) {
+        throw "Search tree is empty";
+    }
+    if (!graph) {
+        graph = new Graph(numVertices);
+        toGraph(*graph);
+    }
+    return *graph;
+}
+
+void SearchTree::toGraph(Graph& result) const {
+    if (numVertices == 0) {
+        throw "Search tree is empty";
+    }
+    if (result.getNumVertices() == numVertices) {
+        result.clear();
+    } else {
+        result = Graph(numVertices);
+    }
+
+    for (int i = 0; i < numVertices; i++) {
+        if (parent[i] != -1) {
+            result.addEdge(parent[i], i, parentWeight[i]);
+        }
+    }
+}
+
+} // namespace graph
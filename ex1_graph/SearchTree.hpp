@@ -0,0 +1,69 @@
+// searchtree.hpp
+#ifndef SEARCHTREE_HPP
+#define SEARCHTREE_HPP
+
+#include "Graph.hpp"
+#include "Path.hpp"
+
+namespace graph {
+
+// Result of a BFS, Dijkstra or Prim run kept as plain arrays: the parent of every
+// vertex, the weight of the edge to it and a distance. The tree is only turned into
+// a Graph when asked for.
+//
+// The distance is the number of edges from the source for BFS, the shortest
+// distance for Dijkstra and the weight of the tree path from the root of the
+// vertex's tree for Prim. Unreached vertices have distance INT_MAX.
+class SearchTree {
+public:
+    SearchTree();
+    ~SearchTree();
+
+    // Copy and move
+    SearchTree(const SearchTree& other);
+    SearchTree& operator=(const SearchTree& other);
+    SearchTree(SearchTree&& other) noexcept;
+    SearchTree& operator=(SearchTree&& other) noexcept;
+
+    int getNumVertices() const;
+    int getSource() const;                  // -1 for a spanning forest
+    bool isReached(int vertex) const;
+    int getParent(int vertex) const;        // -1 for the source, tree roots and unreached vertices
+    int getParentWeight(int vertex) const;  // 0 when there is no parent
+    int getDistance(int vertex) const;
+
+    // Raw arrays with one entry per vertex
+    const int* getParents() const;
+    const int* getDistances() const;
+
+    // The tree path from the source (for Prim: the root of the vertex's tree) to
+    // vertex, with the sum of its edge weights. Path() if the vertex was not reached.
+    Path pathTo(int vertex) const;
+
+    // The tree as a graph, built on the first call and kept until the next run
+    // into this object. Edges are added in vertex order.
+    const Graph& toGraph() const;
+
+    // Build the tree into a caller-provided graph, reusing its storage when the
+    // number of vertices matches
+    void toGraph(Graph& result) const;
+
+private:
+    friend class Algorithms;
+
+    int numVertices;
+    int source;
+    int* parent;
+    int* parentWeight;
+    int* distance;
+    mutable Graph* graph; // Built by toGraph()
+
+    // Prepare for a new run: every vertex unreached and without parent. The arrays
+    // are reused when the number of vertices is unchanged.
+    void reset(int vertices, int root);
+    void checkVertex(int vertex) const;
+};
+
+} // namespace graph
+
+#endif // SEARCHTREE_HPP
@@ -255,6 +255,19 @@ public:
     bool connected(int x, int y) {
         return find(x) == find(y);
     }
+    
+    // Find without path compression - never writes, so several threads may call it
+    // at once while no other thread unites sets
+    int root(int x) const {
+        if (x < 0 || x >= size) {
+            throw "Index out of range";
+        }
+        
+        while (parent[x] != x) {
+            x = parent[x];
+        }
+        return x;
+    }
 };
 
 } // namespace graph
@@ -0,0 +1,450 @@
+// vertexordering.cpp
+#include "VertexOrdering.hpp"
+
+namespace graph {
+
+// Orderings are computed on CSR arrays
+
+static int degreeOf(const int* offsets, int vertex) {
+    return offsets[vertex + 1] - offsets[vertex];
+}
+
+// Vertices ordered by degree (ascending or descending), ties by label - a counting sort
+static int* sortedByDegree(const CSRGraph& g, bool descending) {
+    int numVertices = g.getNumVertices();
+    const int* offsets = g.getOffsets();
+    int maxDegree = 0;
+    for (int v = 0; v < numVertices; v++) {
+        if (degreeOf(offsets, v) > maxDegree) {
+            maxDegree = degreeOf(offsets, v);
+        }
+    }
+
+    int* starts = new int[maxDegree + 2];
+    for (int d = 0; d <= maxDegree + 1; d++) {
+        starts[d] = 0;
+    }
+    for (int v = 0; v < numVertices; v++) {
+        int key = descending ? maxDegree - degreeOf(offsets, v) : degreeOf(offsets, v);
+        starts[key + 1]++;
+    }
+    for (int d = 0; d <= maxDegree; d++) {
+        starts[d + 1] += starts[d];
+    }
+
+    int* order = new int[numVertices];
+    for (int v = 0; v < numVertices; v++) {
+        int key = descending ? maxDegree - degreeOf(offsets, v) : degreeOf(offsets, v);
+        order[starts[key]++] = v;
+    }
+    delete[] starts;
+    return order;
+}
+
+static bool lessByDegree(const int* offsets, int a, int b) {
+    int da = degreeOf(offsets, a);
+    int db = degreeOf(offsets, b);
+    return da < db || (da == db && a < b);
+}
+
+// Sort a run of vertices by degree, ties by label. Short runs use insertion sort,
+// long ones (the neighbors of a hub) a bottom-up merge sort through scratch.
+static void sortRunByDegree(int* vertices, int count, const int* offsets, int* scratch) {
+    if (count <= 16) {
+        for (int i = 1; i < count; i++) {
+            int v = vertices[i];
+            int j = i - 1;
+            while (j >= 0 && lessByDegree(offsets, v, vertices[j])) {
+                vertices[j + 1] = vertices[j];
+                j--;
+            }
+            vertices[j + 1] = v;
+        }
+        return;
+    }
+
+    int* from = vertices;
+    int* to = scratch;
+    for (int width = 1; width < count; width *= 2) {
+        for (int left = 0; left < count; left += 2 * width) {
+            int middle = left + width < count ? left + width : count;
+            int right = left + 2 * width < count ? left + 2 * width : count;
+            int i = left;
+            int j = middle;
+            int k = left;
+            while (i < middle && j < right) {
+                to[k++] = lessByDegree(offsets, from[j], from[i]) ? from[j++] : from[i++];
+            }
+            while (i < middle) {
+                to[k++] = from[i++];
+            }
+            while (j < right) {
+                to[k++] = from[j++];
+            }
+        }
+        int* temp = from;
+        from = to;
+        to = temp;
+    }
+    if (from != vertices) {
+        for (int i = 0; i < count; i++) {
+            vertices[i] = from[i];
+        }
+    }
+}
+
+VertexOrdering VertexOrdering::reverseCuthillMcKee(const CSRGraph& g) {
+    int numVertices = g.getNumVertices();
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+
+    int* starts = sortedByDegree(g, false);
+    int* order = new int[numVertices];
+    int* scratch = new int[numVertices];
+    bool* visited = new bool[numVertices];
+    for (int v = 0; v < numVertices; v++) {
+        visited[v] = false;
+    }
+
+    // The order array is the BFS queue; every component starts at its vertex of
+    // smallest degree
+    int head = 0;
+    int tail = 0;
+    for (int s = 0; s < numVertices; s++) {
+        if (visited[starts[s]]) {
+            continue;
+        }
+        visited[starts[s]] = true;
+        order[tail++] = starts[s];
+
+        while (head < tail) {
+            int u = order[head++];
+            int first = tail;
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                if (!visited[destinations[i]]) {
+                    visited[destinations[i]] = true;
+                    order[tail++] = destinations[i];
+                }
+            }
+            sortRunByDegree(order + first, tail - first, offsets, scratch);
+        }
+    }
+
+    for (int i = 0; i < numVertices / 2; i++) {
+        int temp = order[i];
+        order[i] = order[numVertices - 1 - i];
+        order[numVertices - 1 - i] = temp;
+    }
+
+    delete[] visited;
+    delete[] scratch;
+    delete[] starts;
+    return fromOrder(order, numVertices);
+}
+
+VertexOrdering VertexOrdering::degreeDescending(const CSRGraph& g) {
+    return fromOrder(sortedByDegree(g, true), g.getNumVertices());
+}
+
+VertexOrdering VertexOrdering::bfsOrder(const CSRGraph& g, int source) {
+    int numVertices = g.getNumVertices();
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+
+    if (source < 0 || source >= numVertices) {
+        throw "Source vertex out of range";
+    }
+
+    int* order = new int[numVertices];
+    bool* visited = new bool[numVertices];
+    for (int v = 0; v < numVertices; v++) {
+        visited[v] = false;
+    }
+
+    int head = 0;
+    int tail = 0;
+    int next = 0;
+    int start = source;
+    while (tail < numVertices) {
+        visited[start] = true;
+        order[tail++] = start;
+        while (head < tail) {
+            int u = order[head++];
+            for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+                if (!visited[destinations[i]]) {
+                    visited[destinations[i]] = true;
+                    order[tail++] = destinations[i];
+                }
+            }
+        }
+        while (next < numVertices && visited[next]) {
+            next++;
+        }
+        start = next;
+    }
+
+    delete[] visited;
+    return fromOrder(order, numVertices);
+}
+
+VertexOrdering VertexOrdering::reverseCuthillMcKee(const Graph& g) {
+    CSRGraph csr(g);
+    return reverseCuthillMcKee(csr);
+}
+
+VertexOrdering VertexOrdering::degreeDescending(const Graph& g) {
+    CSRGraph csr(g);
+    return degreeDescending(csr);
+}
+
+VertexOrdering VertexOrdering::bfsOrder(const Graph& g, int source) {
+    CSRGraph csr(g);
+    return bfsOrder(csr, source);
+}
+
+// Constructors and the rule of five
+
+VertexOrdering::VertexOrdering() : numVertices(0), relabeled(nullptr), original(nullptr) {}
+
+VertexOrdering::VertexOrdering(const int* order, int vertices)
+    : numVertices(0), relabeled(nullptr), original(nullptr) {
+    if (vertices <= 0) {
+        throw "Number of vertices must be positive";
+    }
+
+    int* labels = new int[vertices];
+    for (int v = 0; v < vertices; v++) {
+        labels[v] = -1;
+    }
+    for (int i = 0; i < vertices; i++) {
+        if (order[i] < 0 || order[i] >= vertices || labels[order[i]] != -1) {
+            delete[] labels;
+            throw "Order is not a permutation";
+        }
+        labels[order[i]] = i;
+    }
+
+    numVertices = vertices;
+    relabeled = labels;
+    original = new int[vertices];
+    for (int i = 0; i < vertices; i++) {
+        original[i] = order[i];
+    }
+}
+
+// Take over an order computed here; it is known to be a permutation
+VertexOrdering VertexOrdering::fromOrder(int* order, int vertices) {
+    VertexOrdering ordering;
+    ordering.numVertices = vertices;
+    ordering.original = order;
+    ordering.relabeled = new int[vertices];
+    for (int i = 0; i < vertices; i++) {
+        ordering.relabeled[order[i]] = i;
+    }
+    return ordering;
+}
+
+VertexOrdering::~VertexOrdering() {
+    delete[] relabeled;
+    delete[] original;
+}
+
+// Copy constructor
+VertexOrdering::VertexOrdering(const VertexOrdering& other)
+    : numVertices(other.numVertices), relabeled(nullptr), original(nullptr) {
+    if (numVertices > 0) {
+        relabeled = new int[numVertices];
+        original = new int[numVertices];
+        for (int i = 0; i < numVertices; i++) {
+            relabeled[i] = other.relabeled[i];
+            original[i] = other.original[i];
+        }
+    }
+}
+
+// Assignment operator
+VertexOrdering& VertexOrdering::operator=(const VertexOrdering& other) {
+    if (this != &other) {
+        VertexOrdering copy(other);
+        *this = static_cast<VertexOrdering&&>(copy);
+    }
+    return *this;
+}
+
+// Move constructor
+VertexOrdering::VertexOrdering(VertexOrdering&& other) noexcept
+    : numVertices(other.numVertices), relabeled(other.relabeled), original(other.original) {
+    other.numVertices = 0;
+    other.relabeled = nullptr;
+    other.original = nullptr;
+}
+
+// Move assignment operator
+VertexOrdering& VertexOrdering::operator=(VertexOrdering&& other) noexcept {
+    if (this != &other) {
+        delete[] relabeled;
+        delete[] original;
+
+        numVertices = other.numVertices;
+        relabeled = other.relabeled;
+        original = other.original;
+
+        other.numVertices = 0;
+        other.relabeled = nullptr;
+        other.original = nullptr;
+    }
+    return *this;
+}
+
+// Mapping
+
+int VertexOrdering::getNumVertices() const {
+    return numVertices;
+}
+
+int VertexOrdering::toRelabeled(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+    return relabeled[vertex];
+}
+
+int VertexOrdering::toOriginal(int vertex) const {
+    if (vertex < 0 || vertex >= numVertices) {
+        throw "Vertex index out of range";
+    }
+    return original[vertex];
+}
+
+void VertexOrdering::checkGraph(int vertices) const {
+    if (vertices != numVertices) {
+        throw "Graph does not match the ordering";
+    }
+}
+
+// Every half-edge under its new labels, sorted by (source, destination) with two
+// stable counting sorts. Walking them in that order and keeping each edge at its
+// smaller end (and every second copy of a self-loop) gives an edge list from which
+// the bulk constructors build sorted neighbor lists.
+WeightedEdge* VertexOrdering::relabeledEdges(const CSRGraph& g, int& edgeCount) const {
+    int halfEdges = g.getNumHalfEdges();
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    const int* weights = g.getWeights();
+
+    int* starts = new int[numVertices + 1];
+    WeightedEdge* byDestination = new WeightedEdge[halfEdges > 0 ? halfEdges : 1];
+    WeightedEdge* sorted = new WeightedEdge[halfEdges > 0 ? halfEdges : 1];
+
+    for (int v = 0; v <= numVertices; v++) {
+        starts[v] = 0;
+    }
+    for (int i = 0; i < halfEdges; i++) {
+        starts[relabeled[destinations[i]] + 1]++;
+    }
+    for (int v = 0; v < numVertices; v++) {
+        starts[v + 1] += starts[v];
+    }
+    for (int u = 0; u < numVertices; u++) {
+        for (int i = offsets[u]; i < offsets[u + 1]; i++) {
+            int d = relabeled[destinations[i]];
+            byDestination[starts[d]++] = WeightedEdge(relabeled[u], d, weights[i]);
+        }
+    }
+
+    for (int v = 0; v <= numVertices; v++) {
+        starts[v] = 0;
+    }
+    for (int i = 0; i < halfEdges; i++) {
+        starts[byDestination[i].source + 1]++;
+    }
+    for (int v = 0; v < numVertices; v++) {
+        starts[v + 1] += starts[v];
+    }
+    for (int i = 0; i < halfEdges; i++) {
+        sorted[starts[byDestination[i].source]++] = byDestination[i];
+    }
+
+    // The edge list reuses the first array; copies of a self-loop sit next to each other
+    edgeCount = 0;
+    bool secondCopy = false;
+    for (int i = 0; i < halfEdges; i++) {
+        if (sorted[i].source < sorted[i].dest) {
+            byDestination[edgeCount++] = sorted[i];
+        } else if (sorted[i].source == sorted[i].dest) {
+            if (secondCopy) {
+                byDestination[edgeCount++] = sorted[i];
+            }
+            secondCopy = !secondCopy;
+        }
+    }
+
+    delete[] sorted;
+    delete[] starts;
+    return byDestination;
+}
+
+Graph VertexOrdering::relabel(const Graph& g) const {
+    checkGraph(g.getNumVertices());
+    CSRGraph csr(g);
+    int edgeCount;
+    WeightedEdge* edges = relabeledEdges(csr, edgeCount);
+    Graph result(numVertices, edges, edgeCount);
+    delete[] edges;
+    return result;
+}
+
+CSRGraph VertexOrdering::relabel(const CSRGraph& g) const {
+    checkGraph(g.getNumVertices());
+    int edgeCount;
+    WeightedEdge* edges = relabeledEdges(g, edgeCount);
+    CSRGraph result(numVertices, edges, edgeCount);
+    delete[] edges;
+    return result;
+}
+
+Graph VertexOrdering::restore(const Graph& relabeledGraph) const {
+    checkGraph(relabeledGraph.getNumVertices());
+    Graph result(numVertices);
+    for (int u = 0; u < numVertices; u++) {
+        bool secondCopy = false;
+        for (Graph::Edge* edge = relabeledGraph.getAdjList(u); edge; edge = edge->next) {
+            if (u < edge->destination || (u == edge->destination && secondCopy)) {
+                result.addEdge(original[u], original[edge->destination], edge->weight);
+            }
+            if (u == edge->destination) {
+                secondCopy = !secondCopy;
+            }
+        }
+    }
+    return result;
+}
+
+Path VertexOrdering::restore(const Path& path) const {
+    if (!path.exists()) {
+        return Path();
+    }
+
+    int* vertices = new int[path.getLength()];
+    for (int i = 0; i < path.getLength(); i++) {
+        vertices[i] = toOriginal(path.getVertex(i));
+    }
+    Path result(vertices, path.getLength(), path.getCost());
+    delete[] vertices;
+    return result;
+}
+
+void VertexOrdering::restoreValues(const int* relabeledValues, int* originalValues) const {
+    for (int v = 0; v < numVertices; v++) {
+        originalValues[original[v]] = relabeledValues[v];
+    }
+}
+
+void VertexOrdering::restoreVertices(const int* relabeledVertices, int* originalVertices) const {
+    for (int v = 0; v < numVertices; v++) {
+        int label = relabeledVertices[v];
+        originalVertices[original[v]] = label == -1 ? -1 : original[label];
+    }
+}
+
+} // namespace graph
@@ -0,0 +1,78 @@
+// vertexordering.hpp
+#ifndef VERTEXORDERING_HPP
+#define VERTEXORDERING_HPP
+
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+#include "Path.hpp"
+
+namespace graph {
+
+// A relabeling of the vertices of a graph, with both directions of the mapping.
+// Relabeling a graph so that neighbors get nearby ids keeps the per-vertex arrays
+// of a traversal (distance, parent, visited) in cache; results computed on the
+// relabeled graph are translated back with the restore methods.
+//
+// Orderings:
+// - reverseCuthillMcKee: BFS from a vertex of minimum degree in every component,
+//   visiting the neighbors of each vertex in order of increasing degree, and the
+//   whole order reversed. Keeps every edge short on mesh- and road-like graphs.
+// - degreeDescending: hubs first, so the most visited entries share cache lines.
+//   Ties keep the original order.
+// - bfsOrder: BFS order from source, then from the lowest unvisited vertex of
+//   each remaining component.
+// The Graph versions convert the graph to CSR once.
+class VertexOrdering {
+public:
+    static VertexOrdering reverseCuthillMcKee(const CSRGraph& g);
+    static VertexOrdering reverseCuthillMcKee(const Graph& g);
+    static VertexOrdering degreeDescending(const CSRGraph& g);
+    static VertexOrdering degreeDescending(const Graph& g);
+    static VertexOrdering bfsOrder(const CSRGraph& g, int source = 0);
+    static VertexOrdering bfsOrder(const Graph& g, int source = 0);
+
+    // An explicit ordering: order[i] is the original vertex that gets label i
+    VertexOrdering(const int* order, int vertices);
+    ~VertexOrdering();
+
+    // Copy and move
+    VertexOrdering(const VertexOrdering& other);
+    VertexOrdering& operator=(const VertexOrdering& other);
+    VertexOrdering(VertexOrdering&& other) noexcept;
+    VertexOrdering& operator=(VertexOrdering&& other) noexcept;
+
+    int getNumVertices() const;
+    int toRelabeled(int original) const;
+    int toOriginal(int relabeled) const;
+
+    // The graph with every vertex renamed. Each vertex's neighbors are stored
+    // together, in order of their new labels where the input order allows.
+    Graph relabel(const Graph& g) const;
+    CSRGraph relabel(const CSRGraph& g) const;
+
+    // Translate results on the relabeled graph back to the original labels
+    Graph restore(const Graph& relabeled) const;
+    Path restore(const Path& path) const;
+
+    // Per-vertex arrays with numVertices entries. restoreValues moves the entries
+    // (distances, flags); restoreVertices also translates them, for arrays of vertex
+    // labels such as parents, and keeps -1 as it is.
+    void restoreValues(const int* relabeledValues, int* originalValues) const;
+    void restoreVertices(const int* relabeledVertices, int* originalVertices) const;
+
+private:
+    int numVertices;
+    int* relabeled;  // Original label -> new label
+    int* original;   // New label -> original label
+
+    VertexOrdering();
+    static VertexOrdering fromOrder(int* order, int vertices);
+    void checkGraph(int vertices) const;
+
+    // Edge list of the relabeled graph, each edge once, sorted by its new ends
+    WeightedEdge* relabeledEdges(const CSRGraph& g, int& edgeCount) const;
+};
+
+} // namespace graph
+
+#endif // VERTEXORDERING_HPP
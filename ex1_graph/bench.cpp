@@ -0,0 +1,998 @@
+// bench.cpp
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+#include "Algorithms.hpp"
+#include "ContractionHierarchy.hpp"
+#include "GraphFile.hpp"
+#include "GraphReader.hpp"
+#include "ConnectivityIndex.hpp"
+#include "DynamicShortestPaths.hpp"
+#include "MinimumSpanningForest.hpp"
+#include "VertexOrdering.hpp"
+#include "CompressedGraph.hpp"
+#include "DenseGraph.hpp"
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Simple linear congruential generator so the benchmark graphs are reproducible
+static int nextRandom(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (int)((state >> 8) & 0x7fffff);
+}
+
+// Build a random graph with numEdges edges and weights in [1, maxWeight]
+static graph::CSRGraph randomCSRGraph(int numVertices, int numEdges, int maxWeight, unsigned int seed) {
+    graph::WeightedEdge* edges = new graph::WeightedEdge[numEdges];
+    for (int i = 0; i < numEdges; i++) {
+        int u = (int)(((long long)nextRandom(seed) << 8 | (nextRandom(seed) & 0xff)) % numVertices);
+        int v = (int)(((long long)nextRandom(seed) << 8 | (nextRandom(seed) & 0xff)) % numVertices);
+        edges[i] = graph::WeightedEdge(u, v, 1 + nextRandom(seed) % maxWeight);
+    }
+    graph::CSRGraph g(numVertices, edges, numEdges);
+    delete[] edges;
+    return g;
+}
+
+// Wall-clock time of a function call in milliseconds
+template <typename Function>
+static double timeMs(Function function) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Hardware cache misses (last-level cache loads that missed) of this thread during a
+// function call, or -1 where the counter is not available
+template <typename Function>
+static long long cacheMisses(Function function) {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd >= 0) {
+        long long count = -1;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        function();
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count)) {
+            count = -1;
+        }
+        close(fd);
+        return count;
+    }
+#endif
+    function();
+    return -1;
+}
+
+// Parallel BFS scaling from 1 to maxThreads threads
+static void benchParallelBfs(int numVertices, int maxThreads) {
+    std::cout << "== Parallel BFS: " << numVertices << " vertices, "
+              << 8 * numVertices << " edges ==" << std::endl;
+
+    graph::CSRGraph g = randomCSRGraph(numVertices, 8 * numVertices, 100, 1);
+    graph::Graph result(numVertices);
+
+    double sequential = timeMs([&]() { graph::Algorithms::bfs(g, 0, result); });
+    std::cout << "bfs (sequential)      " << sequential << " ms" << std::endl;
+
+    double single = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double ms = timeMs([&]() { graph::Algorithms::bfsParallel(g, 0, threads, result); });
+        if (threads == 1) {
+            single = ms;
+        }
+        std::cout << "bfsParallel " << threads << " thread(s) " << ms << " ms, speedup "
+                  << single / ms << "x" << std::endl;
+
+        if (threads < maxThreads && threads * 2 > maxThreads) {
+            threads = maxThreads / 2; // Make sure maxThreads itself is measured
+        }
+    }
+    std::cout << std::endl;
+}
+
+// Dijkstra and Prim with every priority-queue policy
+static void benchQueuePolicies(int numVertices) {
+    std::cout << "== Priority queue policies: " << numVertices << " vertices, "
+              << 4 * numVertices << " edges, weights 1..100 ==" << std::endl;
+
+    graph::CSRGraph g = randomCSRGraph(numVertices, 4 * numVertices, 100, 2);
+    graph::Graph result(numVertices);
+
+    std::cout << "dijkstra BinaryHeapQueue   "
+              << timeMs([&]() { graph::Algorithms::dijkstraWith<graph::BinaryHeapQueue>(g, 0, result); })
+              << " ms" << std::endl;
+    std::cout << "dijkstra DaryHeapQueue<4>  "
+              << timeMs([&]() { graph::Algorithms::dijkstraWith<graph::DaryHeapQueue<4> >(g, 0, result); })
+              << " ms" << std::endl;
+    std::cout << "dijkstra DaryHeapQueue<8>  "
+              << timeMs([&]() { graph::Algorithms::dijkstraWith<graph::DaryHeapQueue<8> >(g, 0, result); })
+              << " ms" << std::endl;
+    std::cout << "dijkstra BucketQueue       "
+              << timeMs([&]() { graph::Algorithms::dijkstraWith<graph::BucketQueue>(g, 0, result); })
+              << " ms" << std::endl;
+
+    std::cout << "prim     BinaryHeapQueue   "
+              << timeMs([&]() { graph::Algorithms::primWith<graph::BinaryHeapQueue>(g, result); })
+              << " ms" << std::endl;
+    std::cout << "prim     DaryHeapQueue<4>  "
+              << timeMs([&]() { graph::Algorithms::primWith<graph::DaryHeapQueue<4> >(g, result); })
+              << " ms" << std::endl;
+    std::cout << "prim     DaryHeapQueue<8>  "
+              << timeMs([&]() { graph::Algorithms::primWith<graph::DaryHeapQueue<8> >(g, result); })
+              << " ms" << std::endl;
+    std::cout << "prim     BucketQueue       "
+              << timeMs([&]() { graph::Algorithms::primWith<graph::BucketQueue>(g, result); })
+              << " ms" << std::endl;
+    std::cout << std::endl;
+}
+
+// Sequential Dijkstra against delta-stepping on 1 to maxThreads threads
+static void benchDeltaStepping(int numVertices, int maxThreads) {
+    std::cout << "== Delta-stepping: " << numVertices << " vertices, "
+              << 4 * numVertices << " edges, weights 1..100 ==" << std::endl;
+
+    graph::CSRGraph g = randomCSRGraph(numVertices, 4 * numVertices, 100, 3);
+    graph::Graph result(numVertices);
+    int* distance = new int[numVertices];
+    int* parent = new int[numVertices];
+
+    std::cout << "dijkstra              "
+              << timeMs([&]() { graph::Algorithms::dijkstra(g, 0, result); }) << " ms" << std::endl;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        std::cout << "deltaStepping " << threads << " thread(s) "
+                  << timeMs([&]() { graph::Algorithms::deltaStepping(g, 0, 32, threads, distance, parent); })
+                  << " ms" << std::endl;
+    }
+    std::cout << std::endl;
+
+    delete[] distance;
+    delete[] parent;
+}
+
+// Building a Graph edge by edge against the bulk loader
+static void benchLoading(int numVertices) {
+    int numEdges = 8 * numVertices;
+    std::cout << "== Graph loading: " << numVertices << " vertices, " << numEdges << " edges ==" << std::endl;
+
+    unsigned int seed = 6;
+    graph::WeightedEdge* edges = new graph::WeightedEdge[numEdges];
+    for (int i = 0; i < numEdges; i++) {
+        int u = (int)(((long long)nextRandom(seed) << 8 | (nextRandom(seed) & 0xff)) % numVertices);
+        int v = (int)(((long long)nextRandom(seed) << 8 | (nextRandom(seed) & 0xff)) % numVertices);
+        edges[i] = graph::WeightedEdge(u, v, 1 + nextRandom(seed) % 100);
+    }
+
+    graph::Graph* single = nullptr;
+    graph::Graph* bulk = nullptr;
+    std::cout << "addEdge               "
+              << timeMs([&]() {
+                     single = new graph::Graph(numVertices);
+                     for (int i = 0; i < numEdges; i++) {
+                         single->addEdge(edges[i].source, edges[i].dest, edges[i].weight);
+                     }
+                 })
+              << " ms" << std::endl;
+    std::cout << "addEdges (bulk)       "
+              << timeMs([&]() { bulk = new graph::Graph(numVertices, edges, numEdges); }) << " ms" << std::endl;
+
+    // Traversal speed depends on where the neighbors ended up in memory
+    graph::Graph result(numVertices);
+    std::cout << "bfs on addEdge graph  "
+              << timeMs([&]() { graph::Algorithms::bfs(*single, 0, result); }) << " ms" << std::endl;
+    std::cout << "bfs on bulk graph     "
+              << timeMs([&]() { graph::Algorithms::bfs(*bulk, 0, result); }) << " ms" << std::endl;
+    std::cout << std::endl;
+
+    delete single;
+    delete bulk;
+    delete[] edges;
+}
+
+// Single-source queries returning a tree graph against a reused SearchTree
+static void benchSearchTree(int numVertices) {
+    std::cout << "== Search tree results: " << numVertices << " vertices, " << 4 * numVertices << " edges =="
+              << std::endl;
+
+    graph::CSRGraph g = randomCSRGraph(numVertices, 4 * numVertices, 100, 17);
+    graph::Graph result(numVertices);
+    graph::SearchTree tree;
+
+    std::cout << "dijkstra -> Graph     "
+              << timeMs([&]() { graph::Algorithms::dijkstra(g, 0, result); }) << " ms" << std::endl;
+    std::cout << "dijkstraTree          "
+              << timeMs([&]() { graph::Algorithms::dijkstraTree(g, 0, tree); }) << " ms" << std::endl;
+    std::cout << "bfs -> Graph          "
+              << timeMs([&]() { graph::Algorithms::bfs(g, 0, result); }) << " ms" << std::endl;
+    std::cout << "bfsTree               "
+              << timeMs([&]() { graph::Algorithms::bfsTree(g, 0, tree); }) << " ms" << std::endl;
+    std::cout << "prim -> Graph         "
+              << timeMs([&]() { graph::Algorithms::prim(g, result); }) << " ms" << std::endl;
+    std::cout << "primTree              "
+              << timeMs([&]() { graph::Algorithms::primTree(g, tree); }) << " ms" << std::endl;
+    std::cout << std::endl;
+}
+
+// Distance table from 64 sources: one dijkstra call per source against the batch API
+static void benchDistanceTable(int numVertices, int maxThreads) {
+    int tableVertices = numVertices / 10 > 1 ? numVertices / 10 : 2;
+    const int numSources = 64;
+    std::cout << "== Distance table: " << numSources << " sources, " << tableVertices << " vertices, "
+              << 4 * tableVertices << " edges ==" << std::endl;
+
+    graph::CSRGraph g = randomCSRGraph(tableVertices, 4 * tableVertices, 100, 19);
+    int sources[numSources];
+    unsigned int seed = 23;
+    for (int i = 0; i < numSources; i++) {
+        sources[i] = nextRandom(seed) % tableVertices;
+    }
+
+    std::cout << "dijkstra per source   "
+              << timeMs([&]() {
+                     for (int i = 0; i < numSources; i++) {
+                         graph::Graph tree = graph::Algorithms::dijkstra(g, sources[i]);
+                     }
+                 })
+              << " ms" << std::endl;
+
+    graph::DistanceTable table;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        std::cout << "batch, " << threads << " thread(s)    "
+                  << timeMs([&]() { graph::Algorithms::multiSourceDistances(g, sources, numSources, threads, table); })
+                  << " ms" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+// Small neighborhood queries: bounded searches in a reused QueryContext against full
+// searches into a reused SearchTree, which still clear V entries per query
+static void benchBoundedQueries(int numVertices) {
+    const int queries = 1000;
+    const int fullQueries = 20;
+    std::cout << "== Bounded queries: " << numVertices << " vertices, " << 4 * numVertices << " edges =="
+              << std::endl;
+
+    graph::CSRGraph g = randomCSRGraph(numVertices, 4 * numVertices, 100, 29);
+    int* sources = new int[queries];
+    unsigned int seed = 31;
+    for (int i = 0; i < queries; i++) {
+        sources[i] = nextRandom(seed) % numVertices;
+    }
+
+    graph::QueryContext context;
+    graph::SearchTree tree;
+    long long reached = 0;
+
+    double hopsMs = timeMs([&]() {
+        for (int i = 0; i < queries; i++) {
+            reached += graph::Algorithms::boundedBfs(g, sources[i], 3, context);
+        }
+    });
+    double radiusMs = timeMs([&]() {
+        for (int i = 0; i < queries; i++) {
+            reached += graph::Algorithms::boundedDijkstra(g, sources[i], 100, context);
+        }
+    });
+    double bfsMs = timeMs([&]() {
+        for (int i = 0; i < fullQueries; i++) {
+            graph::Algorithms::bfsTree(g, sources[i], tree);
+        }
+    });
+    double dijkstraMs = timeMs([&]() {
+        for (int i = 0; i < fullQueries; i++) {
+            graph::Algorithms::dijkstraTree(g, sources[i], tree);
+        }
+    });
+
+    std::cout << "boundedBfs, 3 hops    " << 1000.0 * hopsMs / queries << " us" << std::endl;
+    std::cout << "boundedDijkstra, 100  " << 1000.0 * radiusMs / queries << " us" << std::endl;
+    std::cout << "bfsTree (full)        " << 1000.0 * bfsMs / fullQueries << " us" << std::endl;
+    std::cout << "dijkstraTree (full)   " << 1000.0 * dijkstraMs / fullQueries << " us" << std::endl;
+    std::cout << "(" << reached / (2 * queries) << " vertices reached per bounded query)" << std::endl
+              << std::endl;
+
+    delete[] sources;
+}
+
+// Connectivity queries from the incremental index against a BFS per query, and the
+// cost of keeping the index up to date
+static void benchConnectivity(int numVertices) {
+    const int queries = 1000000;
+    const int removals = 1000;
+    std::cout << "== Connectivity index: " << numVertices << " vertices, " << numVertices << " edges =="
+              << std::endl;
+
+    graph::WeightedEdge* edges = new graph::WeightedEdge[numVertices];
+    unsigned int seed = 37;
+    for (int i = 0; i < numVertices; i++) {
+        edges[i] = graph::WeightedEdge(nextRandom(seed) % numVertices, nextRandom(seed) % numVertices);
+    }
+
+    graph::Graph plain(numVertices);
+    graph::Graph tracked(numVertices);
+    tracked.trackConnectivity(true);
+    std::cout << "addEdge, untracked    " << timeMs([&]() {
+        for (int i = 0; i < numVertices; i++) {
+            plain.addEdge(edges[i].source, edges[i].dest);
+        }
+    }) << " ms" << std::endl;
+    std::cout << "addEdge, tracked      " << timeMs([&]() {
+        for (int i = 0; i < numVertices; i++) {
+            tracked.addEdge(edges[i].source, edges[i].dest);
+        }
+    }) << " ms" << std::endl;
+
+    const graph::ConnectivityIndex& index = tracked.getConnectivity();
+    long long connected = 0;
+    double queryMs = timeMs([&]() {
+        for (int i = 0; i < queries; i++) {
+            connected += index.connected(nextRandom(seed) % numVertices, nextRandom(seed) % numVertices);
+        }
+    });
+    graph::SearchTree tree;
+    double bfsMs = timeMs([&]() { graph::Algorithms::bfsTree(plain, 0, tree); });
+    std::cout << "connected()           " << 1000000.0 * queryMs / queries << " ns" << std::endl;
+    std::cout << "bfsTree per query     " << 1000.0 * bfsMs << " us" << std::endl;
+
+    double removeMs = timeMs([&]() {
+        for (int i = 0; i < removals; i++) {
+            tracked.removeEdge(edges[i].source, edges[i].dest);
+        }
+    });
+    std::cout << "removeEdge, tracked   " << 1000.0 * removeMs / removals << " us" << std::endl;
+    std::cout << "(" << index.getNumComponents() << " components, " << connected << " connected pairs)"
+              << std::endl << std::endl;
+
+    delete[] edges;
+}
+
+// Weight changes repaired in a dynamic shortest-path tree against rerunning Dijkstra
+static void benchDynamicPaths(int numVertices) {
+    const int updates = 1000;
+    std::cout << "== Dynamic shortest paths: " << numVertices << " vertices, " << 4 * numVertices
+              << " edges, " << updates << " weight changes ==" << std::endl;
+
+    graph::WeightedEdge* edges = new graph::WeightedEdge[4 * numVertices];
+    unsigned int seed = 41;
+    for (int i = 0; i < 4 * numVertices; i++) {
+        edges[i] = graph::WeightedEdge(nextRandom(seed) % numVertices, nextRandom(seed) % numVertices,
+                                       1 + nextRandom(seed) % 100);
+    }
+    graph::Graph g(numVertices, edges, 4 * numVertices);
+    delete[] edges;
+
+    graph::DynamicShortestPaths* paths = nullptr;
+    std::cout << "initial tree          "
+              << timeMs([&]() { paths = new graph::DynamicShortestPaths(g, 0); }) << " ms" << std::endl;
+
+    // Half of the changes make an edge heavier, half make one lighter
+    long long repaired = 0;
+    double repairMs = timeMs([&]() {
+        for (int i = 0; i < updates; i++) {
+            int u = nextRandom(seed) % numVertices;
+            graph::Graph::Edge* edge = g.getAdjList(u);
+            if (!edge) {
+                continue;
+            }
+            int v = edge->destination;
+            g.setWeight(u, v, i % 2 ? edge->weight * 3 : edge->weight / 3);
+            paths->edgeChanged(u, v);
+            repaired += paths->getLastRepairSize();
+        }
+    });
+    graph::SearchTree tree;
+    double fullMs = timeMs([&]() { graph::Algorithms::dijkstraTree(g, 0, tree); });
+
+    std::cout << "edgeChanged           " << 1000.0 * repairMs / updates << " us ("
+              << (double)repaired / updates << " vertices repaired on average)" << std::endl;
+    std::cout << "dijkstraTree rerun    " << fullMs << " ms" << std::endl << std::endl;
+
+    delete paths;
+}
+
+// Edge insertions and removals in a maintained spanning forest against rebuilding
+// it with Kruskal
+static void benchSpanningForest(int numVertices) {
+    const int insertions = 100000;
+    const int removals = 1000;
+    std::cout << "== Spanning forest maintenance: " << numVertices << " vertices, " << 2 * numVertices
+              << " edges ==" << std::endl;
+
+    graph::WeightedEdge* edges = new graph::WeightedEdge[2 * numVertices];
+    unsigned int seed = 43;
+    for (int i = 0; i < 2 * numVertices; i++) {
+        edges[i] = graph::WeightedEdge(nextRandom(seed) % numVertices, nextRandom(seed) % numVertices,
+                                       1 + nextRandom(seed) % 1000);
+    }
+    graph::Graph g(numVertices, edges, 2 * numVertices);
+    delete[] edges;
+
+    graph::MinimumSpanningForest* forest = nullptr;
+    std::cout << "initial forest        "
+              << timeMs([&]() { forest = new graph::MinimumSpanningForest(g); }) << " ms" << std::endl;
+    graph::Graph rebuilt(numVertices);
+    std::cout << "kruskal rebuild       " << timeMs([&]() { graph::Algorithms::kruskal(g, rebuilt); })
+              << " ms" << std::endl;
+
+    double insertMs = timeMs([&]() {
+        for (int i = 0; i < insertions; i++) {
+            int u = nextRandom(seed) % numVertices;
+            int v = nextRandom(seed) % numVertices;
+            int weight = 1 + nextRandom(seed) % 1000;
+            g.addEdge(u, v, weight);
+            forest->edgeAdded(u, v, weight);
+        }
+    });
+    double removeMs = timeMs([&]() {
+        for (int i = 0; i < removals; i++) {
+            int u = nextRandom(seed) % numVertices;
+            graph::Graph::Edge* edge = g.getAdjList(u);
+            if (edge) {
+                int v = edge->destination;
+                g.removeEdge(u, v);
+                forest->edgeRemoved(u, v);
+            }
+        }
+    });
+    std::cout << "edgeAdded             " << 1000.0 * insertMs / insertions << " us" << std::endl;
+    std::cout << "edgeRemoved           " << 1000.0 * removeMs / removals << " us" << std::endl;
+    std::cout << "(forest weight " << forest->getTotalWeight() << ", " << forest->getNumEdges() << " edges)"
+              << std::endl << std::endl;
+
+    delete forest;
+}
+
+// BFS and Dijkstra over one labeling of a graph: time, cache misses and the average
+// label distance between the endpoints of an edge
+static void benchLabeling(const char* label, const graph::CSRGraph& g, int source) {
+    double gap = 0;
+    for (int u = 0; u < g.getNumVertices(); u++) {
+        for (int i = 0; i < g.getDegree(u); i++) {
+            gap += std::abs(g.getNeighbors(u)[i] - u);
+        }
+    }
+    gap /= g.getNumHalfEdges() > 0 ? g.getNumHalfEdges() : 1;
+
+    graph::SearchTree tree;
+    graph::Algorithms::bfsTree(g, source, tree); // Allocate the tree outside the timing
+    double bfsMs = 0;
+    double dijkstraMs = 0;
+    long long bfsMisses = cacheMisses([&]() {
+        bfsMs = timeMs([&]() { graph::Algorithms::bfsTree(g, source, tree); });
+    });
+    long long dijkstraMisses = cacheMisses([&]() {
+        dijkstraMs = timeMs([&]() { graph::Algorithms::dijkstraTree(g, source, tree); });
+    });
+
+    char bfsText[24] = "n/a";
+    char dijkstraText[24] = "n/a";
+    if (bfsMisses >= 0) {
+        std::snprintf(bfsText, sizeof(bfsText), "%lld", bfsMisses / 1000);
+    }
+    if (dijkstraMisses >= 0) {
+        std::snprintf(dijkstraText, sizeof(dijkstraText), "%lld", dijkstraMisses / 1000);
+    }
+    std::printf("%-13s %12.0f %9.1f %14s %14.1f %10s\n", label, gap, bfsMs, bfsText, dijkstraMs, dijkstraText);
+}
+
+// The same traversals after relabeling the vertices of a graph with shuffled labels
+static void benchOrderings(const char* title, const graph::CSRGraph& g) {
+    std::cout << "== Vertex ordering, " << title << ": " << g.getNumVertices() << " vertices, "
+              << g.getNumHalfEdges() / 2 << " edges ==" << std::endl;
+    std::cout << "ordering         edge gap  bfs (ms)  bfs misses/1k  dijkstra (ms)  misses/1k" << std::endl;
+
+    benchLabeling("shuffled", g, 0);
+    graph::VertexOrdering* ordering = nullptr;
+    double orderMs = timeMs([&]() {
+        ordering = new graph::VertexOrdering(graph::VertexOrdering::reverseCuthillMcKee(g));
+    });
+    benchLabeling("rcm", ordering->relabel(g), ordering->toRelabeled(0));
+    std::cout << "(rcm ordering " << orderMs << " ms, relabel "
+              << timeMs([&]() { ordering->relabel(g); }) << " ms)" << std::endl;
+    delete ordering;
+
+    graph::VertexOrdering byDegree = graph::VertexOrdering::degreeDescending(g);
+    benchLabeling("degree", byDegree.relabel(g), byDegree.toRelabeled(0));
+    graph::VertexOrdering bfs = graph::VertexOrdering::bfsOrder(g, 0);
+    benchLabeling("bfs", bfs.relabel(g), 0);
+    std::cout << std::endl;
+}
+
+// Locality of a road-like grid and of a random graph, both with shuffled labels
+static void benchVertexOrdering(int numVertices) {
+    int side = (int)std::sqrt((double)numVertices);
+    int* label = new int[side * side];
+    for (int i = 0; i < side * side; i++) {
+        label[i] = i;
+    }
+    unsigned int seed = 59;
+    for (int i = side * side - 1; i > 0; i--) {
+        int j = (int)(((long long)nextRandom(seed) << 8 | (nextRandom(seed) & 0xff)) % (i + 1));
+        int temp = label[i];
+        label[i] = label[j];
+        label[j] = temp;
+    }
+
+    int numEdges = 2 * side * (side - 1);
+    graph::WeightedEdge* edges = new graph::WeightedEdge[numEdges];
+    int count = 0;
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) {
+            int v = label[y * side + x];
+            if (x + 1 < side) {
+                edges[count++] = graph::WeightedEdge(v, label[y * side + x + 1], 1 + nextRandom(seed) % 100);
+            }
+            if (y + 1 < side) {
+                edges[count++] = graph::WeightedEdge(v, label[(y + 1) * side + x], 1 + nextRandom(seed) % 100);
+            }
+        }
+    }
+    graph::CSRGraph grid(side * side, edges, numEdges);
+    delete[] edges;
+    delete[] label;
+
+    benchOrderings("shuffled grid", grid);
+    benchOrderings("random graph", randomCSRGraph(numVertices, 4 * numVertices, 100, 61));
+}
+
+// Visitor that only counts discovered vertices
+class CountingVisitor : public graph::DfsVisitor {
+public:
+    long long discovered;
+
+    CountingVisitor() : discovered(0) {}
+
+    void discoverVertex(int) {
+        discovered++;
+    }
+};
+
+// Memory and traversal speed of one graph as Graph, CSRGraph and CompressedGraph
+static void benchCompressedGraph(const char* title, const graph::CSRGraph& g) {
+    std::cout << "== Compressed storage, " << title << ": " << g.getNumVertices() << " vertices, "
+              << g.getNumEdges() << " edges ==" << std::endl;
+
+    graph::CompressedGraph* compressed = nullptr;
+    double buildMs = timeMs([&]() { compressed = new graph::CompressedGraph(g); });
+
+    // Graph: one list node per half-edge plus the list head, degree and index arrays
+    long long vertices = g.getNumVertices();
+    long long graphBytes = g.getNumHalfEdges() * (long long)sizeof(graph::Graph::Edge) +
+                           vertices * (2 * sizeof(void*) + sizeof(int));
+    long long csrBytes = (vertices + 1) * sizeof(int) + g.getNumHalfEdges() * 2LL * sizeof(int);
+    long long compressedBytes = compressed->getMemoryBytes();
+    std::printf("memory: Graph %.1f MB, CSR %.1f MB, compressed %.1f MB (%.1fx / %.1fx smaller, "
+                "%d weight byte(s))\n", graphBytes / 1e6, csrBytes / 1e6, compressedBytes / 1e6,
+                (double)graphBytes / compressedBytes, (double)csrBytes / compressedBytes,
+                compressed->getWeightBytes());
+    std::cout << "compress              " << buildMs << " ms" << std::endl;
+
+    graph::SearchTree tree;
+    graph::Algorithms::bfsTree(g, 0, tree);
+    std::cout << "bfsTree CSR           " << timeMs([&]() { graph::Algorithms::bfsTree(g, 0, tree); })
+              << " ms" << std::endl;
+    std::cout << "bfsTree compressed    "
+              << timeMs([&]() { graph::Algorithms::bfsTree(*compressed, 0, tree); }) << " ms" << std::endl;
+
+    CountingVisitor csrVisitor;
+    CountingVisitor compressedVisitor;
+    std::cout << "dfs CSR               "
+              << timeMs([&]() { graph::Algorithms::depthFirstSearchAll(g, csrVisitor); }) << " ms" << std::endl;
+    std::cout << "dfs compressed        "
+              << timeMs([&]() { graph::Algorithms::depthFirstSearchAll(*compressed, compressedVisitor); })
+              << " ms" << std::endl;
+    std::cout << "(" << compressedVisitor.discovered << " vertices visited)" << std::endl << std::endl;
+
+    delete compressed;
+}
+
+// A random graph, where most gaps between neighbors take three bytes, and a grid
+// in row order, where they take one
+static void benchCompression(int numVertices) {
+    benchCompressedGraph("random graph", randomCSRGraph(numVertices, 4 * numVertices, 100, 67));
+
+    int side = (int)std::sqrt((double)numVertices);
+    int numEdges = 2 * side * (side - 1);
+    graph::WeightedEdge* edges = new graph::WeightedEdge[numEdges];
+    unsigned int seed = 71;
+    int count = 0;
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) {
+            if (x + 1 < side) {
+                edges[count++] = graph::WeightedEdge(y * side + x, y * side + x + 1, 1 + nextRandom(seed) % 100);
+            }
+            if (y + 1 < side) {
+                edges[count++] = graph::WeightedEdge(y * side + x, (y + 1) * side + x, 1 + nextRandom(seed) % 100);
+            }
+        }
+    }
+    graph::CSRGraph grid(side * side, edges, numEdges);
+    delete[] edges;
+    benchCompressedGraph("grid", grid);
+}
+
+// Common neighbors of two vertices by merging their sorted lists
+static int mergeCommonNeighbors(const graph::CSRGraph& g, int u, int v) {
+    const int* offsets = g.getOffsets();
+    const int* destinations = g.getDestinations();
+    int i = offsets[u];
+    int j = offsets[v];
+    int common = 0;
+    while (i < offsets[u + 1] && j < offsets[v + 1]) {
+        if (destinations[i] < destinations[j]) {
+            i++;
+        } else if (destinations[i] > destinations[j]) {
+            j++;
+        } else {
+            common++;
+            i++;
+            j++;
+        }
+    }
+    return common;
+}
+
+// Bit matrix against adjacency lists on a random graph with 30% of all possible edges
+static void benchDenseGraph(int numVertices) {
+    int vertices = numVertices < 4096 ? numVertices : 4096;
+    graph::DenseGraph dense(vertices);
+    unsigned int seed = 73;
+    for (int u = 0; u < vertices; u++) {
+        for (int v = u + 1; v < vertices; v++) {
+            if (nextRandom(seed) % 100 < 30) {
+                dense.addEdge(u, v);
+            }
+        }
+    }
+    // The same edges as adjacency lists, each one sorted
+    graph::CSRGraph g = graph::CompressedGraph(graph::CSRGraph(dense.toGraph())).toCSR();
+    std::cout << "== Dense graph: " << vertices << " vertices, " << dense.getNumEdges() << " edges, AVX2 "
+              << (graph::DenseGraph::hasAvx2() ? "available" : "not available") << " ==" << std::endl;
+
+    long long graphBytes = g.getNumHalfEdges() * (long long)sizeof(graph::Graph::Edge) +
+                           (long long)vertices * (2 * sizeof(void*) + sizeof(int));
+    long long csrBytes = (vertices + 1LL) * sizeof(int) + g.getNumHalfEdges() * 2LL * sizeof(int);
+    long long denseBytes = (long long)vertices * dense.getRowWords() * sizeof(unsigned long long);
+    std::printf("memory: Graph %.1f MB, CSR %.1f MB, bit matrix %.1f MB\n", graphBytes / 1e6, csrBytes / 1e6,
+                denseBytes / 1e6);
+
+    graph::SearchTree tree;
+    graph::Algorithms::bfsTree(g, 0, tree);
+    std::cout << "bfsTree CSR           " << timeMs([&]() { graph::Algorithms::bfsTree(g, 0, tree); })
+              << " ms" << std::endl;
+    std::cout << "bfsTree bit matrix    " << timeMs([&]() { graph::Algorithms::bfsTree(dense, 0, tree); })
+              << " ms" << std::endl;
+
+    const int pairs = 200000;
+    int* us = new int[pairs];
+    int* vs = new int[pairs];
+    for (int i = 0; i < pairs; i++) {
+        us[i] = nextRandom(seed) % vertices;
+        vs[i] = nextRandom(seed) % vertices;
+    }
+    long long mergeTotal = 0;
+    long long scalarTotal = 0;
+    long long avx2Total = 0;
+    double mergeMs = timeMs([&]() {
+        for (int i = 0; i < pairs; i++) {
+            mergeTotal += mergeCommonNeighbors(g, us[i], vs[i]);
+        }
+    });
+    bool avx2 = graph::DenseGraph::isAvx2Enabled();
+    graph::DenseGraph::setAvx2Enabled(false);
+    double scalarMs = timeMs([&]() {
+        for (int i = 0; i < pairs; i++) {
+            scalarTotal += dense.countCommonNeighbors(us[i], vs[i]);
+        }
+    });
+    graph::DenseGraph::setAvx2Enabled(true);
+    double avx2Ms = timeMs([&]() {
+        for (int i = 0; i < pairs; i++) {
+            avx2Total += dense.countCommonNeighbors(us[i], vs[i]);
+        }
+    });
+    graph::DenseGraph::setAvx2Enabled(avx2);
+    std::cout << "common neighbors of " << pairs << " pairs:" << std::endl;
+    std::cout << "  sorted-list merge   " << mergeMs << " ms" << std::endl;
+    std::cout << "  bit matrix, scalar  " << scalarMs << " ms" << std::endl;
+    std::cout << "  bit matrix, AVX2    " << avx2Ms << " ms"
+              << (graph::DenseGraph::hasAvx2() ? "" : " (scalar kernels - no AVX2)") << std::endl;
+    std::cout << "(" << mergeTotal << " common neighbors"
+              << (mergeTotal == scalarTotal && mergeTotal == avx2Total ? "" : " - MISMATCH") << ")" << std::endl
+              << std::endl;
+
+    delete[] us;
+    delete[] vs;
+}
+
+// Deleting every edge of a hub vertex in random order, with and without the hash index
+static void benchEdgeChurn(int numVertices) {
+    int hubDegree = numVertices / 10 < 20000 ? numVertices / 10 : 20000;
+    std::cout << "== Edge churn: hub with " << hubDegree << " neighbors ==" << std::endl;
+
+    int* order = new int[hubDegree];
+    unsigned int seed = 13;
+    for (int i = 0; i < hubDegree; i++) {
+        order[i] = i + 1;
+    }
+    for (int i = hubDegree - 1; i > 0; i--) {
+        int j = nextRandom(seed) % (i + 1);
+        int temp = order[i];
+        order[i] = order[j];
+        order[j] = temp;
+    }
+
+    const int thresholds[2] = { graph::Graph::NO_INDEX, graph::Graph::DEFAULT_INDEX_THRESHOLD };
+    const char* names[2] = { "removeEdge, no index  ", "removeEdge, indexed   " };
+    for (int k = 0; k < 2; k++) {
+        graph::Graph g(hubDegree + 1);
+        g.setIndexThreshold(thresholds[k]);
+        for (int v = 1; v <= hubDegree; v++) {
+            g.addEdge(0, v, v);
+        }
+        long long total = 0;
+        std::cout << "getWeight             "
+                  << timeMs([&]() {
+                         for (int i = 0; i < hubDegree; i++) {
+                             total += g.getWeight(order[i], 0);
+                         }
+                     })
+                  << " ms" << std::endl;
+        std::cout << names[k]
+                  << timeMs([&]() {
+                         for (int i = 0; i < hubDegree; i++) {
+                             g.removeEdge(0, order[i]);
+                         }
+                     })
+                  << " ms" << std::endl;
+    }
+    std::cout << std::endl;
+
+    delete[] order;
+}
+
+// Opening a binary graph file by mapping it, against building the graph again
+static void benchGraphFile(int numVertices) {
+    std::cout << "== Graph file: " << numVertices << " vertices, " << 8 * numVertices << " edges ==" << std::endl;
+
+    graph::CSRGraph g = randomCSRGraph(numVertices, 8 * numVertices, 100, 7);
+    const char* filename = "bench_graph.bin";
+    std::cout << "write                 "
+              << timeMs([&]() { graph::GraphFile::write(filename, g); }) << " ms" << std::endl;
+    std::cout << "rebuild from edges    "
+              << timeMs([&]() { graph::CSRGraph rebuilt = randomCSRGraph(numVertices, 8 * numVertices, 100, 7); })
+              << " ms" << std::endl;
+
+    graph::MappedGraph* mapped = nullptr;
+    std::cout << "map, offsets checked  "
+              << timeMs([&]() { mapped = new graph::MappedGraph(filename, false); }) << " ms" << std::endl;
+    delete mapped;
+    std::cout << "map, all checked      "
+              << timeMs([&]() { mapped = new graph::MappedGraph(filename); }) << " ms" << std::endl;
+    graph::Graph result(numVertices);
+    std::cout << "bfs on mapped graph   "
+              << timeMs([&]() { graph::Algorithms::bfs(mapped->getGraph(), 0, result); }) << " ms" << std::endl;
+    std::cout << std::endl;
+
+    delete mapped;
+    std::remove(filename);
+}
+
+// Parsing a SNAP edge list on 1 to maxThreads threads
+static void benchParsing(int numVertices, int maxThreads) {
+    int numEdges = 8 * numVertices;
+    std::cout << "== Edge list parsing: " << numVertices << " vertices, " << numEdges << " edges ==" << std::endl;
+
+    const char* filename = "bench_edges.txt";
+    FILE* file = std::fopen(filename, "wb");
+    if (!file) {
+        throw "Cannot open file for writing";
+    }
+    unsigned int seed = 11;
+    std::fprintf(file, "# Random graph\n");
+    for (int i = 0; i < numEdges; i++) {
+        int u = nextRandom(seed) % numVertices;
+        int v = nextRandom(seed) % numVertices;
+        std::fprintf(file, "%d\t%d\t%d\n", u, v, 1 + nextRandom(seed) % 100);
+    }
+    std::fclose(file);
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        int n = 0;
+        int edgeCount = 0;
+        std::cout << "edges, " << threads << " thread(s)   "
+                  << timeMs([&]() {
+                         delete[] graph::GraphReader::readEdges(filename, graph::FORMAT_SNAP,
+                                                                graph::ReaderOptions(threads), n, edgeCount);
+                     })
+                  << " ms" << std::endl;
+    }
+    std::cout << "graph, " << maxThreads << " thread(s)   "
+              << timeMs([&]() { graph::Graph g = graph::GraphReader::readSnap(filename, graph::ReaderOptions(maxThreads)); })
+              << " ms" << std::endl;
+    std::cout << std::endl;
+
+    std::remove(filename);
+}
+
+// Kruskal with the radix-sorted edge list on 1 to maxThreads threads, and Prim
+static void benchSpanningTree(int numVertices, int maxThreads) {
+    std::cout << "== Minimum spanning tree: " << numVertices << " vertices, "
+              << 4 * numVertices << " edges, weights 1..1000000 ==" << std::endl;
+
+    graph::CSRGraph g = randomCSRGraph(numVertices, 4 * numVertices, 1000000, 5);
+    graph::Graph result(numVertices);
+
+    std::cout << "prim                  "
+              << timeMs([&]() { graph::Algorithms::prim(g, result); }) << " ms" << std::endl;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        std::cout << "kruskal " << threads << " thread(s)    "
+                  << timeMs([&]() { graph::Algorithms::kruskal(g, result, threads); }) << " ms" << std::endl;
+        std::cout << "filterKruskal " << threads << " thread(s) "
+                  << timeMs([&]() { graph::Algorithms::filterKruskal(g, threads, result); }) << " ms" << std::endl;
+        std::cout << "boruvka " << threads << " thread(s)    "
+                  << timeMs([&]() { graph::Algorithms::boruvka(g, threads, result); }) << " ms" << std::endl;
+
+        if (threads < maxThreads && threads * 2 > maxThreads) {
+            threads = maxThreads / 2; // Make sure maxThreads itself is measured
+        }
+    }
+    std::cout << std::endl;
+}
+
+// Road-like grid: Dijkstra, bidirectional Dijkstra and contraction-hierarchy queries
+static void benchContractionHierarchy(int numVertices) {
+    int side = (int)std::sqrt((double)numVertices);
+    std::cout << "== Contraction hierarchy: " << side << "x" << side << " grid, weights 1..100 ==" << std::endl;
+
+    unsigned int seed = 4;
+    graph::Graph g(side * side);
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) {
+            int v = y * side + x;
+            if (x + 1 < side) {
+                g.addEdge(v, v + 1, 1 + nextRandom(seed) % 100);
+            }
+            if (y + 1 < side) {
+                g.addEdge(v, v + side, 1 + nextRandom(seed) % 100);
+            }
+        }
+    }
+
+    graph::ContractionHierarchy* ch = nullptr;
+    double preprocessing = timeMs([&]() { ch = new graph::ContractionHierarchy(g); });
+    std::cout << "preprocessing         " << preprocessing << " ms, "
+              << ch->getNumShortcuts() << " shortcuts" << std::endl;
+
+    const int queries = 1000;
+    int* sources = new int[queries];
+    int* targets = new int[queries];
+    for (int i = 0; i < queries; i++) {
+        sources[i] = nextRandom(seed) % (side * side);
+        targets[i] = nextRandom(seed) % (side * side);
+    }
+
+    long long checksum = 0;
+    double chMs = timeMs([&]() {
+        for (int i = 0; i < queries; i++) {
+            checksum += ch->distance(sources[i], targets[i]);
+        }
+    });
+    graph::QueryContext forward;
+    graph::QueryContext backward;
+    double bidirectionalMs = timeMs([&]() {
+        for (int i = 0; i < 20; i++) {
+            checksum += graph::Algorithms::bidirectionalDijkstra(g, sources[i], targets[i], forward, backward)
+                            .getCost();
+        }
+    });
+    graph::Graph tree(side * side);
+    double dijkstraMs = timeMs([&]() {
+        for (int i = 0; i < 20; i++) {
+            graph::Algorithms::dijkstra(g, sources[i], tree);
+        }
+    });
+
+    std::cout << "ch query              " << 1000.0 * chMs / queries << " us" << std::endl;
+    std::cout << "bidirectional query   " << 1000.0 * bidirectionalMs / 20 << " us" << std::endl;
+    std::cout << "dijkstra (full tree)  " << 1000.0 * dijkstraMs / 20 << " us" << std::endl;
+    std::cout << "(checksum " << checksum << ")" << std::endl << std::endl;
+
+    delete[] sources;
+    delete[] targets;
+    delete ch;
+}
+
+// Usage: bench [name|all] [vertices] [threads]
+int main(int argc, char* argv[]) {
+    const char* name = argc > 1 ? argv[1] : "all";
+    int numVertices = argc > 2 ? std::atoi(argv[2]) : 1000000;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : (int)std::thread::hardware_concurrency();
+    if (maxThreads <= 0) {
+        maxThreads = 1;
+    }
+
+    try {
+        bool all = std::strcmp(name, "all") == 0;
+
+        if (all || std::strcmp(name, "bfs") == 0) {
+            benchParallelBfs(numVertices, maxThreads);
+        }
+        if (all || std::strcmp(name, "queues") == 0) {
+            benchQueuePolicies(numVertices);
+        }
+        if (all || std::strcmp(name, "sssp") == 0) {
+            benchDeltaStepping(numVertices, maxThreads);
+        }
+        if (all || std::strcmp(name, "load") == 0) {
+            benchLoading(numVertices);
+        }
+        if (all || std::strcmp(name, "tree") == 0) {
+            benchSearchTree(numVertices);
+        }
+        if (all || std::strcmp(name, "table") == 0) {
+            benchDistanceTable(numVertices, maxThreads);
+        }
+        if (all || std::strcmp(name, "bounded") == 0) {
+            benchBoundedQueries(numVertices);
+        }
+        if (all || std::strcmp(name, "conn") == 0) {
+            benchConnectivity(numVertices);
+        }
+        if (all || std::strcmp(name, "dynamic") == 0) {
+            benchDynamicPaths(numVertices);
+        }
+        if (all || std::strcmp(name, "forest") == 0) {
+            benchSpanningForest(numVertices);
+        }
+        if (all || std::strcmp(name, "order") == 0) {
+            benchVertexOrdering(numVertices);
+        }
+        if (all || std::strcmp(name, "compressed") == 0) {
+            benchCompression(numVertices);
+        }
+        if (all || std::strcmp(name, "dense") == 0) {
+            benchDenseGraph(numVertices);
+        }
+        if (all || std::strcmp(name, "churn") == 0) {
+            benchEdgeChurn(numVertices);
+        }
+        if (all || std::strcmp(name, "file") == 0) {
+            benchGraphFile(numVertices);
+        }
+        if (all || std::strcmp(name, "parse") == 0) {
+            benchParsing(numVertices, maxThreads);
+        }
+        if (all || std::strcmp(name, "mst") == 0) {
+            benchSpanningTree(numVertices, maxThreads);
+        }
+        if (all || std::strcmp(name, "ch") == 0) {
+            benchContractionHierarchy(numVertices);
+        }
+    } catch (const char* msg) {
+        std::cout << "An exception occurred: " << msg << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -4,7 +4,25 @@
 #include "Graph.hpp"
 #include "Algorithms.hpp"
 #include "Utils.hpp"
+#include "CSRGraph.hpp"
+#include "Path.hpp"
+#include "ContractionHierarchy.hpp"
+#include "GraphFile.hpp"
+#include "GraphReader.hpp"
+#include "ConnectivityIndex.hpp"
+#include "DynamicShortestPaths.hpp"
+#include "MinimumSpanningForest.hpp"
+#include "VertexOrdering.hpp"
+#include "CompressedGraph.hpp"
+#include "DenseGraph.hpp"
+#include "Parallel.hpp"
 #include <iostream>
+#include <utility>
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <stdexcept>
+#include <unistd.h>
 
 // Helper function to count edges in a graph
 int countEdges(const graph::Graph& g) {
@@ -114,6 +132,130 @@ bool isGraphConnected(const graph::Graph& g) {
     return allVisited;
 }
 
+// Helper function to check that two graphs contain exactly the same weighted edges
+bool sameEdges(const graph::Graph& a, const graph::Graph& b) {
+    if (a.getNumVertices() != b.getNumVertices() || countEdges(a) != countEdges(b)) {
+        return false;
+    }
+    
+    for (int i = 0; i < a.getNumVertices(); i++) {
+        graph::Graph::Edge* edge = a.getAdjList(i);
+        while (edge) {
+            if (getEdgeWeight(b, i, edge->destination) != edge->weight) {
+                return false;
+            }
+            edge = edge->next;
+        }
+    }
+    return true;
+}
+
+// Simple linear congruential generator so the random test graphs are reproducible
+int nextRandom(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return (int)((state >> 8) & 0x7fffff);
+}
+
+// Helper function to build a random graph with the given number of edges
+graph::Graph randomGraph(int numVertices, int numEdges, int maxWeight, unsigned int seed) {
+    graph::Graph g(numVertices);
+    for (int i = 0; i < numEdges; i++) {
+        int u = nextRandom(seed) % numVertices;
+        int v = nextRandom(seed) % numVertices;
+        if (u != v) {
+            g.addEdge(u, v, 1 + nextRandom(seed) % maxWeight);
+        }
+    }
+    return g;
+}
+
+// Helper function to build a scale-free graph: each new vertex links to the
+// endpoints of randomly chosen earlier edges (preferential attachment)
+graph::Graph scaleFreeGraph(int numVertices, int edgesPerVertex, unsigned int seed) {
+    graph::Graph g(numVertices);
+    int* endpoints = new int[2 * numVertices * edgesPerVertex + 2];
+    int endpointCount = 0;
+    
+    g.addEdge(0, 1);
+    endpoints[endpointCount++] = 0;
+    endpoints[endpointCount++] = 1;
+    
+    for (int v = 2; v < numVertices; v++) {
+        for (int k = 0; k < edgesPerVertex; k++) {
+            int u = endpoints[nextRandom(seed) % endpointCount];
+            g.addEdge(v, u);
+            endpoints[endpointCount++] = v;
+            endpoints[endpointCount++] = u;
+        }
+    }
+    
+    delete[] endpoints;
+    return g;
+}
+
+// Helper function to compute the hop depth of every vertex in a tree (-1 if not in the tree)
+void treeDepths(const graph::Graph& tree, int source, int* depth) {
+    int numVertices = tree.getNumVertices();
+    for (int i = 0; i < numVertices; i++) {
+        depth[i] = -1;
+    }
+    
+    graph::Queue queue;
+    depth[source] = 0;
+    queue.enqueue(source);
+    
+    while (!queue.isEmpty()) {
+        int current = queue.dequeue();
+        for (graph::Graph::Edge* edge = tree.getAdjList(current); edge; edge = edge->next) {
+            if (depth[edge->destination] == -1) {
+                depth[edge->destination] = depth[current] + 1;
+                queue.enqueue(edge->destination);
+            }
+        }
+    }
+}
+
+// Helper function to compute the weighted distance of every vertex from source
+// along the edges of a tree (-1 if not in the tree)
+void treeDistances(const graph::Graph& tree, int source, int* distance) {
+    int numVertices = tree.getNumVertices();
+    for (int i = 0; i < numVertices; i++) {
+        distance[i] = -1;
+    }
+    
+    graph::Queue queue;
+    distance[source] = 0;
+    queue.enqueue(source);
+    
+    while (!queue.isEmpty()) {
+        int current = queue.dequeue();
+        for (graph::Graph::Edge* edge = tree.getAdjList(current); edge; edge = edge->next) {
+            if (distance[edge->destination] == -1) {
+                distance[edge->destination] = distance[current] + edge->weight;
+                queue.enqueue(edge->destination);
+            }
+        }
+    }
+}
+
+// Helper function to check that two trees give the same distances from source
+bool sameTreeDistances(const graph::Graph& a, const graph::Graph& b, int source) {
+    int numVertices = a.getNumVertices();
+    int* distA = new int[numVertices];
+    int* distB = new int[numVertices];
+    treeDistances(a, source, distA);
+    treeDistances(b, source, distB);
+    
+    bool same = true;
+    for (int i = 0; i < numVertices; i++) {
+        same = same && distA[i] == distB[i];
+    }
+    
+    delete[] distA;
+    delete[] distB;
+    return same;
+}
+
 TEST_CASE("Graph construction and basic operations") {
     graph::Graph g(5);
     
@@ -180,6 +322,120 @@ TEST_CASE("Graph construction and basic operations") {
     }
 }
 
+TEST_CASE("Edge node allocation") {
+    SUBCASE("Removed edge nodes are reused by addEdge") {
+        graph::Graph g(4);
+        g.addEdge(0, 1, 2);
+        graph::Graph::Edge* forward = g.getAdjList(0);
+        graph::Graph::Edge* reverse = g.getAdjList(1);
+        
+        g.removeEdge(0, 1);
+        g.addEdge(2, 3, 5);
+        
+        CHECK(eitherEdgeExists(g, 2, 3, 3, 2));
+        CHECK((g.getAdjList(2) == forward || g.getAdjList(2) == reverse));
+        CHECK((g.getAdjList(3) == forward || g.getAdjList(3) == reverse));
+        CHECK(g.getAdjList(2)->next == nullptr);
+        CHECK(getEdgeWeight(g, 3, 2) == 5);
+    }
+    
+    SUBCASE("Destroying a hub vertex with a million neighbors") {
+        graph::Graph* g = new graph::Graph(2);
+        for (int i = 0; i < 1000000; i++) {
+            g->addEdge(0, 1, i);
+        }
+        CHECK(countEdges(*g) == 1000000);
+        
+        graph::Graph copy(*g);
+        CHECK(countEdges(copy) == 1000000);
+        
+        delete g; // Must not recurse once per edge
+        copy = graph::Graph(3);
+        CHECK(copy.getAdjList(0) == nullptr);
+    }
+}
+
+TEST_CASE("Move semantics and in-place results") {
+    graph::Graph g(5);
+    g.addEdge(0, 1, 2);
+    g.addEdge(0, 2, 5);
+    g.addEdge(1, 3, 7);
+    g.addEdge(3, 4, 1);
+    
+    SUBCASE("Move constructor and move assignment") {
+        graph::Graph::Edge* head = g.getAdjList(0);
+        
+        graph::Graph moved(std::move(g));
+        CHECK(moved.getAdjList(0) == head); // The nodes are not copied
+        CHECK(g.getNumVertices() == 0);
+        CHECK(countEdges(moved) == 4);
+        
+        graph::Graph target(2);
+        target.addEdge(0, 1);
+        target = std::move(moved);
+        CHECK(target.getNumVertices() == 5);
+        CHECK(target.getAdjList(0) == head);
+        CHECK(moved.getNumVertices() == 0);
+        
+        // A moved-from graph can be assigned again
+        moved = target;
+        CHECK(sameEdges(moved, target));
+    }
+    
+    SUBCASE("Swap") {
+        graph::Graph other(2);
+        other.addEdge(0, 1, 9);
+        
+        g.swap(other);
+        CHECK(g.getNumVertices() == 2);
+        CHECK(getEdgeWeight(g, 1, 0) == 9);
+        CHECK(other.getNumVertices() == 5);
+        CHECK(countEdges(other) == 4);
+    }
+    
+    SUBCASE("Clear keeps the graph usable") {
+        g.clear();
+        CHECK(countEdges(g) == 0);
+        g.addEdge(2, 4, 3);
+        CHECK(getEdgeWeight(g, 4, 2) == 3);
+        CHECK(countEdges(g) == 1);
+    }
+    
+    SUBCASE("Algorithms write into a caller-provided graph") {
+        graph::Graph result(5);
+        
+        graph::Algorithms::bfs(g, 0, result);
+        CHECK(sameEdges(result, graph::Algorithms::bfs(g, 0)));
+        graph::Graph::Edge* firstNode = result.getAdjList(0);
+        
+        // Same vertex count: the storage of the previous result is reused
+        graph::Algorithms::dfs(g, 0, result);
+        CHECK(sameEdges(result, graph::Algorithms::dfs(g, 0)));
+        bool reused = false;
+        for (int i = 0; i < 5; i++) {
+            for (graph::Graph::Edge* edge = result.getAdjList(i); edge; edge = edge->next) {
+                reused = reused || edge == firstNode;
+            }
+        }
+        CHECK(reused);
+        
+        graph::Algorithms::dijkstra(g, 4, result);
+        CHECK(sameEdges(result, graph::Algorithms::dijkstra(g, 4)));
+        graph::Algorithms::prim(g, result);
+        CHECK(calculateTotalWeight(result) == 15);
+        
+        // A result of the wrong size is replaced
+        graph::Graph small(2);
+        graph::Algorithms::kruskal(g, small);
+        CHECK(small.getNumVertices() == 5);
+        CHECK(calculateTotalWeight(small) == 15);
+        
+        graph::CSRGraph csr(g);
+        graph::Algorithms::bfs(csr, 0, small);
+        CHECK(sameEdges(small, graph::Algorithms::bfs(g, 0)));
+    }
+}
+
 TEST_CASE("Data structures - Queue") {
     graph::Queue queue;
     
@@ -763,4 +1019,2592 @@ TEST_CASE("Complex graph scenarios") {
         // Known minimum weight for this standard graph
         CHECK(primWeight == 37);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("CSR graph representation") {
+    graph::Graph g(9);
+    g.addEdge(0, 1, 4);
+    g.addEdge(0, 7, 8);
+    g.addEdge(1, 2, 8);
+    g.addEdge(1, 7, 11);
+    g.addEdge(2, 3, 7);
+    g.addEdge(2, 5, 4);
+    g.addEdge(2, 8, 2);
+    g.addEdge(3, 4, 9);
+    g.addEdge(3, 5, 14);
+    g.addEdge(4, 5, 10);
+    g.addEdge(5, 6, 2);
+    g.addEdge(6, 7, 1);
+    g.addEdge(6, 8, 6);
+    g.addEdge(7, 8, 7);
+    
+    SUBCASE("Building from a Graph keeps every edge") {
+        graph::CSRGraph csr(g);
+        CHECK(csr.getNumVertices() == 9);
+        CHECK(csr.getNumEdges() == 14);
+        CHECK(csr.getDegree(2) == 4);
+        CHECK(csr.getDegree(4) == 2);
+        
+        // Neighbors keep the order of the adjacency list
+        graph::Graph::Edge* edge = g.getAdjList(2);
+        for (int i = 0; i < csr.getDegree(2); i++) {
+            CHECK(csr.getNeighbors(2)[i] == edge->destination);
+            CHECK(csr.getNeighborWeights(2)[i] == edge->weight);
+            edge = edge->next;
+        }
+        
+        CHECK(sameEdges(csr.toGraph(), g));
+        CHECK_THROWS_WITH(csr.getDegree(9), "Vertex index out of range");
+    }
+    
+    SUBCASE("Building from an edge list") {
+        graph::WeightedEdge edges[] = {
+            graph::WeightedEdge(0, 1, 3),
+            graph::WeightedEdge(1, 2, 1),
+            graph::WeightedEdge(0, 2, 5),
+            graph::WeightedEdge(3, 3, 2)
+        };
+        graph::CSRGraph csr(4, edges, 4);
+        CHECK(csr.getNumEdges() == 4);
+        CHECK(csr.getDegree(0) == 2);
+        CHECK(csr.getDegree(3) == 2); // A self-loop appears twice
+        CHECK(csr.getNeighbors(0)[0] == 1);
+        CHECK(csr.getNeighbors(0)[1] == 2);
+        CHECK(countEdges(csr.toGraph()) == 3);
+        
+        graph::WeightedEdge bad[] = { graph::WeightedEdge(0, 4, 1) };
+        CHECK_THROWS_WITH(graph::CSRGraph(4, bad, 1), "Vertex index out of range");
+        CHECK_THROWS_WITH(graph::CSRGraph(0, edges, 0), "Number of vertices must be positive");
+        CHECK_THROWS_WITH(graph::CSRGraph(4, edges, 1073741824), "Too many edges");
+    }
+    
+    SUBCASE("Copy constructor and assignment operator") {
+        graph::CSRGraph csr(g);
+        graph::CSRGraph copy(csr);
+        CHECK(sameEdges(copy.toGraph(), g));
+        
+        graph::WeightedEdge single[] = { graph::WeightedEdge(0, 1, 1) };
+        graph::CSRGraph other(2, single, 1);
+        other = csr;
+        CHECK(other.getNumVertices() == 9);
+        CHECK(sameEdges(other.toGraph(), g));
+    }
+    
+    SUBCASE("Algorithms give the same trees as on the adjacency list") {
+        graph::CSRGraph csr(g);
+        
+        CHECK(sameEdges(graph::Algorithms::bfs(csr, 0), graph::Algorithms::bfs(g, 0)));
+        CHECK(sameEdges(graph::Algorithms::dfs(csr, 3), graph::Algorithms::dfs(g, 3)));
+        CHECK(sameEdges(graph::Algorithms::dijkstra(csr, 0), graph::Algorithms::dijkstra(g, 0)));
+        
+        graph::Graph primMST = graph::Algorithms::prim(csr);
+        graph::Graph kruskalMST = graph::Algorithms::kruskal(csr);
+        CHECK(calculateTotalWeight(primMST) == 37);
+        CHECK(calculateTotalWeight(kruskalMST) == 37);
+        CHECK(countEdges(primMST) == 8);
+        CHECK(isGraphConnected(kruskalMST));
+        
+        CHECK_THROWS_WITH(graph::Algorithms::bfs(csr, 9), "Source vertex out of range");
+        CHECK_THROWS_WITH(graph::Algorithms::dijkstra(csr, -1), "Source vertex out of range");
+    }
+}
+
+TEST_CASE("Direction-optimizing BFS") {
+    SUBCASE("Same depths as BFS on a scale-free graph, with fewer edge checks") {
+        graph::Graph g = scaleFreeGraph(3000, 4, 7);
+        graph::CSRGraph csr(g);
+        
+        graph::BfsStats stats;
+        graph::Graph tree = graph::Algorithms::bfsDirectionOptimizing(csr, 0, graph::DirectionOptimizingOptions(), &stats);
+        graph::Graph reference = graph::Algorithms::bfs(g, 0);
+        
+        int* depth = new int[3000];
+        int* expected = new int[3000];
+        treeDepths(tree, 0, depth);
+        treeDepths(reference, 0, expected);
+        
+        bool sameDepths = true;
+        for (int i = 0; i < 3000; i++) {
+            sameDepths = sameDepths && depth[i] == expected[i];
+        }
+        CHECK(sameDepths);
+        CHECK(countEdges(tree) == countEdges(reference));
+        
+        CHECK(stats.bottomUpSteps > 0);
+        CHECK(stats.topDownSteps > 0);
+        CHECK(stats.edgesInspected < 2LL * csr.getNumEdges());
+        
+        delete[] depth;
+        delete[] expected;
+    }
+    
+    SUBCASE("Top-down only gives exactly the BFS tree") {
+        graph::Graph g = randomGraph(200, 600, 10, 11);
+        graph::DirectionOptimizingOptions neverSwitch(0, 24);
+        
+        graph::BfsStats stats;
+        graph::Graph tree = graph::Algorithms::bfsDirectionOptimizing(g, 5, neverSwitch, &stats);
+        CHECK(stats.bottomUpSteps == 0);
+        CHECK(sameEdges(tree, graph::Algorithms::bfs(g, 5)));
+    }
+    
+    SUBCASE("Disconnected graph and invalid input") {
+        graph::Graph g(6);
+        g.addEdge(0, 1);
+        g.addEdge(1, 2);
+        g.addEdge(4, 5);
+        
+        graph::Graph tree = graph::Algorithms::bfsDirectionOptimizing(g, 0, graph::DirectionOptimizingOptions(1, 1));
+        CHECK(countEdges(tree) == 2);
+        CHECK(edgeExists(tree, 0, 1));
+        CHECK(edgeExists(tree, 1, 2));
+        
+        CHECK_THROWS_WITH(graph::Algorithms::bfsDirectionOptimizing(g, 6), "Source vertex out of range");
+        CHECK_THROWS_WITH(graph::Algorithms::bfsDirectionOptimizing(g, 0, graph::DirectionOptimizingOptions(14, 0)),
+                          "Direction-optimizing thresholds must be positive");
+    }
+}
+
+TEST_CASE("Parallel BFS") {
+    graph::Graph g = scaleFreeGraph(5000, 3, 21);
+    graph::CSRGraph csr(g);
+    
+    int* expected = new int[5000];
+    int* depth = new int[5000];
+    treeDepths(graph::Algorithms::bfs(g, 17), 17, expected);
+    
+    SUBCASE("Every thread count gives a BFS tree of the same depths") {
+        int threadCounts[] = {1, 2, 4, 7};
+        for (int t = 0; t < 4; t++) {
+            graph::Graph tree = graph::Algorithms::bfsParallel(csr, 17, threadCounts[t]);
+            treeDepths(tree, 17, depth);
+            
+            bool sameDepths = true;
+            bool edgesFromGraph = true;
+            for (int i = 0; i < 5000; i++) {
+                sameDepths = sameDepths && depth[i] == expected[i];
+                for (graph::Graph::Edge* edge = tree.getAdjList(i); edge; edge = edge->next) {
+                    edgesFromGraph = edgesFromGraph && edgeExists(g, i, edge->destination);
+                }
+            }
+            CHECK(sameDepths);
+            CHECK(edgesFromGraph);
+            CHECK(countEdges(tree) == 4999);
+        }
+    }
+    
+    SUBCASE("Disconnected graph and invalid input") {
+        graph::Graph small(5);
+        small.addEdge(0, 1, 3);
+        small.addEdge(3, 4, 1);
+        
+        graph::Graph tree = graph::Algorithms::bfsParallel(small, 0, 3);
+        CHECK(countEdges(tree) == 1);
+        CHECK(getEdgeWeight(tree, 1, 0) == 3);
+        
+        CHECK_THROWS_WITH(graph::Algorithms::bfsParallel(small, 5, 2), "Source vertex out of range");
+        CHECK_THROWS_WITH(graph::Algorithms::bfsParallel(small, 0, 0), "Number of threads must be positive");
+    }
+    
+    SUBCASE("Exceptions from any thread reach the caller after every thread is done") {
+        std::atomic<int> finished(0);
+        CHECK_THROWS_WITH(graph::runInParallel(4, [&](int thread) {
+                              finished++;
+                              if (thread == 0) {
+                                  throw "Calling thread failed";
+                              }
+                          }),
+                          "Calling thread failed");
+        CHECK(finished == 4);
+        
+        finished = 0;
+        CHECK_THROWS_AS(graph::runInParallel(4, [&](int thread) {
+                            finished++;
+                            if (thread == 3) {
+                                throw std::runtime_error("Worker failed");
+                            }
+                        }),
+                        std::runtime_error);
+        CHECK(finished == 4);
+    }
+    
+    delete[] expected;
+    delete[] depth;
+}
+
+// Visitor that records every DFS event
+class RecordingVisitor : public graph::DfsVisitor {
+public:
+    int discovered;
+    int finished;
+    int treeEdges;
+    int backEdges;
+    int roots;
+    int depth;
+    int maxDepth;
+    
+    RecordingVisitor() : discovered(0), finished(0), treeEdges(0), backEdges(0), roots(0), depth(0), maxDepth(0) {}
+    
+    void discoverVertex(int) {
+        discovered++;
+        if (depth == 0) {
+            roots++;
+        }
+        depth++;
+        if (depth > maxDepth) {
+            maxDepth = depth;
+        }
+    }
+    
+    void finishVertex(int) {
+        finished++;
+        depth--;
+    }
+    
+    void treeEdge(int, int, int) {
+        treeEdges++;
+    }
+    
+    void backEdge(int, int, int) {
+        backEdges++;
+    }
+};
+
+TEST_CASE("Iterative DFS engine") {
+    SUBCASE("Events on a graph with cycles") {
+        graph::Graph g(7);
+        g.addEdge(0, 1);
+        g.addEdge(1, 2);
+        g.addEdge(2, 0); // Closes a cycle
+        g.addEdge(2, 3);
+        g.addEdge(4, 5);
+        g.addEdge(5, 6);
+        g.addEdge(6, 4); // A second cycle in another component
+        
+        RecordingVisitor visitor;
+        graph::Algorithms::depthFirstSearch(g, 0, visitor);
+        CHECK(visitor.discovered == 4);
+        CHECK(visitor.finished == 4);
+        CHECK(visitor.treeEdges == 3);
+        CHECK(visitor.backEdges == 1);
+        CHECK(visitor.depth == 0);
+        
+        RecordingVisitor all;
+        graph::Algorithms::depthFirstSearchAll(g, all);
+        CHECK(all.discovered == 7);
+        CHECK(all.roots == 2); // Two components
+        CHECK(all.treeEdges == 5);
+        CHECK(all.backEdges == 2);
+        
+        RecordingVisitor csrVisitor;
+        graph::Algorithms::depthFirstSearchAll(graph::CSRGraph(g), csrVisitor);
+        CHECK(csrVisitor.roots == 2);
+        CHECK(csrVisitor.backEdges == 2);
+        
+        CHECK_THROWS_WITH(graph::Algorithms::depthFirstSearch(g, 7, visitor), "Source vertex out of range");
+    }
+    
+    SUBCASE("A tree has no back edges, parallel edges form one") {
+        graph::Graph g(4);
+        g.addEdge(0, 1);
+        g.addEdge(1, 2);
+        g.addEdge(1, 3);
+        
+        RecordingVisitor visitor;
+        graph::Algorithms::depthFirstSearch(g, 2, visitor);
+        CHECK(visitor.backEdges == 0);
+        CHECK(visitor.treeEdges == 3);
+        
+        g.addEdge(0, 1);
+        RecordingVisitor withParallel;
+        graph::Algorithms::depthFirstSearch(g, 2, withParallel);
+        CHECK(withParallel.backEdges == 1);
+        
+        // A self-loop is one back edge on every representation, two self-loops are two
+        g.addEdge(1, 1, 1);
+        RecordingVisitor withLoop;
+        graph::Algorithms::depthFirstSearch(g, 2, withLoop);
+        CHECK(withLoop.backEdges == 2);
+        RecordingVisitor csrLoop;
+        graph::Algorithms::depthFirstSearch(graph::CSRGraph(g), 2, csrLoop);
+        CHECK(csrLoop.backEdges == 2);
+        RecordingVisitor compressedLoop;
+        graph::Algorithms::depthFirstSearch(graph::CompressedGraph(g), 2, compressedLoop);
+        CHECK(compressedLoop.backEdges == 2);
+        
+        g.addEdge(3, 3, 4);
+        g.addEdge(3, 3, 5);
+        RecordingVisitor withLoops;
+        graph::Algorithms::depthFirstSearchAll(g, withLoops);
+        CHECK(withLoops.backEdges == 4);
+        CHECK(withLoops.treeEdges == 3);
+    }
+    
+    SUBCASE("Path with 300000 vertices does not overflow the stack") {
+        int n = 300000;
+        graph::Graph g(n);
+        for (int i = 0; i + 1 < n; i++) {
+            g.addEdge(i, i + 1, 1);
+        }
+        
+        graph::Graph tree = graph::Algorithms::dfs(g, 0);
+        CHECK(countEdges(tree) == n - 1);
+        
+        RecordingVisitor visitor;
+        graph::Algorithms::depthFirstSearch(g, 0, visitor);
+        CHECK(visitor.maxDepth == n);
+        CHECK(visitor.finished == n);
+    }
+}
+
+// Pushes the same keys into a queue policy and checks they come out sorted
+template <typename Queue>
+bool popsInOrder() {
+    Queue queue(4);
+    int keys[] = {7, 3, 9, 3, 0, 12, 5, 7, 1, 200, 64};
+    for (int i = 0; i < 11; i++) {
+        queue.push(i, keys[i]);
+    }
+    
+    int previous = -1;
+    int count = 0;
+    while (!queue.isEmpty()) {
+        int vertex;
+        int key;
+        int top = queue.topKey();
+        queue.popMin(vertex, key);
+        if (key < previous || keys[vertex] != key || top != key) {
+            return false;
+        }
+        previous = key;
+        count++;
+    }
+    return count == 11;
+}
+
+TEST_CASE("Priority queue policies") {
+    SUBCASE("Every policy pops keys in ascending order") {
+        CHECK(popsInOrder<graph::BinaryHeapQueue>());
+        CHECK(popsInOrder<graph::DaryHeapQueue<4> >());
+        CHECK(popsInOrder<graph::DaryHeapQueue<8> >());
+        CHECK(popsInOrder<graph::BucketQueue>());
+    }
+    
+    SUBCASE("Bucket queue handles smaller keys after a pop and wide key ranges") {
+        graph::BucketQueue queue(2);
+        int vertex;
+        int key;
+        
+        queue.push(0, 10);
+        queue.push(1, 12);
+        queue.popMin(vertex, key);
+        CHECK(key == 10);
+        queue.push(2, 4); // Smaller than the last key, as in Prim
+        queue.push(3, 100000);
+        queue.popMin(vertex, key);
+        CHECK(vertex == 2);
+        queue.popMin(vertex, key);
+        CHECK(key == 12);
+        queue.popMin(vertex, key);
+        CHECK(key == 100000);
+        CHECK(queue.isEmpty());
+        
+        CHECK_THROWS_WITH(queue.push(0, -1), "Bucket queue keys must be non-negative");
+        CHECK_THROWS_WITH(queue.popMin(vertex, key), "Priority queue is empty");
+        CHECK_THROWS_WITH(queue.topKey(), "Priority queue is empty");
+    }
+    
+    SUBCASE("Dijkstra and Prim agree across policies") {
+        graph::Graph g = randomGraph(400, 1600, 20, 5);
+        graph::CSRGraph csr(g);
+        graph::Graph reference = graph::Algorithms::dijkstra(g, 3);
+        int mstWeight = calculateTotalWeight(graph::Algorithms::kruskal(g));
+        
+        CHECK(sameTreeDistances(graph::Algorithms::dijkstraWith<graph::DaryHeapQueue<4> >(g, 3), reference, 3));
+        CHECK(sameTreeDistances(graph::Algorithms::dijkstraWith<graph::DaryHeapQueue<8> >(csr, 3), reference, 3));
+        CHECK(sameTreeDistances(graph::Algorithms::dijkstraWith<graph::BucketQueue>(g, 3), reference, 3));
+        CHECK(sameTreeDistances(graph::Algorithms::dijkstraWith<graph::BucketQueue>(csr, 3), reference, 3));
+        
+        CHECK(calculateTotalWeight(graph::Algorithms::prim(g)) == mstWeight);
+        CHECK(calculateTotalWeight(graph::Algorithms::primWith<graph::DaryHeapQueue<4> >(csr)) == mstWeight);
+        CHECK(calculateTotalWeight(graph::Algorithms::primWith<graph::BucketQueue>(g)) == mstWeight);
+    }
+    
+    SUBCASE("Prim returns a spanning forest for a disconnected graph") {
+        graph::Graph g(6);
+        g.addEdge(0, 1, 4);
+        g.addEdge(1, 2, 1);
+        g.addEdge(0, 2, 2);
+        g.addEdge(3, 4, 7);
+        g.addEdge(4, 5, 3);
+        g.addEdge(3, 5, 5);
+        
+        graph::Graph forest = graph::Algorithms::primWith<graph::BucketQueue>(g);
+        CHECK(countEdges(forest) == 4);
+        CHECK(calculateTotalWeight(forest) == 11);
+        CHECK(calculateTotalWeight(graph::Algorithms::prim(g)) == 11);
+    }
+}
+
+TEST_CASE("Parallel delta-stepping") {
+    graph::Graph g = randomGraph(2000, 8000, 50, 33);
+    graph::CSRGraph csr(g);
+    
+    int* expected = new int[2000];
+    int* distance = new int[2000];
+    int* parent = new int[2000];
+    treeDistances(graph::Algorithms::dijkstra(g, 0), 0, expected);
+    
+    SUBCASE("Distances match Dijkstra for several deltas and thread counts") {
+        int deltas[] = {1, 7, 50, 1000};
+        int threadCounts[] = {1, 3, 4, 2};
+        for (int k = 0; k < 4; k++) {
+            graph::Algorithms::deltaStepping(csr, 0, deltas[k], threadCounts[k], distance, parent);
+            
+            bool sameDistances = true;
+            bool validParents = true;
+            for (int v = 0; v < 2000; v++) {
+                int want = expected[v] == -1 ? 2147483647 : expected[v];
+                sameDistances = sameDistances && distance[v] == want;
+                if (v != 0 && parent[v] != -1) {
+                    // Some edge between parent and child must be tight (there may be parallel edges)
+                    bool tight = false;
+                    for (graph::Graph::Edge* edge = g.getAdjList(v); edge; edge = edge->next) {
+                        tight = tight || (edge->destination == parent[v] &&
+                                          distance[parent[v]] + edge->weight == distance[v]);
+                    }
+                    validParents = validParents && tight;
+                }
+            }
+            CHECK(sameDistances);
+            CHECK(validParents);
+            CHECK(parent[0] == -1);
+        }
+    }
+    
+    SUBCASE("Zero weights and unreachable vertices") {
+        graph::Graph z(6);
+        z.addEdge(0, 1, 0);
+        z.addEdge(1, 2, 0);
+        z.addEdge(2, 0, 0);
+        z.addEdge(2, 3, 5);
+        z.addEdge(1, 3, 6);
+        
+        graph::CSRGraph zcsr(z);
+        graph::Algorithms::deltaStepping(zcsr, 0, 2, 2, distance, parent);
+        CHECK(distance[1] == 0);
+        CHECK(distance[2] == 0);
+        CHECK(distance[3] == 5);
+        CHECK(parent[3] == 2);
+        CHECK(parent[1] == 0);
+        CHECK(parent[2] == 0);
+        CHECK(distance[4] == 2147483647);
+        CHECK(parent[5] == -1);
+    }
+    
+    SUBCASE("Invalid input") {
+        CHECK_THROWS_WITH(graph::Algorithms::deltaStepping(csr, 2000, 5, 1, distance, parent), "Source vertex out of range");
+        CHECK_THROWS_WITH(graph::Algorithms::deltaStepping(csr, 0, 0, 1, distance, parent), "Delta must be positive");
+        CHECK_THROWS_WITH(graph::Algorithms::deltaStepping(csr, 0, 5, 0, distance, parent), "Number of threads must be positive");
+        
+        graph::Graph negative(2);
+        negative.addEdge(0, 1, -3);
+        CHECK_THROWS_WITH(graph::Algorithms::deltaStepping(graph::CSRGraph(negative), 0, 5, 1, distance, parent),
+                          "Delta-stepping needs non-negative weights");
+    }
+    
+    delete[] expected;
+    delete[] distance;
+    delete[] parent;
+}
+
+// Helper function to build a width x height grid with weights between 1 and maxWeight
+graph::Graph gridGraph(int width, int height, int maxWeight, unsigned int seed) {
+    graph::Graph g(width * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int v = y * width + x;
+            if (x + 1 < width) {
+                g.addEdge(v, v + 1, 1 + nextRandom(seed) % maxWeight);
+            }
+            if (y + 1 < height) {
+                g.addEdge(v, v + width, 1 + nextRandom(seed) % maxWeight);
+            }
+        }
+    }
+    return g;
+}
+
+// Manhattan distance to the target - admissible on a grid whose weights are at least 1
+class GridHeuristic : public graph::Heuristic {
+public:
+    GridHeuristic(int gridWidth, int targetVertex) : width(gridWidth), target(targetVertex) {}
+    
+    int estimate(int vertex) const {
+        int dx = vertex % width - target % width;
+        int dy = vertex / width - target / width;
+        return (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+    }
+    
+private:
+    int width;
+    int target;
+};
+
+// Helper function to check that a path follows graph edges and has the given cost
+bool validPath(const graph::Graph& g, const graph::Path& path, int source, int target) {
+    if (path.getVertex(0) != source || path.getVertex(path.getLength() - 1) != target) {
+        return false;
+    }
+    int cost = 0;
+    for (int i = 0; i + 1 < path.getLength(); i++) {
+        int weight = getEdgeWeight(g, path.getVertex(i), path.getVertex(i + 1));
+        if (weight < 0) {
+            return false;
+        }
+        cost += weight;
+    }
+    return cost == path.getCost();
+}
+
+TEST_CASE("Point-to-point shortest path queries") {
+    graph::Graph g = gridGraph(60, 60, 9, 99);
+    int* distance = new int[3600];
+    treeDistances(graph::Algorithms::dijkstra(g, 61), 61, distance);
+    
+    SUBCASE("Bidirectional Dijkstra and A* find the Dijkstra distance") {
+        int targets[] = {61, 62, 700, 1834, 3599, 3000};
+        for (int k = 0; k < 6; k++) {
+            int t = targets[k];
+            graph::Path bidirectional = graph::Algorithms::bidirectionalDijkstra(g, 61, t);
+            graph::Path astar = graph::Algorithms::aStar(g, 61, t, GridHeuristic(60, t));
+            
+            CHECK(bidirectional.exists());
+            CHECK(astar.exists());
+            CHECK(bidirectional.getCost() == distance[t]);
+            CHECK(astar.getCost() == distance[t]);
+            CHECK(validPath(g, bidirectional, 61, t));
+            CHECK(validPath(g, astar, 61, t));
+        }
+    }
+    
+    SUBCASE("Nearby targets settle only a small part of the graph") {
+        int settledBidirectional = 0;
+        int settledAStar = 0;
+        graph::Algorithms::bidirectionalDijkstra(g, 61, 125, &settledBidirectional);
+        graph::Algorithms::aStar(g, 61, 125, GridHeuristic(60, 125), &settledAStar);
+        CHECK(settledBidirectional > 0);
+        CHECK(settledBidirectional < 500);
+        CHECK(settledAStar < 500);
+    }
+    
+    SUBCASE("Reused contexts give the same paths and keep the labels of the search") {
+        graph::QueryContext forward;
+        graph::QueryContext backward;
+        int targets[] = {125, 3599, 62, 61, 1834};
+        for (int k = 0; k < 5; k++) {
+            int t = targets[k];
+            int settled = 0;
+            graph::Path bidirectional = graph::Algorithms::bidirectionalDijkstra(g, 61, t, forward, backward);
+            graph::Path astar = graph::Algorithms::aStar(g, 61, t, GridHeuristic(60, t), forward, &settled);
+            CHECK(bidirectional.getCost() == distance[t]);
+            CHECK(validPath(g, bidirectional, 61, t));
+            CHECK(astar.getCost() == distance[t]);
+            CHECK(forward.getSource() == 61);
+            CHECK(forward.getDistance(t) == distance[t]);
+            CHECK(forward.pathTo(t).getCost() == distance[t]);
+            CHECK(forward.getReachedCount() >= settled);
+        }
+        
+        // A nearby target after a far one touches only a few vertices
+        graph::Algorithms::bidirectionalDijkstra(g, 61, 3599, forward, backward);
+        graph::Algorithms::bidirectionalDijkstra(g, 61, 63, forward, backward);
+        CHECK(forward.getReachedCount() + backward.getReachedCount() < 100);
+        CHECK_FALSE(forward.isReached(3599));
+        CHECK(backward.getSource() == 63);
+        CHECK_THROWS_WITH(graph::Algorithms::bidirectionalDijkstra(g, 61, 63, forward, forward),
+                          "Bidirectional search needs two contexts");
+    }
+    
+    SUBCASE("Unreachable target, trivial query and invalid input") {
+        graph::Graph split(4);
+        split.addEdge(0, 1, 2);
+        split.addEdge(2, 3, 2);
+        
+        CHECK_FALSE(graph::Algorithms::bidirectionalDijkstra(split, 0, 3).exists());
+        CHECK_FALSE(graph::Algorithms::aStar(split, 0, 3, GridHeuristic(1, 3)).exists());
+        CHECK_THROWS_WITH(graph::Algorithms::bidirectionalDijkstra(split, 0, 3).getCost(), "Path does not exist");
+        
+        graph::Path self = graph::Algorithms::bidirectionalDijkstra(split, 2, 2);
+        CHECK(self.getLength() == 1);
+        CHECK(self.getCost() == 0);
+        
+        CHECK_THROWS_WITH(graph::Algorithms::bidirectionalDijkstra(split, 0, 4), "Target vertex out of range");
+        CHECK_THROWS_WITH(graph::Algorithms::aStar(split, -1, 0, GridHeuristic(1, 0)), "Source vertex out of range");
+    }
+    
+    delete[] distance;
+}
+
+TEST_CASE("Contraction hierarchies") {
+    SUBCASE("Distances match Dijkstra on random graphs") {
+        graph::Graph g = randomGraph(400, 1200, 50, 21);
+        graph::ContractionHierarchy ch(g);
+        CHECK(ch.getNumVertices() == 400);
+        
+        int* distance = new int[400];
+        int sources[] = {0, 17, 256, 399};
+        for (int k = 0; k < 4; k++) {
+            treeDistances(graph::Algorithms::dijkstra(g, sources[k]), sources[k], distance);
+            for (int t = 0; t < 400; t++) {
+                int expected = distance[t] == -1 ? INT_MAX : distance[t];
+                CHECK(ch.distance(sources[k], t) == expected);
+            }
+        }
+        delete[] distance;
+    }
+    
+    SUBCASE("Unpacked paths follow the original edges") {
+        graph::Graph g = gridGraph(30, 30, 9, 5);
+        graph::ContractionHierarchy ch(g);
+        CHECK(ch.getNumShortcuts() > 0);
+        
+        int* distance = new int[900];
+        treeDistances(graph::Algorithms::dijkstra(g, 31), 31, distance);
+        int targets[] = {31, 32, 450, 899, 870};
+        for (int k = 0; k < 5; k++) {
+            graph::Path path = ch.shortestPath(31, targets[k]);
+            CHECK(path.exists());
+            CHECK(path.getCost() == distance[targets[k]]);
+            CHECK(validPath(g, path, 31, targets[k]));
+        }
+        delete[] distance;
+    }
+    
+    SUBCASE("Save and load") {
+        graph::Graph g = gridGraph(20, 20, 5, 8);
+        graph::ContractionHierarchy ch(g);
+        ch.save("ch_test.bin");
+        graph::ContractionHierarchy loaded = graph::ContractionHierarchy::load("ch_test.bin");
+        std::remove("ch_test.bin");
+        
+        CHECK(loaded.getNumVertices() == ch.getNumVertices());
+        CHECK(loaded.getNumArcs() == ch.getNumArcs());
+        CHECK(loaded.getNumShortcuts() == ch.getNumShortcuts());
+        for (int v = 0; v < 400; v += 7) {
+            CHECK(loaded.getRank(v) == ch.getRank(v));
+            CHECK(loaded.distance(0, v) == ch.distance(0, v));
+            CHECK(loaded.distance(v, 399) == ch.distance(v, 399));
+        }
+        
+        // A file that is not a hierarchy is rejected
+        FILE* file = std::fopen("ch_test.bin", "wb");
+        std::fputs("not a hierarchy", file);
+        std::fclose(file);
+        CHECK_THROWS_WITH(graph::ContractionHierarchy::load("ch_test.bin"), "Invalid contraction hierarchy file");
+        
+        // Version 1, 3 vertices ranked in index order, one upward arc 1 -> 2 of weight 5.
+        // As a shortcut through 0 it cannot be unpacked, since 0 has no arcs.
+        int hierarchy[] = { 1, 3, 1, 1,  0, 1, 2,  0, 0, 1, 1,  2,  5,  0 };
+        file = std::fopen("ch_test.bin", "wb");
+        std::fwrite("GCHF", 1, 4, file);
+        std::fwrite(hierarchy, sizeof(int), 14, file);
+        std::fclose(file);
+        CHECK_THROWS_WITH(graph::ContractionHierarchy::load("ch_test.bin"), "Invalid contraction hierarchy file");
+        
+        // The same arc as an original edge loads
+        hierarchy[13] = -1;
+        hierarchy[3] = 0;
+        file = std::fopen("ch_test.bin", "wb");
+        std::fwrite("GCHF", 1, 4, file);
+        std::fwrite(hierarchy, sizeof(int), 14, file);
+        std::fclose(file);
+        graph::ContractionHierarchy small = graph::ContractionHierarchy::load("ch_test.bin");
+        CHECK(small.shortestPath(1, 2).getCost() == 5);
+        
+        // A header declaring more data than the file holds is rejected before allocating
+        hierarchy[1] = 1000000000;
+        file = std::fopen("ch_test.bin", "wb");
+        std::fwrite("GCHF", 1, 4, file);
+        std::fwrite(hierarchy, sizeof(int), 14, file);
+        std::fclose(file);
+        CHECK_THROWS_WITH(graph::ContractionHierarchy::load("ch_test.bin"), "Invalid contraction hierarchy file");
+        
+        std::remove("ch_test.bin");
+        CHECK_THROWS_WITH(graph::ContractionHierarchy::load("ch_test.bin"), "Cannot open file for reading");
+    }
+    
+    SUBCASE("Unreachable targets and invalid input") {
+        graph::Graph g(5);
+        g.addEdge(0, 1, 3);
+        g.addEdge(1, 2, 4);
+        g.addEdge(3, 4, 1);
+        graph::ContractionHierarchy ch(g);
+        
+        CHECK(ch.distance(0, 2) == 7);
+        CHECK(ch.distance(2, 2) == 0);
+        CHECK(ch.distance(0, 4) == INT_MAX);
+        CHECK_FALSE(ch.shortestPath(0, 4).exists());
+        CHECK(ch.shortestPath(4, 4).getLength() == 1);
+        CHECK_THROWS_WITH(ch.distance(0, 5), "Target vertex out of range");
+        CHECK_THROWS_WITH(ch.getRank(-1), "Vertex index out of range");
+        
+        graph::Graph negative(2);
+        negative.addEdge(0, 1, -1);
+        CHECK_THROWS_WITH(graph::ContractionHierarchy ch2(negative), "Contraction hierarchies need non-negative weights");
+    }
+}
+
+TEST_CASE("Radix-sorted Kruskal") {
+    SUBCASE("Edge sort is ordered and stable") {
+        const int count = 100000;
+        graph::WeightedEdge* edges = new graph::WeightedEdge[count];
+        unsigned int seed = 17;
+        for (int i = 0; i < count; i++) {
+            // The source field records the original position
+            int weight = nextRandom(seed) % 2000 - 1000;
+            if (i % 1000 == 0) {
+                weight = i % 2000 == 0 ? INT_MAX : -INT_MAX - 1;
+            }
+            edges[i] = graph::WeightedEdge(i, 0, weight);
+        }
+        
+        int threadCounts[] = {1, 4};
+        for (int k = 0; k < 2; k++) {
+            graph::WeightedEdge* sorted = new graph::WeightedEdge[count];
+            for (int i = 0; i < count; i++) {
+                sorted[i] = edges[i];
+            }
+            graph::Algorithms::sortEdgesByWeight(sorted, count, threadCounts[k]);
+            
+            bool ordered = true;
+            for (int i = 0; i + 1 < count; i++) {
+                if (sorted[i].weight > sorted[i + 1].weight ||
+                    (sorted[i].weight == sorted[i + 1].weight && sorted[i].source > sorted[i + 1].source)) {
+                    ordered = false;
+                }
+            }
+            CHECK(ordered);
+            CHECK(sorted[0].weight == -INT_MAX - 1);
+            CHECK(sorted[count - 1].weight == INT_MAX);
+            delete[] sorted;
+        }
+        
+        CHECK_THROWS_WITH(graph::Algorithms::sortEdgesByWeight(edges, count, 0), "Number of threads must be positive");
+        delete[] edges;
+    }
+    
+    SUBCASE("Large sparse graphs match Prim") {
+        graph::Graph g = randomGraph(20000, 60000, 1000, 3);
+        graph::Graph kruskalTree = graph::Algorithms::kruskal(g);
+        graph::Graph primTree = graph::Algorithms::prim(g);
+        
+        CHECK(countEdges(kruskalTree) == countEdges(primTree));
+        CHECK(calculateTotalWeight(kruskalTree) == calculateTotalWeight(primTree));
+        
+        // Splitting the sort across threads gives exactly the same tree
+        graph::CSRGraph csr(g);
+        graph::Graph parallelTree(1);
+        graph::Algorithms::kruskal(csr, parallelTree, 4);
+        CHECK(sameEdges(parallelTree, kruskalTree));
+    }
+    
+    SUBCASE("Negative weights") {
+        graph::Graph g(4);
+        g.addEdge(0, 1, -5);
+        g.addEdge(1, 2, 3);
+        g.addEdge(2, 3, -2);
+        g.addEdge(0, 3, 1);
+        g.addEdge(0, 2, 2);
+        
+        graph::Graph mst = graph::Algorithms::kruskal(g);
+        CHECK(countEdges(mst) == 3);
+        CHECK(calculateTotalWeight(mst) == -6);
+    }
+}
+
+// Helper function to count the connected components of a graph
+int countComponents(const graph::Graph& g) {
+    int numVertices = g.getNumVertices();
+    graph::UnionFind uf(numVertices);
+    int components = numVertices;
+    for (int i = 0; i < numVertices; i++) {
+        for (graph::Graph::Edge* edge = g.getAdjList(i); edge; edge = edge->next) {
+            if (!uf.connected(i, edge->destination)) {
+                uf.unite(i, edge->destination);
+                components--;
+            }
+        }
+    }
+    return components;
+}
+
+TEST_CASE("Parallel Boruvka and Filter-Kruskal") {
+    SUBCASE("Same forest weight as Kruskal") {
+        // Sparse random graphs are disconnected; the largest one is split across threads
+        graph::Graph graphs[] = { randomGraph(30000, 60000, 1000, 41), randomGraph(30000, 30000, 50, 42),
+                                  randomGraph(500, 3000, 3, 43), randomGraph(70000, 140000, 100000, 45) };
+        for (int k = 0; k < 4; k++) {
+            graph::Graph& g = graphs[k];
+            graph::Graph expected = graph::Algorithms::kruskal(g);
+            int forestEdges = g.getNumVertices() - countComponents(g);
+            CHECK(countEdges(expected) == forestEdges);
+            
+            int threadCounts[] = {1, 4};
+            for (int t = 0; t < 2; t++) {
+                graph::Graph boruvka = graph::Algorithms::boruvka(g, threadCounts[t]);
+                graph::Graph filter = graph::Algorithms::filterKruskal(g, threadCounts[t]);
+                
+                CHECK(countEdges(boruvka) == forestEdges);
+                CHECK(countEdges(filter) == forestEdges);
+                CHECK(calculateTotalWeight(boruvka) == calculateTotalWeight(expected));
+                CHECK(calculateTotalWeight(filter) == calculateTotalWeight(expected));
+                CHECK(countComponents(boruvka) == countComponents(g));
+                CHECK(countComponents(filter) == countComponents(g));
+            }
+            
+            // The forest does not depend on the number of threads
+            CHECK(sameEdges(graph::Algorithms::boruvka(g, 1), graph::Algorithms::boruvka(g, 3)));
+        }
+    }
+    
+    SUBCASE("Equal and negative weights, self-loops") {
+        graph::Graph g(5);
+        g.addEdge(0, 0, -9);
+        g.addEdge(0, 1, -2);
+        g.addEdge(1, 2, -2);
+        g.addEdge(2, 0, -2);
+        g.addEdge(3, 4, 7);
+        g.addEdge(3, 4, 5);
+        
+        graph::Graph boruvka = graph::Algorithms::boruvka(g, 2);
+        graph::Graph filter = graph::Algorithms::filterKruskal(g);
+        CHECK(countEdges(boruvka) == 3);
+        CHECK(countEdges(filter) == 3);
+        CHECK(calculateTotalWeight(boruvka) == 1);
+        CHECK(calculateTotalWeight(filter) == 1);
+        CHECK_FALSE(edgeExists(boruvka, 0, 0));
+        
+        // A graph without edges gives an empty forest
+        graph::Graph empty(3);
+        CHECK(countEdges(graph::Algorithms::boruvka(empty, 2)) == 0);
+        CHECK(countEdges(graph::Algorithms::filterKruskal(empty, 2)) == 0);
+    }
+    
+    SUBCASE("In-place results and invalid thread counts") {
+        graph::CSRGraph csr(randomGraph(200, 600, 20, 44));
+        graph::Graph result(7);
+        graph::Algorithms::filterKruskal(csr, 2, result);
+        CHECK(result.getNumVertices() == 200);
+        graph::Algorithms::boruvka(csr, 2, result);
+        CHECK(calculateTotalWeight(result) == calculateTotalWeight(graph::Algorithms::kruskal(csr)));
+        
+        CHECK_THROWS_WITH(graph::Algorithms::boruvka(csr, 0), "Number of threads must be positive");
+        CHECK_THROWS_WITH(graph::Algorithms::filterKruskal(csr, -1), "Number of threads must be positive");
+    }
+}
+
+TEST_CASE("Bulk edge loading") {
+    graph::WeightedEdge edges[] = {
+        graph::WeightedEdge(0, 1, 4), graph::WeightedEdge(0, 2, 3), graph::WeightedEdge(1, 2, 1),
+        graph::WeightedEdge(2, 3, 2), graph::WeightedEdge(3, 3, 5), graph::WeightedEdge(0, 3, 7)
+    };
+    
+    SUBCASE("Same edges as addEdge, neighbors in input order and contiguous") {
+        graph::Graph bulk(4, edges, 6);
+        graph::Graph single(4);
+        for (int i = 0; i < 6; i++) {
+            single.addEdge(edges[i].source, edges[i].dest, edges[i].weight);
+        }
+        CHECK(sameEdges(bulk, single));
+        CHECK(sameEdges(single, bulk));
+        
+        int expected[] = {1, 2, 3};
+        int k = 0;
+        for (graph::Graph::Edge* edge = bulk.getAdjList(0); edge; edge = edge->next, k++) {
+            CHECK(edge->destination == expected[k]);
+            if (edge->next) {
+                CHECK(edge->next == edge + 1);
+            }
+        }
+        CHECK(k == 3);
+        
+        // The self-loop is stored twice, like addEdge does
+        int loops = 0;
+        for (graph::Graph::Edge* edge = bulk.getAdjList(3); edge; edge = edge->next) {
+            loops += edge->destination == 3;
+        }
+        CHECK(loops == 2);
+    }
+    
+    SUBCASE("Adding to an existing graph") {
+        graph::Graph g(4);
+        g.addEdge(1, 3, 9);
+        g.addEdges(edges, 3);
+        
+        CHECK(countEdges(g) == 4);
+        CHECK(g.getAdjList(1)->destination == 0);
+        CHECK(getEdgeWeight(g, 1, 3) == 9);
+        
+        // Bulk-loaded nodes behave like any others afterwards
+        g.removeEdge(0, 1);
+        g.addEdge(2, 3, 6);
+        CHECK_FALSE(edgeExists(g, 0, 1));
+        CHECK(countEdges(g) == 4);
+        CHECK(calculateTotalWeight(graph::Algorithms::kruskal(g)) == 3 + 1 + 6);
+        
+        g.clear();
+        g.addEdges(edges, 6);
+        CHECK(countEdges(g) == 5); // countEdges skips the self-loop
+    }
+    
+    SUBCASE("Invalid input leaves the graph unchanged") {
+        graph::Graph g(4);
+        g.addEdge(0, 1, 2);
+        graph::WeightedEdge bad[] = { graph::WeightedEdge(0, 2, 1), graph::WeightedEdge(1, 4, 1) };
+        
+        CHECK_THROWS_WITH(g.addEdges(bad, 2), "Vertex index out of range");
+        CHECK_THROWS_WITH(g.addEdges(bad, -1), "Edge count must not be negative");
+        CHECK(countEdges(g) == 1);
+        CHECK_THROWS_WITH(graph::Graph(4, bad, 2), "Vertex index out of range");
+        
+        g.addEdges(bad, 0);
+        CHECK(countEdges(g) == 1);
+    }
+    
+    SUBCASE("Large edge list") {
+        const int count = 200000;
+        graph::WeightedEdge* many = new graph::WeightedEdge[count];
+        unsigned int seed = 5;
+        for (int i = 0; i < count; i++) {
+            many[i] = graph::WeightedEdge(nextRandom(seed) % 50000, nextRandom(seed) % 50000, 1 + nextRandom(seed) % 100);
+        }
+        graph::Graph g(50000, many, count);
+        graph::CSRGraph csr(50000, many, count);
+        delete[] many;
+        
+        CHECK(countEdges(g) == countEdges(csr.toGraph()));
+        CHECK(sameTreeDistances(graph::Algorithms::dijkstra(g, 0), graph::Algorithms::dijkstra(csr, 0), 0));
+    }
+}
+
+// Helper function to overwrite bytes of a file
+void patchFile(const char* filename, long position, const void* bytes, int count) {
+    FILE* file = std::fopen(filename, "r+b");
+    std::fseek(file, position, SEEK_SET);
+    std::fwrite(bytes, 1, count, file);
+    std::fclose(file);
+}
+
+TEST_CASE("Memory-mapped graph files") {
+    graph::Graph g = randomGraph(1000, 4000, 100, 61);
+    graph::CSRGraph csr(g);
+    graph::GraphFile::write("graph_test.bin", g);
+    
+    SUBCASE("The mapped arrays match the graph") {
+        graph::MappedGraph mapped("graph_test.bin", true);
+        const graph::CSRGraph& view = mapped.getGraph();
+        
+        CHECK_FALSE(view.ownsArrays());
+        CHECK(mapped.getNumVertices() == 1000);
+        CHECK(view.getNumHalfEdges() == csr.getNumHalfEdges());
+        bool same = true;
+        for (int v = 0; v <= 1000; v++) {
+            same = same && view.getOffsets()[v] == csr.getOffsets()[v];
+        }
+        for (int i = 0; i < csr.getNumHalfEdges(); i++) {
+            same = same && view.getDestinations()[i] == csr.getDestinations()[i];
+            same = same && view.getWeights()[i] == csr.getWeights()[i];
+        }
+        CHECK(same);
+        CHECK(mapped.getFileSize() >= 64 + 4 * (1001 + 2 * csr.getNumHalfEdges()));
+        
+        // Algorithms run straight on the mapped pages
+        CHECK(sameTreeDistances(graph::Algorithms::dijkstra(view, 0), graph::Algorithms::dijkstra(g, 0), 0));
+        CHECK(calculateTotalWeight(graph::Algorithms::kruskal(view)) == calculateTotalWeight(graph::Algorithms::kruskal(g)));
+        
+        // A copy owns its arrays and outlives the mapping
+        graph::CSRGraph copy(view);
+        CHECK(copy.ownsArrays());
+        CHECK(copy.getNeighbors(5)[0] == csr.getNeighbors(5)[0]);
+    }
+    
+    SUBCASE("Damaged files are rejected") {
+        unsigned int swapped = 0x04030201u;
+        patchFile("graph_test.bin", 8, &swapped, 4);
+        CHECK_THROWS_WITH(graph::MappedGraph("graph_test.bin"), "Graph file has the wrong byte order");
+        
+        graph::GraphFile::write("graph_test.bin", g);
+        unsigned int version = 99;
+        patchFile("graph_test.bin", 12, &version, 4);
+        CHECK_THROWS_WITH(graph::MappedGraph("graph_test.bin"), "Unsupported graph file version");
+        
+        graph::GraphFile::write("graph_test.bin", g);
+        patchFile("graph_test.bin", 0, "GRAPHCSX", 8);
+        CHECK_THROWS_WITH(graph::MappedGraph("graph_test.bin"), "Invalid graph file");
+        
+        // A destination out of range is found unless the destination check is skipped
+        graph::GraphFile::write("graph_test.bin", g);
+        int badVertex = 5000;
+        long destinationsPos = (64 + 4 * 1001 + 63) / 64 * 64;
+        patchFile("graph_test.bin", destinationsPos, &badVertex, 4);
+        CHECK_THROWS_WITH(graph::MappedGraph("graph_test.bin"), "Invalid graph file");
+        CHECK_NOTHROW(graph::MappedGraph("graph_test.bin", false));
+        
+        // Decreasing offsets are always found
+        graph::GraphFile::write("graph_test.bin", g);
+        int badOffset = 1 << 20;
+        patchFile("graph_test.bin", 64 + 4 * 500, &badOffset, 4);
+        CHECK_THROWS_WITH(graph::MappedGraph("graph_test.bin", false), "Invalid graph file");
+        
+        // A truncated file no longer matches its header
+        graph::GraphFile::write("graph_test.bin", g);
+        CHECK(truncate("graph_test.bin", 1000) == 0);
+        CHECK_THROWS_WITH(graph::MappedGraph("graph_test.bin"), "Invalid graph file");
+    }
+    
+    std::remove("graph_test.bin");
+    CHECK_THROWS_WITH(graph::MappedGraph("graph_test.bin"), "Cannot open file for reading");
+}
+
+// Helper function to write a text file for the readers
+void writeTextFile(const char* filename, const char* text) {
+    FILE* file = std::fopen(filename, "wb");
+    std::fputs(text, file);
+    std::fclose(file);
+}
+
+TEST_CASE("Graph file readers") {
+    SUBCASE("SNAP edge lists") {
+        writeTextFile("reader_test.txt",
+                      "# Directed graph\n"
+                      "# FromNodeId\tToNodeId\n"
+                      "0\t1\n"
+                      "1 2 7\r\n"
+                      "\n"
+                      "  2   4\n"
+                      "4 0 3");  // No newline at the end
+        graph::Graph g = graph::GraphReader::readSnap("reader_test.txt");
+        
+        CHECK(g.getNumVertices() == 5);
+        CHECK(countEdges(g) == 4);
+        CHECK(getEdgeWeight(g, 0, 1) == 1);
+        CHECK(getEdgeWeight(g, 1, 2) == 7);
+        CHECK(getEdgeWeight(g, 2, 4) == 1);
+        CHECK(getEdgeWeight(g, 0, 4) == 3);
+        CHECK_FALSE(edgeExists(g, 3, 0));
+        
+        // A trailing comment is fine; any other text after the last field is not
+        writeTextFile("reader_test.txt", "0 1 4 # weighted\n1 2\t% unweighted\n");
+        g = graph::GraphReader::readSnap("reader_test.txt");
+        CHECK(getEdgeWeight(g, 0, 1) == 4);
+        CHECK(getEdgeWeight(g, 1, 2) == 1);
+        writeTextFile("reader_test.txt", "0 1 0.5\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readSnap("reader_test.txt"), "Invalid SNAP line");
+        writeTextFile("reader_test.txt", "1 2 abc\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readSnap("reader_test.txt"), "Invalid SNAP line");
+        writeTextFile("reader_test.txt", "2 3 7 junk\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readSnap("reader_test.txt"), "Invalid SNAP line");
+    }
+    
+    SUBCASE("DIMACS shortest-path files") {
+        writeTextFile("reader_test.txt",
+                      "c 9th DIMACS challenge\n"
+                      "p sp 4 6\n"
+                      "c arcs\n"
+                      "a 1 2 5\n"
+                      "a 2 1 5\n"
+                      "a 2 3 2\n"
+                      "a 3 2 2\n"
+                      "a 1 4 9\n"
+                      "a 4 1 9\n");
+        int numVertices;
+        int edgeCount;
+        graph::WeightedEdge* edges = graph::GraphReader::readEdges("reader_test.txt", graph::FORMAT_DIMACS,
+                                                                  graph::ReaderOptions(), numVertices, edgeCount);
+        CHECK(numVertices == 4);
+        CHECK(edgeCount == 6);
+        CHECK(edges[0].source == 0);
+        CHECK(edges[0].dest == 1);
+        CHECK(edges[5].source == 3);
+        CHECK(edges[5].weight == 9);
+        delete[] edges;
+        
+        // Both directions of each arc are listed; keep one
+        graph::Graph g = graph::GraphReader::readDimacs("reader_test.txt", graph::ReaderOptions(1, true));
+        CHECK(g.getNumVertices() == 4);
+        CHECK(countEdges(g) == 3);
+        CHECK(getEdgeWeight(g, 1, 2) == 2);
+        CHECK(calculateTotalWeight(g) == 16);
+        
+        writeTextFile("reader_test.txt", "p sp 2 1\na 1 3 4\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readDimacs("reader_test.txt"), "Vertex index out of range");
+        writeTextFile("reader_test.txt", "a 1 2 4\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readDimacs("reader_test.txt"), "Missing DIMACS problem line");
+        writeTextFile("reader_test.txt", "p sp 2 1\na 1 x 4\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readDimacs("reader_test.txt"), "Invalid DIMACS line");
+        writeTextFile("reader_test.txt", "p sp 2 1\na 1 2 4.5\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readDimacs("reader_test.txt"), "Invalid DIMACS line");
+        writeTextFile("reader_test.txt", "p sp 2 1 x\na 1 2 4\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readDimacs("reader_test.txt"), "Invalid DIMACS problem line");
+    }
+    
+    SUBCASE("Matrix Market files") {
+        writeTextFile("reader_test.txt",
+                      "%%MatrixMarket matrix coordinate real symmetric\n"
+                      "% comment\n"
+                      "5 5 3\n"
+                      "2 1 1.4\n"
+                      "3 2 -2.6e0\n"
+                      "5 3 10\n");
+        graph::Graph g = graph::GraphReader::readMatrixMarket("reader_test.txt");
+        CHECK(g.getNumVertices() == 5);
+        CHECK(countEdges(g) == 3);
+        CHECK(getEdgeWeight(g, 0, 1) == 1);
+        CHECK(getEdgeWeight(g, 1, 2) == -3);
+        CHECK(getEdgeWeight(g, 2, 4) == 10);
+        
+        writeTextFile("reader_test.txt",
+                      "%%MatrixMarket matrix coordinate pattern general\n"
+                      "3 3 2\n"
+                      "1 2\n"
+                      "3 1\n");
+        g = graph::GraphReader::readMatrixMarket("reader_test.txt");
+        CHECK(g.getNumVertices() == 3);
+        CHECK(getEdgeWeight(g, 0, 1) == 1);
+        CHECK(getEdgeWeight(g, 0, 2) == 1);
+        
+        writeTextFile("reader_test.txt", "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readMatrixMarket("reader_test.txt"), "Unsupported Matrix Market file");
+        writeTextFile("reader_test.txt", "%%MatrixMarket matrix coordinate integer general\n2 3 1\n1 2 5\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readMatrixMarket("reader_test.txt"), "Matrix Market graph must be square");
+        writeTextFile("reader_test.txt", "1 2 5\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readMatrixMarket("reader_test.txt"), "Invalid Matrix Market banner");
+        writeTextFile("reader_test.txt", "%%MatrixMarket matrix coordinate integer general\n2 2 1\n1 2\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readMatrixMarket("reader_test.txt"), "Invalid Matrix Market line");
+        writeTextFile("reader_test.txt", "%%MatrixMarket matrix coordinate integer general\n2 2 1\n1 2 5 junk\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readMatrixMarket("reader_test.txt"), "Invalid Matrix Market line");
+        writeTextFile("reader_test.txt", "%%MatrixMarket matrix coordinate integer general\n2 2 1 1\n1 2 5\n");
+        CHECK_THROWS_WITH(graph::GraphReader::readMatrixMarket("reader_test.txt"), "Invalid Matrix Market size line");
+    }
+    
+    SUBCASE("Small blocks and several threads give the same edges in the same order") {
+        graph::Graph g = randomGraph(500, 3000, 1000, 73);
+        FILE* file = std::fopen("reader_test.txt", "wb");
+        std::fprintf(file, "%%%%MatrixMarket matrix coordinate integer general\n%% random graph\n500 500 3000\n");
+        for (int v = 0; v < 500; v++) {
+            for (graph::Graph::Edge* edge = g.getAdjList(v); edge; edge = edge->next) {
+                if (v < edge->destination) {
+                    std::fprintf(file, "%d %d %d\n", v + 1, edge->destination + 1, edge->weight);
+                }
+            }
+        }
+        std::fclose(file);
+        
+        int n1;
+        int count1;
+        graph::WeightedEdge* edges1 = graph::GraphReader::readEdges("reader_test.txt", graph::FORMAT_MATRIX_MARKET,
+                                                                   graph::ReaderOptions(), n1, count1);
+        
+        // 16-byte blocks cut most lines, and the header spans several blocks
+        graph::ReaderOptions options(4);
+        options.blockSize = 16;
+        int n4;
+        int count4;
+        graph::WeightedEdge* edges4 = graph::GraphReader::readEdges("reader_test.txt", graph::FORMAT_MATRIX_MARKET,
+                                                                   options, n4, count4);
+        
+        CHECK(n1 == 500);
+        CHECK(n4 == 500);
+        CHECK(count1 == countEdges(g));
+        CHECK(count4 == count1);
+        bool same = true;
+        for (int i = 0; i < count1 && i < count4; i++) {
+            same = same && edges1[i].source == edges4[i].source && edges1[i].dest == edges4[i].dest &&
+                   edges1[i].weight == edges4[i].weight;
+        }
+        CHECK(same);
+        delete[] edges1;
+        delete[] edges4;
+        
+        // The random graph may hold parallel edges, so compare totals rather than single weights
+        graph::Graph read = graph::GraphReader::readMatrixMarket("reader_test.txt", options);
+        CHECK(countEdges(read) == countEdges(g));
+        CHECK(calculateTotalWeight(read) == calculateTotalWeight(g));
+    }
+    
+    std::remove("reader_test.txt");
+    CHECK_THROWS_WITH(graph::GraphReader::readSnap("reader_test.txt"), "Cannot open file for reading");
+    CHECK_THROWS_WITH(graph::GraphReader::readSnap("reader_test.txt", graph::ReaderOptions(0)),
+                      "Number of threads must be positive");
+}
+
+// Helper function to check a graph against a matrix of edge counts: lists, degrees and lookups
+bool matchesEdgeCounts(const graph::Graph& g, int counts[][24], int n) {
+    bool ok = true;
+    for (int u = 0; u < n; u++) {
+        int listed[24] = {};
+        int degree = 0;
+        for (graph::Graph::Edge* edge = g.getAdjList(u); edge; edge = edge->next) {
+            listed[edge->destination]++;
+            degree++;
+        }
+        ok = ok && degree == g.getDegree(u);
+        for (int v = 0; v < n; v++) {
+            int expected = u == v ? 2 * counts[u][v] : counts[u][v];
+            ok = ok && listed[v] == expected;
+            ok = ok && g.hasEdge(u, v) == (counts[u][v] > 0);
+            if (counts[u][v] > 0) {
+                ok = ok && g.getWeight(u, v) == 1 + (u < v ? u * 24 + v : v * 24 + u);
+            }
+        }
+    }
+    return ok;
+}
+
+TEST_CASE("Hash-indexed adjacency") {
+    const int n = 24;
+    
+    SUBCASE("Lookups on a small graph") {
+        graph::Graph g(5);
+        CHECK(g.getIndexThreshold() == graph::Graph::DEFAULT_INDEX_THRESHOLD);
+        g.setIndexThreshold(2);
+        g.addEdge(0, 1, 4);
+        g.addEdge(0, 2, 5);
+        g.addEdge(0, 3, 6);
+        g.addEdge(0, 4, 7);
+        
+        CHECK(g.getDegree(0) == 4);
+        CHECK(g.getDegree(1) == 1);
+        CHECK(g.hasEdge(0, 3));
+        CHECK(g.hasEdge(3, 0));
+        CHECK_FALSE(g.hasEdge(1, 2));
+        CHECK(g.getWeight(4, 0) == 7);
+        CHECK_THROWS_WITH(g.getWeight(1, 2), "Edge does not exist");
+        CHECK_THROWS_WITH(g.hasEdge(0, 5), "Vertex index out of range");
+        CHECK_THROWS_WITH(g.setIndexThreshold(-1), "Index threshold must not be negative");
+        
+        // Removing from the middle, the front and the back of an indexed list
+        g.removeEdge(0, 2);
+        g.removeEdge(4, 0);
+        g.removeEdge(0, 1);
+        CHECK(g.getDegree(0) == 1);
+        CHECK(g.getAdjList(0)->destination == 3);
+        CHECK(g.getAdjList(0)->next == nullptr);
+        CHECK_THROWS_WITH(g.removeEdge(0, 2), "Edge does not exist");
+    }
+    
+    SUBCASE("Random churn keeps lists and indexes in step") {
+        int counts[n][n] = {};
+        graph::Graph indexed(n);
+        graph::Graph plain(n);
+        indexed.setIndexThreshold(3);
+        plain.setIndexThreshold(graph::Graph::NO_INDEX);
+        
+        unsigned int seed = 29;
+        bool ok = true;
+        for (int step = 1; step <= 20000; step++) {
+            int u = nextRandom(seed) % n;
+            int v = nextRandom(seed) % (u < 12 ? n : 6); // Vertices 0-5 become hubs
+            int weight = 1 + (u < v ? u * n + v : v * n + u);
+            if (nextRandom(seed) % 10 < 6) {
+                indexed.addEdge(u, v, weight);
+                plain.addEdge(u, v, weight);
+                counts[u][v]++;
+                if (u != v) {
+                    counts[v][u]++;
+                }
+            } else if (counts[u][v] > 0) {
+                indexed.removeEdge(u, v);
+                plain.removeEdge(v, u);
+                counts[u][v]--;
+                if (u != v) {
+                    counts[v][u]--;
+                }
+            }
+            
+            if (step % 2000 == 0) {
+                ok = ok && matchesEdgeCounts(indexed, counts, n) && matchesEdgeCounts(plain, counts, n);
+            }
+            if (step == 10000) {
+                // Bulk insertion in front of indexed lists
+                graph::WeightedEdge edges[3] = { graph::WeightedEdge(0, 1, 2), graph::WeightedEdge(1, 0, 2),
+                                                 graph::WeightedEdge(2, 2, 1 + 2 * n + 2) };
+                indexed.addEdges(edges, 3);
+                plain.addEdges(edges, 3);
+                counts[0][1] += 2;
+                counts[1][0] += 2;
+                counts[2][2]++;
+                ok = ok && matchesEdgeCounts(indexed, counts, n) && matchesEdgeCounts(plain, counts, n);
+            }
+        }
+        CHECK(ok);
+        
+        // Copies, moves and threshold changes rebuild or keep the indexes
+        graph::Graph copy(indexed);
+        CHECK(copy.getIndexThreshold() == 3);
+        copy.removeEdge(0, 1);
+        counts[0][1]--;
+        counts[1][0]--;
+        CHECK(matchesEdgeCounts(copy, counts, n));
+        graph::Graph moved(std::move(copy));
+        moved.setIndexThreshold(graph::Graph::NO_INDEX);
+        CHECK(matchesEdgeCounts(moved, counts, n));
+        moved.setIndexThreshold(0);
+        CHECK(matchesEdgeCounts(moved, counts, n));
+        
+        moved.clear();
+        CHECK(moved.getDegree(0) == 0);
+        CHECK_FALSE(moved.hasEdge(0, 1));
+        moved.addEdge(0, 1, 2);
+        CHECK(moved.getWeight(1, 0) == 2);
+    }
+}
+
+TEST_CASE("Search tree results") {
+    graph::Graph g = randomGraph(300, 1200, 50, 83);
+    graph::CSRGraph csr(g);
+    
+    SUBCASE("Dijkstra distances, parents and paths") {
+        graph::SearchTree tree = graph::Algorithms::dijkstraTree(g, 0);
+        graph::Graph expected = graph::Algorithms::dijkstra(g, 0);
+        
+        CHECK(tree.getNumVertices() == 300);
+        CHECK(tree.getSource() == 0);
+        CHECK(tree.getDistance(0) == 0);
+        CHECK(tree.getParent(0) == -1);
+        CHECK(sameEdges(tree.toGraph(), expected));
+        CHECK(&tree.toGraph() == &tree.toGraph()); // Built once
+        
+        int distance[300];
+        treeDistances(expected, 0, distance);
+        bool same = true;
+        for (int v = 0; v < 300; v++) {
+            same = same && tree.getDistance(v) == (distance[v] == -1 ? INT_MAX : distance[v]);
+            if (tree.isReached(v)) {
+                graph::Path path = tree.pathTo(v);
+                same = same && path.getCost() == distance[v] && path.getVertex(0) == 0 &&
+                       path.getVertex(path.getLength() - 1) == v;
+                if (v != 0) {
+                    same = same && path.getVertex(path.getLength() - 2) == tree.getParent(v);
+                }
+            }
+        }
+        CHECK(same);
+        
+        // The CSR version gives the same distances, into reused arrays
+        graph::SearchTree reused;
+        graph::Algorithms::dijkstraTree(csr, 5, reused);
+        const int* arrays = reused.getDistances();
+        graph::Algorithms::dijkstraTree(csr, 0, reused);
+        CHECK(reused.getDistances() == arrays);
+        same = true;
+        for (int v = 0; v < 300; v++) {
+            same = same && reused.getDistance(v) == tree.getDistance(v);
+        }
+        CHECK(same);
+        CHECK_THROWS_WITH(graph::Algorithms::dijkstraTree(g, 300), "Source vertex out of range");
+        CHECK_THROWS_WITH(tree.getDistance(300), "Vertex index out of range");
+    }
+    
+    SUBCASE("BFS hop counts") {
+        graph::Graph path(5);
+        path.addEdge(0, 1, 4);
+        path.addEdge(1, 2, 6);
+        path.addEdge(3, 4, 1);
+        
+        graph::SearchTree tree = graph::Algorithms::bfsTree(path, 0);
+        CHECK(tree.getDistance(2) == 2);
+        CHECK(tree.getParent(2) == 1);
+        CHECK(tree.getParentWeight(2) == 6);
+        CHECK_FALSE(tree.isReached(3));
+        CHECK(tree.getDistance(3) == INT_MAX);
+        CHECK_FALSE(tree.pathTo(4).exists());
+        CHECK(tree.pathTo(2).getCost() == 10);
+        CHECK(tree.pathTo(0).getLength() == 1);
+        
+        graph::SearchTree fromCsr = graph::Algorithms::bfsTree(csr, 7);
+        int depth[300];
+        treeDepths(graph::Algorithms::bfs(g, 7), 7, depth);
+        bool same = true;
+        for (int v = 0; v < 300; v++) {
+            same = same && fromCsr.getDistance(v) == (depth[v] == -1 ? INT_MAX : depth[v]);
+        }
+        CHECK(same);
+        CHECK(sameEdges(graph::Algorithms::bfsTree(g, 7).toGraph(), graph::Algorithms::bfs(g, 7)));
+    }
+    
+    SUBCASE("Prim parents and tree path weights") {
+        graph::SearchTree forest = graph::Algorithms::primTree(g);
+        CHECK(forest.getSource() == -1);
+        CHECK(sameEdges(forest.toGraph(), graph::Algorithms::prim(g)));
+        CHECK(sameEdges(graph::Algorithms::primTree(csr).toGraph(), graph::Algorithms::prim(csr)));
+        
+        bool ok = true;
+        for (int v = 0; v < 300; v++) {
+            ok = ok && forest.isReached(v);
+            int parent = forest.getParent(v);
+            if (parent != -1) {
+                ok = ok && forest.getDistance(v) == forest.getDistance(parent) + forest.getParentWeight(v);
+                ok = ok && forest.pathTo(v).getCost() == forest.getDistance(v);
+            } else {
+                ok = ok && forest.getDistance(v) == 0;
+            }
+        }
+        CHECK(ok);
+    }
+    
+    SUBCASE("Copies and moves") {
+        graph::SearchTree tree = graph::Algorithms::dijkstraTree(g, 3);
+        graph::SearchTree copy(tree);
+        CHECK(copy.getDistances() != tree.getDistances());
+        CHECK(copy.getDistance(10) == tree.getDistance(10));
+        graph::SearchTree moved(std::move(copy));
+        CHECK(copy.getNumVertices() == 0);
+        CHECK(moved.getParent(10) == tree.getParent(10));
+        CHECK_THROWS_WITH(copy.toGraph(), "Search tree is empty");
+    }
+}
+
+// Row sink that checks every row against Dijkstra and counts the rows it got
+class CheckingRowSink : public graph::DistanceRowSink {
+public:
+    CheckingRowSink(const graph::Graph& graph) : g(graph), rows(0), correct(true), throwAt(-1), throwStd(false) {}
+    
+    void row(int index, int source, const int* distances, int numTargets) {
+        if (index == throwAt && throwStd) {
+            throw std::runtime_error("Sink failed");
+        }
+        if (index == throwAt) {
+            throw "Sink is full";
+        }
+        rows++;
+        graph::SearchTree tree = graph::Algorithms::dijkstraTree(g, source);
+        correct = correct && numTargets == g.getNumVertices();
+        for (int v = 0; v < numTargets; v++) {
+            correct = correct && distances[v] == tree.getDistance(v);
+        }
+    }
+    
+    const graph::Graph& g;
+    int rows;
+    bool correct;
+    int throwAt;
+    bool throwStd;
+};
+
+TEST_CASE("Multi-source distance tables") {
+    graph::Graph g = randomGraph(400, 900, 40, 91); // Sparse enough to leave some vertices unreachable
+    graph::CSRGraph csr(g);
+    int sources[50];
+    unsigned int seed = 5;
+    for (int i = 0; i < 50; i++) {
+        sources[i] = nextRandom(seed) % 400;
+    }
+    
+    SUBCASE("Table rows match Dijkstra for any number of threads") {
+        graph::DistanceTable table;
+        graph::Algorithms::multiSourceDistances(csr, sources, 50, 1, table);
+        CHECK(table.getNumSources() == 50);
+        CHECK(table.getNumTargets() == 400);
+        
+        bool same = true;
+        for (int i = 0; i < 50; i++) {
+            graph::SearchTree tree = graph::Algorithms::dijkstraTree(g, sources[i]);
+            same = same && table.getSource(i) == sources[i];
+            for (int v = 0; v < 400; v++) {
+                same = same && table.getDistance(i, v) == tree.getDistance(v);
+            }
+        }
+        CHECK(same);
+        
+        graph::DistanceTable parallel;
+        graph::Algorithms::multiSourceDistances(g, sources, 50, 4, parallel);
+        same = true;
+        for (int i = 0; i < 50; i++) {
+            for (int v = 0; v < 400; v++) {
+                same = same && parallel.getRow(i)[v] == table.getRow(i)[v];
+            }
+        }
+        CHECK(same);
+        
+        CHECK_THROWS_WITH(table.getDistance(50, 0), "Row index out of range");
+        graph::Algorithms::multiSourceDistances(csr, sources, 0, 4, table);
+        CHECK(table.getNumSources() == 0);
+    }
+    
+    SUBCASE("All pairs") {
+        graph::Graph small = randomGraph(60, 200, 9, 7);
+        graph::DistanceTable all = graph::Algorithms::allPairsDistances(small, 3);
+        CHECK(all.getNumSources() == 60);
+        bool symmetric = true;
+        for (int u = 0; u < 60; u++) {
+            symmetric = symmetric && all.getSource(u) == u && all.getDistance(u, u) == 0;
+            for (int v = 0; v < 60; v++) {
+                symmetric = symmetric && all.getDistance(u, v) == all.getDistance(v, u);
+            }
+        }
+        CHECK(symmetric);
+        
+        graph::DistanceTable copy(all);
+        graph::DistanceTable moved(std::move(all));
+        CHECK(all.getNumSources() == 0);
+        CHECK(copy.getDistance(3, 17) == moved.getDistance(3, 17));
+    }
+    
+    SUBCASE("Streaming rows to a sink") {
+        CheckingRowSink sink(g);
+        graph::Algorithms::multiSourceDistances(csr, sources, 50, 4, sink);
+        CHECK(sink.rows == 50);
+        CHECK(sink.correct);
+        
+        CheckingRowSink failing(g);
+        failing.throwAt = 10;
+        CHECK_THROWS_WITH(graph::Algorithms::multiSourceDistances(csr, sources, 50, 3, failing), "Sink is full");
+        CHECK(failing.rows < 50);
+        
+        // Any exception type reaches the caller, from worker threads as well as the calling one
+        for (int k = 0; k < 4; k++) {
+            CheckingRowSink standard(g);
+            standard.throwAt = 5 + 11 * k;
+            standard.throwStd = true;
+            CHECK_THROWS_AS(graph::Algorithms::multiSourceDistances(csr, sources, 50, 4, standard),
+                            std::runtime_error);
+        }
+    }
+    
+    SUBCASE("Invalid input") {
+        graph::DistanceTable table;
+        int bad[2] = { 0, 400 };
+        CHECK_THROWS_WITH(graph::Algorithms::multiSourceDistances(csr, bad, 2, 2, table), "Source vertex out of range");
+        CHECK_THROWS_WITH(graph::Algorithms::multiSourceDistances(csr, sources, 5, 0, table),
+                          "Number of threads must be positive");
+        graph::Graph negative(3);
+        negative.addEdge(0, 1, -2);
+        CHECK_THROWS_WITH(graph::Algorithms::allPairsDistances(negative, 2),
+                          "Multi-source distances need non-negative weights");
+    }
+}
+    
+// The reached vertices of a bounded query are exactly those within the bound in a
+// full search, with the same distances
+bool matchesFullSearch(const graph::QueryContext& context, const graph::SearchTree& full, int bound) {
+    int within = 0;
+    bool same = true;
+    for (int v = 0; v < full.getNumVertices(); v++) {
+        int distance = full.getDistance(v);
+        if (distance <= bound) {
+            within++;
+            same = same && context.isReached(v) && context.getDistance(v) == distance;
+        } else {
+            same = same && !context.isReached(v) && context.getDistance(v) == INT_MAX &&
+                   context.getParent(v) == -1;
+        }
+    }
+    return same && within == context.getReachedCount();
+}
+    
+TEST_CASE("Bounded searches with a query context") {
+    graph::Graph g = gridGraph(30, 30, 20, 17);
+    graph::CSRGraph csr(g);
+    graph::QueryContext context;
+    CHECK(context.getSource() == -1);
+    CHECK(context.getReachedCount() == 0);
+    
+    SUBCASE("Hop-limited BFS") {
+        unsigned int seed = 3;
+        bool same = true;
+        for (int query = 0; query < 40; query++) {
+            int source = nextRandom(seed) % 900;
+            int hops = query % 8;
+            graph::SearchTree full = graph::Algorithms::bfsTree(g, source);
+            int count = graph::Algorithms::boundedBfs(g, source, hops, context);
+            same = same && count == context.getReachedCount() && context.getSource() == source;
+            same = same && matchesFullSearch(context, full, hops);
+            graph::Algorithms::boundedBfs(csr, source, hops, context);
+            same = same && matchesFullSearch(context, full, hops);
+        }
+        CHECK(same);
+        
+        // The source comes first and the list is in order of depth
+        graph::Algorithms::boundedBfs(csr, 465, 5, context);
+        const int* reached = context.getReached();
+        CHECK(reached[0] == 465);
+        bool ordered = true;
+        for (int i = 1; i < context.getReachedCount(); i++) {
+            ordered = ordered && context.getDistance(reached[i - 1]) <= context.getDistance(reached[i]);
+        }
+        CHECK(ordered);
+        
+        CHECK(graph::Algorithms::boundedBfs(g, 0, 0, context) == 1);
+        CHECK(context.pathTo(0).getLength() == 1);
+        CHECK(context.pathTo(899).getLength() == 0);
+    }
+    
+    SUBCASE("Radius-limited Dijkstra") {
+        unsigned int seed = 8;
+        bool same = true;
+        for (int query = 0; query < 40; query++) {
+            int source = nextRandom(seed) % 900;
+            int radius = nextRandom(seed) % 120;
+            graph::SearchTree full = graph::Algorithms::dijkstraTree(g, source);
+            graph::Algorithms::boundedDijkstra(g, source, radius, context);
+            same = same && matchesFullSearch(context, full, radius);
+            graph::Algorithms::boundedDijkstra(csr, source, radius, context);
+            same = same && matchesFullSearch(context, full, radius);
+            
+            // Settle order is by distance, and paths are shortest paths
+            const int* reached = context.getReached();
+            for (int i = 1; i < context.getReachedCount(); i++) {
+                same = same && context.getDistance(reached[i - 1]) <= context.getDistance(reached[i]);
+            }
+            int last = reached[context.getReachedCount() - 1];
+            graph::Path path = context.pathTo(last);
+            same = same && validPath(g, path, source, last) && path.getCost() == full.getDistance(last);
+        }
+        CHECK(same);
+        
+        // A radius covering the whole graph gives the full search
+        graph::SearchTree full = graph::Algorithms::dijkstraTree(csr, 0);
+        graph::Algorithms::boundedDijkstra(csr, 0, 1000000000, context);
+        CHECK(context.getReachedCount() == 900);
+        CHECK(matchesFullSearch(context, full, INT_MAX - 1));
+    }
+    
+    SUBCASE("One context across graphs of different sizes") {
+        graph::Graph small = randomGraph(50, 80, 9, 4);
+        graph::Algorithms::boundedDijkstra(small, 7, 15, context);
+        CHECK(matchesFullSearch(context, graph::Algorithms::dijkstraTree(small, 7), 15));
+        CHECK_THROWS_WITH(context.getDistance(50), "Vertex index out of range");
+        
+        graph::Algorithms::boundedBfs(g, 899, 3, context);
+        CHECK(matchesFullSearch(context, graph::Algorithms::bfsTree(g, 899), 3));
+        graph::Algorithms::boundedBfs(small, 7, 2, context);
+        CHECK(matchesFullSearch(context, graph::Algorithms::bfsTree(small, 7), 2));
+    }
+    
+    SUBCASE("Invalid input") {
+        CHECK_THROWS_WITH(graph::Algorithms::boundedBfs(g, 900, 2, context), "Source vertex out of range");
+        CHECK_THROWS_WITH(graph::Algorithms::boundedBfs(csr, 0, -1, context), "Hop limit must not be negative");
+        CHECK_THROWS_WITH(graph::Algorithms::boundedDijkstra(csr, -1, 2, context), "Source vertex out of range");
+        CHECK_THROWS_WITH(graph::Algorithms::boundedDijkstra(g, 0, -1, context), "Radius must not be negative");
+        
+        graph::Graph negative(4);
+        negative.addEdge(0, 1, 2);
+        negative.addEdge(1, 2, -3);
+        CHECK_THROWS_WITH(graph::Algorithms::boundedDijkstra(negative, 0, 10, context),
+                          "Bounded Dijkstra needs non-negative weights");
+        
+        // The context is still usable after a failed query
+        CHECK(graph::Algorithms::boundedDijkstra(negative, 3, 10, context) == 1);
+        CHECK(graph::Algorithms::boundedDijkstra(g, 0, 0, context) >= 1);
+    }
+}
+    
+// Helper function to compare a connectivity index with components computed from scratch
+bool matchesConnectivity(const graph::Graph& g) {
+    const graph::ConnectivityIndex& index = g.getConnectivity();
+    int numVertices = g.getNumVertices();
+    graph::UnionFind uf(numVertices);
+    for (int i = 0; i < numVertices; i++) {
+        for (graph::Graph::Edge* edge = g.getAdjList(i); edge; edge = edge->next) {
+            uf.unite(i, edge->destination);
+        }
+    }
+    
+    int* sizes = new int[numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        sizes[i] = 0;
+    }
+    for (int i = 0; i < numVertices; i++) {
+        sizes[uf.find(i)]++;
+    }
+    
+    // Every component id must stand for exactly one component
+    int* rootOfId = new int[numVertices];
+    for (int i = 0; i < numVertices; i++) {
+        rootOfId[i] = -1;
+    }
+    bool same = index.getNumComponents() == countComponents(g);
+    int* members = new int[numVertices];
+    for (int v = 0; v < numVertices && same; v++) {
+        int id = index.componentOf(v);
+        if (rootOfId[id] == -1) {
+            rootOfId[id] = uf.find(v);
+        }
+        same = rootOfId[id] == uf.find(v) && index.componentSize(v) == sizes[uf.find(v)];
+        
+        int count = index.getComponent(v, members);
+        same = same && count == sizes[uf.find(v)];
+        for (int i = 0; i < count && same; i++) {
+            same = index.componentOf(members[i]) == id;
+        }
+    }
+    
+    delete[] rootOfId;
+    delete[] members;
+    delete[] sizes;
+    return same;
+}
+    
+TEST_CASE("Incremental connectivity index") {
+    SUBCASE("Adding and removing edges") {
+        graph::Graph g(6);
+        CHECK_THROWS_WITH(g.getConnectivity(), "Connectivity is not tracked");
+        g.trackConnectivity(true);
+        CHECK(g.isTrackingConnectivity());
+        const graph::ConnectivityIndex& index = g.getConnectivity();
+        CHECK(index.getNumComponents() == 6);
+        
+        g.addEdge(0, 1);
+        g.addEdge(1, 2);
+        g.addEdge(3, 4);
+        CHECK(index.connected(0, 2));
+        CHECK_FALSE(index.connected(2, 3));
+        CHECK(index.componentSize(1) == 3);
+        CHECK(index.getNumComponents() == 3);
+        
+        // A parallel edge keeps the component together until the last copy goes
+        g.addEdge(1, 2, 5);
+        g.removeEdge(1, 2);
+        CHECK(index.connected(0, 2));
+        g.removeEdge(1, 2);
+        CHECK_FALSE(index.connected(0, 2));
+        CHECK(index.componentSize(0) == 2);
+        CHECK(index.componentSize(2) == 1);
+        CHECK(index.getNumComponents() == 4);
+        
+        // Removing a cycle edge splits nothing
+        g.addEdge(2, 0);
+        g.addEdge(2, 1);
+        g.removeEdge(0, 1);
+        CHECK(index.connected(0, 1));
+        CHECK(index.getNumComponents() == 3);
+        
+        g.addEdge(5, 5);
+        g.removeEdge(5, 5);
+        CHECK(index.componentSize(5) == 1);
+        CHECK(matchesConnectivity(g));
+        
+        g.clear();
+        CHECK(index.getNumComponents() == 6);
+        CHECK_THROWS_WITH(index.componentOf(6), "Vertex index out of range");
+        
+        g.trackConnectivity(false);
+        CHECK_FALSE(g.isTrackingConnectivity());
+    }
+    
+    SUBCASE("Random churn matches components from scratch") {
+        graph::Graph g = randomGraph(300, 330, 9, 12);
+        g.trackConnectivity(true);
+        CHECK(matchesConnectivity(g));
+        
+        unsigned int seed = 77;
+        bool same = true;
+        for (int step = 0; step < 600; step++) {
+            int u = nextRandom(seed) % 300;
+            if (step % 3 != 0 && g.getAdjList(u)) {
+                g.removeEdge(u, g.getAdjList(u)->destination);
+            } else {
+                g.addEdge(u, nextRandom(seed) % 300);
+            }
+            if (step % 20 == 0) {
+                same = same && matchesConnectivity(g);
+            }
+        }
+        CHECK(same);
+        CHECK(matchesConnectivity(g));
+        
+        graph::WeightedEdge edges[50];
+        for (int i = 0; i < 50; i++) {
+            edges[i] = graph::WeightedEdge(nextRandom(seed) % 300, nextRandom(seed) % 300);
+        }
+        g.addEdges(edges, 50);
+        CHECK(matchesConnectivity(g));
+    }
+    
+    SUBCASE("Copies and moves keep the index") {
+        graph::Graph g = randomGraph(100, 80, 5, 3);
+        g.trackConnectivity(true);
+        
+        graph::Graph copy(g);
+        CHECK(copy.isTrackingConnectivity());
+        CHECK(&copy.getConnectivity() != &g.getConnectivity());
+        CHECK(matchesConnectivity(copy));
+        
+        graph::Graph moved(std::move(copy));
+        CHECK_FALSE(copy.isTrackingConnectivity());
+        moved.addEdge(0, 99);
+        CHECK(moved.getConnectivity().connected(0, 99));
+        CHECK(matchesConnectivity(moved));
+        
+        graph::Graph assigned(5);
+        assigned = g;
+        CHECK(matchesConnectivity(assigned));
+        graph::Graph plain(5);
+        plain.swap(assigned);
+        CHECK(plain.isTrackingConnectivity());
+        CHECK_FALSE(assigned.isTrackingConnectivity());
+    }
+}
+    
+// Helper function to compare a repaired tree with a from-scratch Dijkstra run. Every
+// parent must be a neighbor that lies on a shortest path.
+bool matchesDijkstra(const graph::Graph& g, const graph::DynamicShortestPaths& paths) {
+    graph::SearchTree full = graph::Algorithms::dijkstraTree(g, paths.getSource());
+    bool same = true;
+    for (int v = 0; v < g.getNumVertices() && same; v++) {
+        same = paths.getDistance(v) == full.getDistance(v);
+        int p = paths.getParent(v);
+        if (v == paths.getSource() || !paths.isReached(v)) {
+            same = same && p == -1;
+            continue;
+        }
+        
+        int lightest = INT_MAX;
+        for (graph::Graph::Edge* edge = g.getAdjList(v); edge; edge = edge->next) {
+            if (edge->destination == p && edge->weight < lightest) {
+                lightest = edge->weight;
+            }
+        }
+        same = same && lightest != INT_MAX && paths.getDistance(p) + lightest == paths.getDistance(v);
+    }
+    return same;
+}
+    
+TEST_CASE("Dynamic shortest-path trees") {
+    SUBCASE("Setting edge weights") {
+        graph::Graph g(4);
+        g.addEdge(0, 1, 5);
+        g.addEdge(0, 1, 7);
+        g.addEdge(2, 2, 1);
+        g.setWeight(1, 0, 3);
+        CHECK(g.getWeight(0, 1) == 3);
+        CHECK(g.getWeight(1, 0) == 3);
+        CHECK(g.getDegree(0) == 2);
+        CHECK(g.getAdjList(0)->weight == 3);
+        CHECK(g.getAdjList(0)->next->weight == 3);
+        g.setWeight(2, 2, 4);
+        CHECK(g.getWeight(2, 2) == 4);
+        CHECK_THROWS_WITH(g.setWeight(0, 3, 1), "Edge does not exist");
+        CHECK_THROWS_WITH(g.setWeight(0, 4, 1), "Vertex index out of range");
+        
+        // Through the hash index of a hub vertex
+        graph::Graph hub(100);
+        hub.setIndexThreshold(4);
+        for (int v = 1; v < 100; v++) {
+            hub.addEdge(0, v, v);
+        }
+        hub.setWeight(0, 42, 1);
+        hub.setWeight(77, 0, 2);
+        CHECK(hub.getWeight(42, 0) == 1);
+        CHECK(hub.getWeight(0, 77) == 2);
+        CHECK(hub.getWeight(0, 76) == 76);
+    }
+    
+    SUBCASE("Single updates on a small graph") {
+        graph::Graph g(5);
+        g.addEdge(0, 1, 2);
+        g.addEdge(1, 2, 2);
+        g.addEdge(0, 3, 10);
+        graph::DynamicShortestPaths paths(g, 0);
+        CHECK(paths.getDistance(2) == 4);
+        CHECK(paths.getDistance(4) == INT_MAX);
+        CHECK(paths.pathTo(2).getLength() == 3);
+        
+        // Cutting the tree edge above 2 and 1 sends them the long way round
+        g.addEdge(2, 3, 1);
+        paths.edgeChanged(2, 3);
+        CHECK(paths.getDistance(3) == 5);
+        CHECK(paths.getParent(3) == 2);
+        g.removeEdge(0, 1);
+        paths.edgeChanged(0, 1);
+        CHECK(paths.getDistance(2) == 11);
+        CHECK(paths.getDistance(1) == 13);
+        CHECK(paths.getParent(1) == 2);
+        CHECK(matchesDijkstra(g, paths));
+        
+        g.setWeight(0, 3, 1);
+        paths.edgeChanged(3, 0);
+        CHECK(paths.getDistance(1) == 4);
+        CHECK(paths.pathTo(1).getCost() == 4);
+        
+        g.removeEdge(0, 3);
+        paths.edgeChanged(0, 3);
+        CHECK_FALSE(paths.isReached(1));
+        CHECK(paths.pathTo(1).getLength() == 0);
+        CHECK(matchesDijkstra(g, paths));
+        
+        // Nothing to do for an unrelated pair
+        paths.edgeChanged(3, 4);
+        CHECK(paths.getLastRepairSize() == 0);
+        CHECK_THROWS_WITH(paths.edgeChanged(0, 5), "Vertex index out of range");
+    }
+    
+    SUBCASE("Random updates stay consistent with a full run") {
+        graph::Graph g = gridGraph(20, 20, 30, 5);
+        for (int i = 0; i < 60; i++) {
+            unsigned int seed = i + 1;
+            g.addEdge(nextRandom(seed) % 400, nextRandom(seed) % 400, 1 + nextRandom(seed) % 60);
+        }
+        graph::DynamicShortestPaths first(g, 0);
+        graph::DynamicShortestPaths second(g, 210);
+        
+        unsigned int seed = 99;
+        bool same = true;
+        for (int step = 0; step < 300; step++) {
+            int u = nextRandom(seed) % 400;
+            int v;
+            int kind = step % 4;
+            if (kind == 0 || !g.getAdjList(u)) {
+                v = nextRandom(seed) % 400;
+                g.addEdge(u, v, nextRandom(seed) % 40); // Zero weights included
+            } else {
+                v = g.getAdjList(u)->destination;
+                if (kind == 1) {
+                    g.removeEdge(u, v);
+                } else {
+                    g.setWeight(u, v, kind == 2 ? g.getWeight(u, v) + 25 : g.getWeight(u, v) / 3);
+                }
+            }
+            first.edgeChanged(u, v);
+            second.edgeChanged(v, u);
+            if (step % 10 == 0) {
+                same = same && matchesDijkstra(g, first) && matchesDijkstra(g, second);
+            }
+        }
+        CHECK(same);
+        CHECK(matchesDijkstra(g, first));
+        CHECK(matchesDijkstra(g, second));
+    }
+    
+    SUBCASE("Repairs stay local") {
+        graph::Graph g = gridGraph(40, 40, 10, 9);
+        graph::DynamicShortestPaths paths(g, 0);
+        
+        // The far corner is a leaf of the tree or close to it
+        int corner = 1599;
+        int neighbor = g.getAdjList(corner)->destination;
+        g.setWeight(corner, neighbor, g.getWeight(corner, neighbor) + 100);
+        paths.edgeChanged(corner, neighbor);
+        CHECK(paths.getLastRepairSize() < 20);
+        CHECK(matchesDijkstra(g, paths));
+    }
+    
+    SUBCASE("Invalid input") {
+        graph::Graph g(3);
+        g.addEdge(0, 1, -1);
+        CHECK_THROWS_WITH(graph::DynamicShortestPaths(g, 0), "Dynamic shortest paths need non-negative weights");
+        CHECK_THROWS_WITH(graph::DynamicShortestPaths(g, 3), "Source vertex out of range");
+        g.setWeight(0, 1, 1);
+        graph::DynamicShortestPaths paths(g, 0);
+        g.addEdge(1, 2, -4);
+        CHECK_THROWS_WITH(paths.edgeChanged(1, 2), "Dynamic shortest paths need non-negative weights");
+    }
+}
+    
+// Helper function to compare a maintained forest with Kruskal on the current graph.
+// Every forest edge must be a graph edge and the forest must span every component.
+bool matchesKruskal(const graph::Graph& g, const graph::MinimumSpanningForest& forest) {
+    graph::Graph tree = forest.toGraph();
+    bool same = forest.getTotalWeight() == calculateTotalWeight(graph::Algorithms::kruskal(g)) &&
+                forest.getNumEdges() == countEdges(tree) &&
+                forest.getNumEdges() == g.getNumVertices() - countComponents(g) &&
+                countComponents(tree) == countComponents(g);
+    for (int u = 0; u < g.getNumVertices() && same; u++) {
+        for (graph::Graph::Edge* edge = tree.getAdjList(u); edge && same; edge = edge->next) {
+            bool found = false;
+            for (graph::Graph::Edge* other = g.getAdjList(u); other; other = other->next) {
+                found = found || (other->destination == edge->destination && other->weight == edge->weight);
+            }
+            same = found;
+        }
+    }
+    return same;
+}
+    
+TEST_CASE("Incremental minimum spanning forest") {
+    SUBCASE("Cycles, removals and replacements") {
+        graph::Graph g(5);
+        g.addEdge(0, 1, 4);
+        g.addEdge(1, 2, 6);
+        graph::MinimumSpanningForest forest(g);
+        CHECK(forest.getNumEdges() == 2);
+        CHECK(forest.getTotalWeight() == 10);
+        CHECK_FALSE(forest.connected(0, 3));
+        
+        // Closing the cycle drops its heaviest edge
+        g.addEdge(0, 2, 5);
+        forest.edgeAdded(0, 2, 5);
+        CHECK(forest.getTotalWeight() == 9);
+        CHECK(forest.bottleneck(1, 2) == 5);
+        g.addEdge(0, 2, 9);
+        forest.edgeAdded(2, 0, 9);
+        CHECK(forest.getTotalWeight() == 9);
+        
+        // Removing a forest edge brings back the lightest edge across
+        g.removeEdge(0, 1);
+        forest.edgeRemoved(0, 1);
+        CHECK(forest.getTotalWeight() == 11);
+        CHECK(forest.connected(1, 0));
+        CHECK(matchesKruskal(g, forest));
+        
+        // A bridge leaves two trees
+        g.addEdge(2, 3, 1);
+        forest.edgeAdded(2, 3, 1);
+        g.removeEdge(2, 3);
+        forest.edgeRemoved(2, 3);
+        CHECK_FALSE(forest.connected(2, 3));
+        CHECK_THROWS_WITH(forest.bottleneck(2, 3), "Vertices are not connected");
+        CHECK(forest.bottleneck(4, 4) == INT_MIN);
+        CHECK(matchesKruskal(g, forest));
+        
+        // A weight change is a removal followed by an addition
+        g.setWeight(1, 2, 1);
+        forest.edgeRemoved(1, 2);
+        forest.edgeAdded(1, 2, 1);
+        CHECK(forest.getTotalWeight() == 6);
+        CHECK(matchesKruskal(g, forest));
+        
+        CHECK_THROWS_WITH(forest.edgeAdded(0, 5, 1), "Vertex index out of range");
+    }
+    
+    SUBCASE("Random churn matches Kruskal") {
+        graph::Graph g = randomGraph(150, 250, 50, 21);
+        graph::MinimumSpanningForest forest(g);
+        CHECK(matchesKruskal(g, forest));
+        
+        unsigned int seed = 55;
+        bool same = true;
+        for (int step = 0; step < 600; step++) {
+            int u = nextRandom(seed) % 150;
+            int kind = step % 3;
+            if (kind == 0 || !g.getAdjList(u)) {
+                int v = nextRandom(seed) % 150;
+                int weight = nextRandom(seed) % 50;
+                g.addEdge(u, v, weight);
+                forest.edgeAdded(u, v, weight);
+            } else if (kind == 1) {
+                int v = g.getAdjList(u)->destination;
+                g.removeEdge(u, v);
+                forest.edgeRemoved(u, v);
+            } else {
+                int v = g.getAdjList(u)->destination;
+                int weight = nextRandom(seed) % 50;
+                g.setWeight(u, v, weight);
+                forest.edgeRemoved(u, v);
+                forest.edgeAdded(u, v, weight);
+            }
+            if (step % 15 == 0) {
+                same = same && matchesKruskal(g, forest);
+            }
+        }
+        CHECK(same);
+        CHECK(matchesKruskal(g, forest));
+        
+        // The bottleneck is the heaviest edge on the forest path
+        graph::Graph tree = forest.toGraph();
+        bool bottlenecks = true;
+        for (int i = 0; i < 30; i++) {
+            int u = nextRandom(seed) % 150;
+            int v = nextRandom(seed) % 150;
+            if (u == v || !forest.connected(u, v)) {
+                continue;
+            }
+            graph::Path path = graph::Algorithms::bfsTree(tree, u).pathTo(v);
+            int heaviest = INT_MIN;
+            for (int k = 0; k + 1 < path.getLength(); k++) {
+                int weight = getEdgeWeight(tree, path.getVertex(k), path.getVertex(k + 1));
+                heaviest = weight > heaviest ? weight : heaviest;
+            }
+            bottlenecks = bottlenecks && forest.bottleneck(u, v) == heaviest;
+        }
+        CHECK(bottlenecks);
+    }
+}
+    
+// Helper function to check that a relabeled graph has exactly the edges of the original
+// under the new labels: same degrees, same weights, and every original edge present
+bool sameEdgesRelabeled(const graph::Graph& g, const graph::Graph& relabeled, const graph::VertexOrdering& ordering) {
+    bool same = countEdges(g) == countEdges(relabeled) &&
+                calculateTotalWeight(g) == calculateTotalWeight(relabeled);
+    for (int u = 0; u < g.getNumVertices() && same; u++) {
+        int ru = ordering.toRelabeled(u);
+        same = ordering.toOriginal(ru) == u && g.getDegree(u) == relabeled.getDegree(ru);
+        for (graph::Graph::Edge* edge = g.getAdjList(u); edge && same; edge = edge->next) {
+            same = relabeled.hasEdge(ru, ordering.toRelabeled(edge->destination));
+        }
+    }
+    return same;
+}
+    
+// Largest label difference over the edges of a graph
+int bandwidth(const graph::CSRGraph& g) {
+    int widest = 0;
+    for (int u = 0; u < g.getNumVertices(); u++) {
+        for (int i = 0; i < g.getDegree(u); i++) {
+            int gap = g.getNeighbors(u)[i] - u;
+            gap = gap < 0 ? -gap : gap;
+            widest = gap > widest ? gap : widest;
+        }
+    }
+    return widest;
+}
+    
+TEST_CASE("Vertex reordering") {
+    // A 30 x 30 grid whose labels are shuffled, plus a self-loop and a parallel edge
+    graph::Graph grid = gridGraph(30, 30, 20, 11);
+    int shuffle[900];
+    for (int i = 0; i < 900; i++) {
+        shuffle[i] = i;
+    }
+    unsigned int seed = 4;
+    for (int i = 899; i > 0; i--) {
+        int j = nextRandom(seed) % (i + 1);
+        int temp = shuffle[i];
+        shuffle[i] = shuffle[j];
+        shuffle[j] = temp;
+    }
+    graph::VertexOrdering shuffled(shuffle, 900);
+    graph::Graph g = shuffled.relabel(grid);
+    CHECK(sameEdgesRelabeled(grid, g, shuffled));
+    g.addEdge(5, 5, 3);
+    g.addEdge(7, g.getAdjList(7)->destination, 1);
+    graph::CSRGraph csr(g);
+    
+    SUBCASE("Relabeling keeps every edge") {
+        graph::VertexOrdering orderings[3] = { graph::VertexOrdering::reverseCuthillMcKee(g),
+                                               graph::VertexOrdering::degreeDescending(csr),
+                                               graph::VertexOrdering::bfsOrder(g, 17) };
+        for (int k = 0; k < 3; k++) {
+            CHECK(orderings[k].getNumVertices() == 900);
+            graph::Graph relabeled = orderings[k].relabel(g);
+            CHECK(sameEdgesRelabeled(g, relabeled, orderings[k]));
+            
+            // Restoring the relabeled graph gives the original edges back
+            graph::Graph restored = orderings[k].restore(relabeled);
+            CHECK(countEdges(restored) == countEdges(g));
+            CHECK(calculateTotalWeight(restored) == calculateTotalWeight(g));
+            CHECK(restored.getDegree(5) == g.getDegree(5));
+            
+            // CSR neighbor lists come out sorted by label
+            graph::CSRGraph relabeledCsr = orderings[k].relabel(csr);
+            bool sorted = relabeledCsr.getNumHalfEdges() == csr.getNumHalfEdges();
+            for (int u = 0; u < 900; u++) {
+                for (int i = 1; i < relabeledCsr.getDegree(u); i++) {
+                    sorted = sorted && relabeledCsr.getNeighbors(u)[i - 1] <= relabeledCsr.getNeighbors(u)[i];
+                }
+            }
+            CHECK(sorted);
+        }
+    }
+    
+    SUBCASE("Orderings") {
+        // Reverse Cuthill-McKee brings the grid back to a narrow band
+        graph::VertexOrdering rcm = graph::VertexOrdering::reverseCuthillMcKee(csr);
+        CHECK(bandwidth(csr) > 600);
+        CHECK(bandwidth(rcm.relabel(csr)) <= 62);
+        
+        graph::VertexOrdering byDegree = graph::VertexOrdering::degreeDescending(g);
+        bool descending = true;
+        for (int i = 1; i < 900; i++) {
+            descending = descending && g.getDegree(byDegree.toOriginal(i - 1)) >= g.getDegree(byDegree.toOriginal(i));
+        }
+        CHECK(descending);
+        
+        graph::VertexOrdering bfs = graph::VertexOrdering::bfsOrder(csr, 123);
+        CHECK(bfs.toRelabeled(123) == 0);
+        graph::SearchTree tree = graph::Algorithms::bfsTree(csr, 123);
+        bool layered = true;
+        for (int i = 1; i < 900; i++) {
+            layered = layered && tree.getDistance(bfs.toOriginal(i - 1)) <= tree.getDistance(bfs.toOriginal(i));
+        }
+        CHECK(layered);
+        
+        // Components after the first follow in label order
+        graph::Graph split(6);
+        split.addEdge(4, 5);
+        split.addEdge(0, 1);
+        graph::VertexOrdering parts = graph::VertexOrdering::bfsOrder(split, 4);
+        CHECK(parts.toOriginal(0) == 4);
+        CHECK(parts.toOriginal(1) == 5);
+        CHECK(parts.toOriginal(2) == 0);
+        CHECK(parts.toOriginal(5) == 3);
+    }
+    
+    SUBCASE("Results translate back") {
+        graph::VertexOrdering rcm = graph::VertexOrdering::reverseCuthillMcKee(csr);
+        graph::CSRGraph relabeled = rcm.relabel(csr);
+        int source = 321;
+        graph::SearchTree expected = graph::Algorithms::dijkstraTree(csr, source);
+        graph::SearchTree tree = graph::Algorithms::dijkstraTree(relabeled, rcm.toRelabeled(source));
+        
+        int distances[900];
+        int parents[900];
+        rcm.restoreValues(tree.getDistances(), distances);
+        rcm.restoreVertices(tree.getParents(), parents);
+        bool same = parents[source] == -1;
+        for (int v = 0; v < 900; v++) {
+            same = same && distances[v] == expected.getDistance(v);
+            if (v != source) {
+                same = same && distances[parents[v]] + g.getWeight(parents[v], v) >= distances[v] &&
+                       g.hasEdge(parents[v], v);
+            }
+        }
+        CHECK(same);
+        
+        graph::Path path = rcm.restore(tree.pathTo(rcm.toRelabeled(800)));
+        CHECK(path.getVertex(0) == source);
+        CHECK(path.getVertex(path.getLength() - 1) == 800);
+        CHECK(path.getCost() == expected.getDistance(800));
+        CHECK_FALSE(rcm.restore(graph::Path()).exists());
+        
+        graph::Graph restoredTree = rcm.restore(graph::Algorithms::dijkstra(relabeled, rcm.toRelabeled(source)));
+        CHECK(countEdges(restoredTree) == 899);
+        CHECK(restoredTree.hasEdge(800, path.getVertex(path.getLength() - 2)));
+    }
+    
+    SUBCASE("Copies and invalid input") {
+        graph::VertexOrdering bfs = graph::VertexOrdering::bfsOrder(g);
+        graph::VertexOrdering copy(bfs);
+        graph::VertexOrdering moved(std::move(bfs));
+        CHECK(bfs.getNumVertices() == 0);
+        CHECK(copy.toOriginal(10) == moved.toOriginal(10));
+        
+        int notPermutation[3] = { 0, 2, 2 };
+        CHECK_THROWS_WITH(graph::VertexOrdering(notPermutation, 3), "Order is not a permutation");
+        CHECK_THROWS_WITH(copy.relabel(graph::Graph(5)), "Graph does not match the ordering");
+        CHECK_THROWS_WITH(graph::VertexOrdering::bfsOrder(csr, 900), "Source vertex out of range");
+        CHECK_THROWS_WITH(copy.toRelabeled(-1), "Vertex index out of range");
+    }
+}
+    
+// Visitor that folds the sequence of DFS events into one number
+class SequenceVisitor : public graph::DfsVisitor {
+public:
+    unsigned long long sequence;
+    int backEdges;
+    
+    SequenceVisitor() : sequence(0), backEdges(0) {}
+    
+    void discoverVertex(int vertex) {
+        sequence = sequence * 31 + vertex;
+    }
+    
+    void treeEdge(int source, int dest, int weight) {
+        sequence = (sequence * 31 + source) * 31 + dest + weight;
+    }
+    
+    void backEdge(int, int, int) {
+        backEdges++;
+    }
+};
+    
+TEST_CASE("Compressed adjacency storage") {
+    graph::Graph g = randomGraph(400, 3000, 200, 21);
+    g.addEdge(7, 7, 5);                 // Self-loop
+    g.addEdge(3, 399, 9);               // Far neighbors on both sides
+    g.addEdge(3, 399, 11);              // Parallel edge
+    g.addEdge(398, 0, 2);
+    graph::CompressedGraph compressed(g);
+    
+    SUBCASE("Lists decode to the original edges") {
+        CHECK(compressed.getNumVertices() == 400);
+        CHECK(compressed.getNumHalfEdges() == graph::CSRGraph(g).getNumHalfEdges());
+        CHECK(compressed.getWeightBytes() == 1);
+        
+        bool same = true;
+        for (int v = 0; v < 400; v++) {
+            // Same degree, same neighbor and weight sums, neighbors in increasing order
+            long long neighborSum = 0;
+            long long weightSum = 0;
+            for (graph::Graph::Edge* edge = g.getAdjList(v); edge; edge = edge->next) {
+                neighborSum += edge->destination;
+                weightSum += edge->weight;
+            }
+            int count = 0;
+            int previous = -1;
+            for (graph::CompressedGraph::NeighborIterator it = compressed.neighbors(v); !it.done(); it.next()) {
+                same = same && it.vertex() >= previous && g.hasEdge(v, it.vertex());
+                previous = it.vertex();
+                neighborSum -= it.vertex();
+                weightSum -= it.weight();
+                count++;
+            }
+            same = same && count == g.getDegree(v) && compressed.getDegree(v) == count &&
+                   neighborSum == 0 && weightSum == 0;
+        }
+        CHECK(same);
+        
+        graph::Graph restored = compressed.toGraph();
+        CHECK(countEdges(restored) == countEdges(g));
+        CHECK(calculateTotalWeight(restored) == calculateTotalWeight(g));
+        CHECK(restored.getDegree(7) == g.getDegree(7));
+        CHECK(compressed.toCSR().getNumHalfEdges() == compressed.getNumHalfEdges());
+        
+        // Smaller than the CSR arrays it was built from
+        long long csrBytes = 4LL * (400 + 1) + 8LL * compressed.getNumHalfEdges();
+        CHECK(compressed.getMemoryBytes() < csrBytes);
+    }
+    
+    SUBCASE("Weight widths") {
+        int widths[4] = { 0, 1, 2, 4 };
+        int ranges[4][2] = { { 7, 7 }, { -100, 155 }, { 1, 65536 }, { INT_MIN, INT_MAX } };
+        for (int k = 0; k < 4; k++) {
+            graph::Graph weighted(5);
+            weighted.addEdge(0, 1, ranges[k][0]);
+            weighted.addEdge(1, 2, ranges[k][1]);
+            weighted.addEdge(4, 0, ranges[k][1]);
+            graph::CompressedGraph narrow(weighted);
+            CHECK(narrow.getWeightBytes() == widths[k]);
+            
+            graph::CompressedGraph::NeighborIterator it = narrow.neighbors(0);
+            CHECK(it.vertex() == 1);
+            CHECK(it.weight() == ranges[k][0]);
+            it.next();
+            CHECK(it.vertex() == 4);
+            CHECK(it.weight() == ranges[k][1]);
+            it.next();
+            CHECK(it.done());
+            CHECK(narrow.neighbors(3).done());
+        }
+    }
+    
+    SUBCASE("BFS and DFS on the compressed lists") {
+        graph::CSRGraph sorted = compressed.toCSR();
+        graph::SearchTree expected = graph::Algorithms::bfsTree(sorted, 5);
+        graph::SearchTree tree = graph::Algorithms::bfsTree(compressed, 5);
+        bool same = true;
+        for (int v = 0; v < 400; v++) {
+            same = same && tree.getDistance(v) == expected.getDistance(v) &&
+                   tree.getParent(v) == expected.getParent(v) &&
+                   tree.getParentWeight(v) == expected.getParentWeight(v);
+        }
+        CHECK(same);
+        
+        SequenceVisitor fromCompressed;
+        SequenceVisitor fromCsr;
+        graph::Algorithms::depthFirstSearchAll(compressed, fromCompressed);
+        graph::Algorithms::depthFirstSearchAll(sorted, fromCsr);
+        CHECK(fromCompressed.sequence == fromCsr.sequence);
+        CHECK(fromCompressed.backEdges == fromCsr.backEdges);
+        
+        SequenceVisitor single;
+        graph::Algorithms::depthFirstSearch(compressed, 3, single);
+        CHECK(single.backEdges > 0);
+    }
+    
+    SUBCASE("Copies and invalid input") {
+        graph::CompressedGraph copy(compressed);
+        graph::CompressedGraph moved(std::move(compressed));
+        CHECK(compressed.getNumVertices() == 0);
+        CHECK(copy.getMemoryBytes() == moved.getMemoryBytes());
+        CHECK(copy.neighbors(3).vertex() == moved.neighbors(3).vertex());
+        copy = graph::CompressedGraph(graph::Graph(2));
+        CHECK(copy.getNumHalfEdges() == 0);
+        CHECK(copy.neighbors(1).done());
+        
+        CHECK_THROWS_WITH(moved.neighbors(400), "Vertex index out of range");
+        CHECK_THROWS_WITH(moved.getDegree(-1), "Vertex index out of range");
+        CHECK_THROWS_WITH(graph::Algorithms::bfsTree(moved, 400), "Source vertex out of range");
+        SequenceVisitor visitor;
+        CHECK_THROWS_WITH(graph::Algorithms::depthFirstSearch(moved, -1, visitor), "Source vertex out of range");
+    }
+    
+    SUBCASE("Views with one-way arcs keep their lists") {
+        // 0 -> 2 and 1 -> 2 with nothing back, then vertex 3 with an unsorted list
+        int offsets[] = { 0, 1, 2, 2, 5 };
+        int destinations[] = { 2, 2, 3, 0, 1 };
+        int weights[] = { 4, 5, 6, 7, 8 };
+        graph::CSRGraph view = graph::CSRGraph::view(4, 5, offsets, destinations, weights);
+        graph::CompressedGraph oneWay(view);
+        CHECK(oneWay.getDegree(2) == 0);
+        CHECK(oneWay.getDegree(3) == 3);
+        
+        graph::CSRGraph restored = oneWay.toCSR();
+        int expected[] = { 2, 2, 0, 1, 3 };
+        int expectedWeights[] = { 4, 5, 7, 8, 6 };
+        bool same = true;
+        for (int i = 0; i < 5; i++) {
+            same = same && restored.getDestinations()[i] == expected[i] &&
+                   restored.getWeights()[i] == expectedWeights[i];
+        }
+        for (int v = 0; v <= 4; v++) {
+            same = same && restored.getOffsets()[v] == offsets[v];
+        }
+        CHECK(same);
+        
+        destinations[1] = 4;
+        CHECK_THROWS_WITH(graph::CompressedGraph(graph::CSRGraph::view(4, 5, offsets, destinations, weights)),
+                          "Vertex index out of range");
+    }
+}
+    
+// Set bits of a word array
+int countBits(const unsigned long long* words, int count) {
+    int bits = 0;
+    for (int i = 0; i < count; i++) {
+        for (unsigned long long word = words[i]; word; word &= word - 1) {
+            bits++;
+        }
+    }
+    return bits;
+}
+    
+TEST_CASE("Dense bit-matrix graphs") {
+    // 300 vertices at roughly 40% density, with parallel edges and a self-loop
+    graph::Graph g = randomGraph(300, 25000, 9, 31);
+    g.addEdge(10, 11, 4);
+    g.addEdge(10, 11, 6);
+    g.addEdge(12, 12, 1);
+    graph::DenseGraph dense(g);
+    
+    SUBCASE("Conversion to and from Graph") {
+        bool same = true;
+        long long pairs = 0;
+        for (int u = 0; u < 300; u++) {
+            int distinct = 0;
+            for (int v = 0; v < 300; v++) {
+                bool edge = g.hasEdge(u, v);
+                same = same && dense.hasEdge(u, v) == edge;
+                distinct += edge ? 1 : 0;
+                pairs += edge && u <= v ? 1 : 0;
+            }
+            same = same && dense.getDegree(u) == distinct;
+        }
+        CHECK(same);
+        CHECK(dense.getNumEdges() == pairs);
+        CHECK(dense.getRowWords() == 8);
+        CHECK(countBits(dense.getRow(299), dense.getRowWords()) == dense.getDegree(299));
+        
+        graph::Graph restored = dense.toGraph();
+        CHECK(countEdges(restored) + 1 == pairs); // countEdges skips the self-loop
+        CHECK(calculateTotalWeight(restored) == countEdges(restored));
+        CHECK(restored.hasEdge(12, 12));
+        CHECK(restored.getWeight(10, 11) == 1);
+        CHECK(graph::DenseGraph(restored).getNumEdges() == pairs);
+        
+        // Adding an existing edge or removing a missing one changes nothing
+        graph::DenseGraph edited(4);
+        edited.addEdge(0, 3);
+        edited.addEdge(3, 0);
+        edited.addEdge(2, 2);
+        CHECK(edited.getNumEdges() == 2);
+        CHECK(edited.getDegree(3) == 1);
+        edited.removeEdge(0, 3);
+        edited.removeEdge(0, 3);
+        CHECK(edited.getNumEdges() == 1);
+        CHECK_FALSE(edited.hasEdge(3, 0));
+        CHECK(edited.getDegree(2) == 1);
+    }
+    
+    SUBCASE("Set operations on both kernel paths") {
+        unsigned long long* common = new unsigned long long[dense.getRowWords()];
+        unsigned long long* both = new unsigned long long[dense.getRowWords()];
+        bool available = graph::DenseGraph::hasAvx2();
+        for (int pass = 0; pass < 2; pass++) {
+            graph::DenseGraph::setAvx2Enabled(pass == 0);
+            CHECK(graph::DenseGraph::isAvx2Enabled() == (pass == 0 && available));
+            
+            bool same = true;
+            for (int u = 0; u < 300; u += 7) {
+                for (int v = 0; v < 300; v += 5) {
+                    int expectedCommon = 0;
+                    int expectedUnion = 0;
+                    for (int w = 0; w < 300; w++) {
+                        expectedCommon += g.hasEdge(u, w) && g.hasEdge(v, w) ? 1 : 0;
+                        expectedUnion += g.hasEdge(u, w) || g.hasEdge(v, w) ? 1 : 0;
+                    }
+                    dense.commonNeighbors(u, v, common);
+                    dense.unionNeighbors(u, v, both);
+                    same = same && dense.countCommonNeighbors(u, v) == expectedCommon &&
+                           dense.countUnionNeighbors(u, v) == expectedUnion &&
+                           countBits(common, dense.getRowWords()) == expectedCommon &&
+                           countBits(both, dense.getRowWords()) == expectedUnion;
+                }
+            }
+            CHECK(same);
+            
+            // Word counts that are not a multiple of four go through the scalar tail
+            unsigned long long a[7];
+            unsigned long long b[7];
+            unsigned long long out[7];
+            unsigned int seed = 5;
+            for (int i = 0; i < 7; i++) {
+                a[i] = (unsigned long long)nextRandom(seed) << 41 ^ (unsigned long long)nextRandom(seed) << 20 ^
+                       nextRandom(seed);
+                b[i] = ~a[i] ^ (unsigned long long)nextRandom(seed);
+            }
+            graph::DenseGraph::andNotWords(a, b, out, 7);
+            int andNot = countBits(out, 7);
+            graph::DenseGraph::andWords(a, b, out, 7);
+            CHECK(graph::DenseGraph::popcountAndWords(a, b, 7) == countBits(out, 7));
+            CHECK(graph::DenseGraph::popcountWords(a, 7) == countBits(out, 7) + andNot);
+            graph::DenseGraph::orWords(a, b, out, 7);
+            CHECK(graph::DenseGraph::popcountWords(out, 7) ==
+                  graph::DenseGraph::popcountWords(a, 7) + graph::DenseGraph::popcountWords(b, 7) -
+                  graph::DenseGraph::popcountAndWords(a, b, 7));
+        }
+        graph::DenseGraph::setAvx2Enabled(true);
+        delete[] common;
+        delete[] both;
+    }
+    
+    SUBCASE("Bitwise BFS") {
+        // The dense graph, a long path (top-down levels only), a hub whose first level
+        // outnumbers the rest (a bottom-up level) and a graph with unreachable vertices
+        graph::Graph path(130);
+        for (int i = 0; i + 1 < 130; i++) {
+            path.addEdge(i, i + 1, 3);
+        }
+        graph::Graph hub(220);
+        for (int i = 1; i < 200; i++) {
+            hub.addEdge(0, i);
+        }
+        for (int i = 200; i < 220; i++) {
+            hub.addEdge(i, i < 210 ? 3 * i - 590 : i - 10);
+        }
+        graph::Graph split = randomGraph(200, 150, 5, 8);
+        graph::Graph* graphs[4] = { &g, &path, &hub, &split };
+        int sources[4] = { 42, 64, 0, 0 };
+        
+        for (int k = 0; k < 4; k++) {
+            graph::DenseGraph matrix(*graphs[k]);
+            graph::SearchTree expected = graph::Algorithms::bfsTree(*graphs[k], sources[k]);
+            graph::SearchTree tree = graph::Algorithms::bfsTree(matrix, sources[k]);
+            bool same = tree.getParent(sources[k]) == -1;
+            for (int v = 0; v < matrix.getNumVertices(); v++) {
+                same = same && tree.getDistance(v) == expected.getDistance(v);
+                if (tree.isReached(v) && v != sources[k]) {
+                    int p = tree.getParent(v);
+                    same = same && matrix.hasEdge(p, v) && tree.getDistance(p) + 1 == tree.getDistance(v) &&
+                           tree.getParentWeight(v) == 1;
+                }
+            }
+            CHECK(same);
+        }
+        CHECK(graph::Algorithms::bfsTree(graph::DenseGraph(path), 0).getDistance(129) == 129);
+        CHECK(graph::Algorithms::bfsTree(graph::DenseGraph(hub), 0).getDistance(219) == 3);
+        
+        graph::SearchTree partial = graph::Algorithms::bfsTree(graph::DenseGraph(split), 0);
+        int unreached = 0;
+        for (int v = 0; v < 200; v++) {
+            unreached += partial.isReached(v) ? 0 : 1;
+        }
+        CHECK(unreached > 0);
+    }
+    
+    SUBCASE("Copies and invalid input") {
+        graph::DenseGraph copy(dense);
+        graph::DenseGraph moved(std::move(dense));
+        CHECK(dense.getNumVertices() == 0);
+        CHECK(copy.getNumEdges() == moved.getNumEdges());
+        copy = graph::DenseGraph(3);
+        CHECK(copy.getNumEdges() == 0);
+        
+        CHECK_THROWS_WITH(graph::DenseGraph(0), "Number of vertices must be positive");
+        CHECK_THROWS_WITH(moved.addEdge(0, 300), "Vertex index out of range");
+        CHECK_THROWS_WITH(moved.countCommonNeighbors(-1, 0), "Vertex index out of range");
+        CHECK_THROWS_WITH(graph::Algorithms::bfsTree(moved, 300), "Source vertex out of range");
+    }
+}